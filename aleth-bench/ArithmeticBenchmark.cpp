@@ -0,0 +1,166 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "ArithmeticBenchmark.h"
+#include "BenchmarkUtils.h"
+
+#include <libethashseal/GenesisInfo.h>
+#include <libethcore/SealEngine.h>
+#include <libethereum/ChainParams.h>
+#include <libethereum/Executive.h>
+#include <libethereum/State.h>
+#include <libevm/Instruction.h>
+
+#include <cassert>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+/// Blocks of sixteen operations, and operations run in each loop iteration.
+unsigned const c_blocks = 8;
+unsigned const c_operationsPerBlock = 16;
+
+Address const c_sender{"0x1000000000000000000000000000000000000001"};
+Address const c_program{"0x1000000000000000000000000000000000000002"};
+u256 const c_gas = 1000000000;
+
+struct Program
+{
+    char const* name;
+    Instruction op;
+    u256 a;
+    u256 b;
+    u256 expected;
+    unsigned iterations;
+};
+
+/// The constants and results of the .asm programs of the same names in test/unittests/performance,
+/// with fewer iterations so that a run takes milliseconds.
+vector<Program> const c_programs{
+    {"add256", Instruction::ADD,
+        u256{"0x802431afcbce1fc194c9eaa417b2fb67dc75a95db0bc7ec6b1c8af11df6a1da9"},
+        u256{"0xa1f5aac137876480252e5dcac62c354ec0d42b76b0642b6181ed099849ea1d57"},
+        u256{"0x9f7eddc3444467c3e7afc7507a765053e9b860c8b6ff34ded09948967e0bf319"}, 4096},
+    {"mul256", Instruction::MUL,
+        u256{"0x802431afcbce1fc194c9eaa417b2fb67dc75a95db0bc7ec6b1c8af11df6a1da9"},
+        u256{"0xa1f5aac137876480252e5dcac62c354ec0d42b76b0642b6181ed099849ea1d57"},
+        u256{"0xf68cec53bdbebd0d8a2587f4716010120f43bc8873f6d3b26c697204beaf2a29"}, 4096},
+    {"div256", Instruction::DIV, u256{"0xff3f9014f20db29ae04af2c2d265de17"},
+        u256{"0xfe7fb0d1f59dfe9492ffbf73683fd1e870eec79504c60144cc7f5fc2bad1e611"},
+        u256{"0xff3f9014f20db29ae04af2c2d265de17"}, 4096},
+    {"exp", Instruction::EXP,
+        u256{"0xc27b83c7d9d312389735f7b3b3b85eb630608f906992f889b6c8814e31b8eb3b"},
+        u256{"0xdd1620ca66b8877ff381a3475f3892560337791da698c011eaa92fb9626161c3"},
+        u256{"0x3b46f4bb35c94a2cb5f8c1e1e1f918b76a3fe3da9874d2c8abf29a85f90aa37b"}, 64},
+};
+
+void append(bytes& io_code, Instruction _op)
+{
+    io_code.push_back(static_cast<byte>(_op));
+}
+
+void appendPush32(bytes& io_code, u256 const& _value)
+{
+    append(io_code, Instruction::PUSH32);
+    io_code += h256{_value}.asBytes();
+}
+
+/// The loop of the .asm programs: x = a, then x = op(b, x) sixteen times, in eight blocks. The x
+/// of the last block of the last iteration is compared with the expected result, and the program
+/// reverts if it differs.
+bytes code(Program const& _program)
+{
+    bytes ret{static_cast<byte>(Instruction::PUSH1), 0, static_cast<byte>(Instruction::PUSH3),
+        static_cast<byte>(_program.iterations >> 16), static_cast<byte>(_program.iterations >> 8),
+        static_cast<byte>(_program.iterations)};
+    auto const loop = static_cast<byte>(ret.size());
+    append(ret, Instruction::JUMPDEST);
+    appendPush32(ret, _program.a);
+    appendPush32(ret, _program.b);
+    appendPush32(ret, _program.a);
+    for (unsigned block = 0; block < c_blocks; ++block)
+    {
+        if (block)
+        {
+            append(ret, Instruction::POP);
+            append(ret, Instruction::DUP2);
+        }
+        for (unsigned i = 0; i < c_operationsPerBlock; ++i)
+        {
+            append(ret, Instruction::DUP2);
+            append(ret, _program.op);
+        }
+    }
+
+    // Keep x in place of the previous one and count the iteration down: r i a b x -> x i-1
+    for (auto op : {Instruction::SWAP4, Instruction::POP, Instruction::POP, Instruction::POP,
+             Instruction::PUSH1})
+        append(ret, op);
+    ret.push_back(1);
+    for (auto op : {Instruction::SWAP1, Instruction::SUB, Instruction::DUP1, Instruction::PUSH1})
+        append(ret, op);
+    ret.push_back(loop);
+    append(ret, Instruction::JUMPI);
+
+    append(ret, Instruction::POP);
+    appendPush32(ret, _program.expected);
+    append(ret, Instruction::EQ);
+    append(ret, Instruction::PUSH2);
+    size_t const success = ret.size() + 2 + 5;
+    ret.push_back(static_cast<byte>(success >> 8));
+    ret.push_back(static_cast<byte>(success));
+    for (auto op : {Instruction::JUMPI, Instruction::PUSH1})
+        append(ret, op);
+    ret.push_back(0);
+    for (auto op : {Instruction::DUP1, Instruction::REVERT, Instruction::JUMPDEST, Instruction::STOP})
+        append(ret, op);
+    assert(ret[success] == static_cast<byte>(Instruction::JUMPDEST));
+    return ret;
+}
+}  // namespace
+
+vector<ArithmeticResult> dev::eth::benchmarkArithmeticPrograms(double _minSeconds)
+{
+    unique_ptr<SealEngineFace> const se{
+        ChainParams(genesisInfo(Network::MainNetwork)).createSealEngine()};
+    BlockHeader header;
+    header.setNumber(static_cast<int64_t>(se->chainParams().muirGlacierForkBlock));
+    header.setGasLimit(c_gas);
+    ZeroLastBlockHashes const lastBlockHashes;
+    EnvInfo const envInfo{header, lastBlockHashes, 0, se->chainParams().chainID};
+    u256 const version = se->evmSchedule(envInfo.number()).accountVersion;
+
+    vector<ArithmeticResult> ret;
+    for (auto const& program : c_programs)
+    {
+        State state{0};
+        AccountMap accounts;
+        accounts[c_sender] = Account{0, 0};
+        Account account{0, 0};
+        account.setCode(code(program), version);
+        accounts[c_program] = account;
+        state.populateFrom(accounts);
+
+        ArithmeticResult result;
+        result.program = program.name;
+        result.operations = uint64_t{program.iterations} * c_blocks * c_operationsPerBlock;
+        auto const run = [&]() {
+            size_t const savepoint = state.savepoint();
+            Executive e{state, envInfo, *se};
+            if (!e.call(c_program, c_sender, 0, 0, {}, c_gas))
+                e.go();
+            result.gasUsed = c_gas - e.gas();
+            result.success = e.getException() == TransactionException::None;
+            state.rollback(savepoint);
+        };
+        result.nsPerRun = nsPerCall(run, _minSeconds);
+        result.nsPerOperation = result.nsPerRun / result.operations;
+        result.gasPerSecond = result.gasUsed.convert_to<double>() * 1e9 / result.nsPerRun;
+        ret.push_back(result);
+    }
+    return ret;
+}
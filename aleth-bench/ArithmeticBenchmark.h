@@ -0,0 +1,33 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Time taken by the 256-bit arithmetic programs of test/unittests/performance on the chosen VM.
+#pragma once
+
+#include <libdevcore/Common.h>
+
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+struct ArithmeticResult
+{
+    std::string program;
+    uint64_t operations = 0;     ///< Arithmetic instructions run by one transaction
+    u256 gasUsed;
+    bool success = false;        ///< Whether the program computed the result it checks for
+    double nsPerRun = 0;
+    double nsPerOperation = 0;   ///< Time per transaction spread over its arithmetic instructions
+    double gasPerSecond = 0;
+};
+
+/// Run the add256, mul256, div256 and exp programs, each for at least @a _minSeconds, on the VM
+/// selected with --vm.
+std::vector<ArithmeticResult> benchmarkArithmeticPrograms(double _minSeconds);
+}  // namespace eth
+}  // namespace dev
@@ -0,0 +1,27 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "BenchmarkUtils.h"
+
+#include <chrono>
+
+using namespace std;
+
+double dev::eth::nsPerCall(function<void()> const& _run, double _minSeconds, uint64_t* o_calls)
+{
+    // Double the batch until it takes long enough, so that reading the clock doesn't count.
+    chrono::duration<double> elapsed{0};
+    uint64_t calls = 0;
+    for (uint64_t batch = 1; elapsed.count() < _minSeconds; batch *= 2)
+    {
+        auto const start = chrono::steady_clock::now();
+        for (uint64_t i = 0; i < batch; ++i)
+            _run();
+        elapsed += chrono::steady_clock::now() - start;
+        calls += batch;
+    }
+    if (o_calls)
+        *o_calls = calls;
+    return elapsed.count() * 1e9 / calls;
+}
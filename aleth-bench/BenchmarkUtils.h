@@ -0,0 +1,31 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Timing loop and environment shared by the benchmarks.
+#pragma once
+
+#include <libethereum/LastBlockHashesFace.h>
+
+#include <cstdint>
+#include <functional>
+
+namespace dev
+{
+namespace eth
+{
+/// Hashes of the 256 preceding blocks, all zero, for running transactions outside a chain.
+class ZeroLastBlockHashes: public LastBlockHashesFace
+{
+public:
+    h256s precedingHashes(h256 const&) const override { return h256s(256, h256()); }
+    void clear() override {}
+};
+
+/// @returns the nanoseconds per call of @a _run, run for at least @a _minSeconds.
+/// @param o_calls if not null, set to the number of calls made.
+double nsPerCall(
+    std::function<void()> const& _run, double _minSeconds, uint64_t* o_calls = nullptr);
+}  // namespace eth
+}  // namespace dev
@@ -0,0 +1,104 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "CallBenchmark.h"
+#include "BenchmarkUtils.h"
+
+#include <libethashseal/GenesisInfo.h>
+#include <libethcore/SealEngine.h>
+#include <libethereum/ChainParams.h>
+#include <libethereum/Executive.h>
+#include <libethereum/State.h>
+#include <libevm/VMFactory.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+/// Calls itself with the first word of its input decremented until it is zero, touching 1 KB of
+/// memory and returning a word in every frame.
+///
+///     if (n != 0) { mstore(0, n - 1); mstore(0x3e0, 1); call(gas, address, 0, 0, 32, 0, 32) }
+///     return(0, 32)
+char const* const c_recursion =
+    "60003580156023576001900360005260016103e05260206000602060006000305af1505b60206000f3";
+
+/// Calls the address in the second word of its input as many times as the first word says.
+///
+///     for (i = n; i != 0; --i) call(gas, calldataload(32), 0, 0, 0, 0, 32)
+char const* const c_fanOut = "6000355b8015602057602060006000600060006020355af150600190036003565b00";
+
+/// Touches 1 KB of memory and returns a word of it.
+char const* const c_callee = "60016103e05260206103e0f3";
+
+Address const c_sender{"0x1000000000000000000000000000000000000001"};
+Address const c_recursionAddress{"0x1000000000000000000000000000000000000002"};
+Address const c_fanOutAddress{"0x1000000000000000000000000000000000000003"};
+Address const c_calleeAddress{"0x1000000000000000000000000000000000000004"};
+u256 const c_gas = 1000000000;
+}  // namespace
+
+vector<CallFramesResult> dev::eth::benchmarkCallFrames(double _minSeconds)
+{
+    unique_ptr<SealEngineFace> const se{
+        ChainParams(genesisInfo(Network::MainNetwork)).createSealEngine()};
+    BlockHeader header;
+    header.setNumber(static_cast<int64_t>(se->chainParams().muirGlacierForkBlock));
+    header.setGasLimit(c_gas);
+    ZeroLastBlockHashes const lastBlockHashes;
+    EnvInfo const envInfo{header, lastBlockHashes, 0, se->chainParams().chainID};
+    u256 const version = se->evmSchedule(envInfo.number()).accountVersion;
+
+    State state{0};
+    AccountMap accounts;
+    accounts[c_sender] = Account{0, 0};
+    for (auto const& contract : {make_pair(c_recursionAddress, c_recursion),
+             make_pair(c_fanOutAddress, c_fanOut), make_pair(c_calleeAddress, c_callee)})
+    {
+        Account account{0, 0};
+        account.setCode(fromHex(contract.second), version);
+        accounts[contract.first] = account;
+    }
+    state.populateFrom(accounts);
+
+    struct Case
+    {
+        string name;
+        Address address;
+        bytes input;
+        unsigned frames;
+    };
+    vector<Case> cases;
+    for (unsigned depth : {8, 64, 256})
+        cases.push_back({"recursion depth " + to_string(depth), c_recursionAddress,
+            h256(depth).asBytes(), depth + 1});
+    for (unsigned calls : {16, 256})
+        cases.push_back({to_string(calls) + " calls in a loop", c_fanOutAddress,
+            h256(calls).asBytes() + h256(c_calleeAddress, h256::AlignRight).asBytes(), calls + 1});
+
+    vector<CallFramesResult> ret;
+    for (auto const& c : cases)
+    {
+        CallFramesResult result;
+        result.contract = c.name;
+        result.frames = c.frames;
+        auto const run = [&]() {
+            size_t const savepoint = state.savepoint();
+            Executive e{state, envInfo, *se};
+            if (!e.call(c.address, c_sender, 0, 0, &c.input, c_gas))
+                e.go();
+            result.gasUsed = c_gas - e.gas();
+            result.success = e.getException() == TransactionException::None;
+            state.rollback(savepoint);
+        };
+        VMFactory::setPooling(false);
+        result.unpooledNs = nsPerCall(run, _minSeconds);
+        VMFactory::setPooling(true);
+        result.pooledNs = nsPerCall(run, _minSeconds);
+        ret.push_back(result);
+    }
+    return ret;
+}
@@ -0,0 +1,32 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Time taken by call-heavy contracts with and without pooled VM instances.
+#pragma once
+
+#include <libdevcore/Common.h>
+
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+struct CallFramesResult
+{
+    std::string contract;
+    unsigned frames = 0;         ///< Call frames run by one transaction
+    u256 gasUsed;
+    bool success = false;        ///< Whether the transaction ran out of gas or failed otherwise
+    double unpooledNs = 0;       ///< Time per transaction with a new VM for every frame
+    double pooledNs = 0;         ///< Time per transaction with VMs reused from the pool
+};
+
+/// Run contracts that call themselves recursively or call another contract in a loop, with VM
+/// pooling off and on, each for at least @a _minSeconds.
+std::vector<CallFramesResult> benchmarkCallFrames(double _minSeconds);
+}  // namespace eth
+}  // namespace dev
@@ -0,0 +1,112 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "FilterBenchmark.h"
+#include "BenchmarkUtils.h"
+
+#include <libdevcore/SHA3.h>
+#include <libethereum/LogFilterIndex.h>
+#include <libethereum/TransactionReceipt.h>
+
+#include <map>
+#include <random>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+unsigned const c_blockTransactions = 200;
+unsigned const c_logsPerTransaction = 2;
+unsigned const c_contracts = 2000;
+unsigned const c_events = 50;
+
+Address contract(unsigned _i)
+{
+    return Address{sha3(string("contract") + to_string(_i))};
+}
+
+h256 event(unsigned _i)
+{
+    return sha3(string("Event") + to_string(_i) + "(address,address,uint256)");
+}
+
+/// Half of the contracts emit logs, so that half of the filters on addresses never match.
+TransactionReceipts block(mt19937& _gen)
+{
+    TransactionReceipts ret;
+    for (unsigned i = 0; i < c_blockTransactions; ++i)
+    {
+        LogEntries logs;
+        for (unsigned j = 0; j < c_logsPerTransaction; ++j)
+            logs.emplace_back(contract(_gen() % (c_contracts / 2)),
+                h256s{event(_gen() % c_events), h256(_gen()), h256(_gen())}, bytes(32, 1));
+        ret.emplace_back(1, 21000 * (i + 1), logs);
+    }
+    return ret;
+}
+
+map<h256, LogFilter> filters(mt19937& _gen, size_t _count)
+{
+    map<h256, LogFilter> ret;
+    while (ret.size() < _count)
+    {
+        // Mostly contracts watched by dapps, some for one event, and a few events watched anywhere.
+        LogFilter filter;
+        unsigned const kind = _gen() % 10;
+        if (kind < 9)
+            filter = filter.address(contract(_gen() % c_contracts));
+        if (kind >= 6)
+            filter = filter.topic(0, event(_gen() % c_events));
+        ret.emplace(filter.sha3(), filter);
+    }
+    return ret;
+}
+}  // namespace
+
+FilterMatchingResult dev::eth::benchmarkFilterMatching(size_t _filters, double _minSeconds)
+{
+    mt19937 gen(3);
+    TransactionReceipts const receipts = block(gen);
+    map<h256, LogFilter> const installed = filters(gen, _filters);
+    LogFilterIndex index;
+    for (auto const& filter : installed)
+        index.insert(filter.first, filter.second);
+    LogBloom bloom;
+    for (auto const& receipt : receipts)
+        bloom |= receipt.bloom();
+
+    // Same loops as the client before and after filters were indexed.
+    map<h256, size_t> linearMatches;
+    auto const linear = [&]() {
+        for (auto const& filter : installed)
+            for (auto const& receipt : receipts)
+                if (size_t const matches = filter.second.matches(receipt).size())
+                    linearMatches[filter.first] += matches;
+    };
+    map<h256, size_t> indexedMatches;
+    auto const indexed = [&]() {
+        if (!index.mayMatch(bloom))
+            return;
+        for (auto const& receipt : receipts)
+            for (LogEntry const& log : receipt.log())
+                index.forEachCandidate(log, [&](h256 const& _id) {
+                    if (installed.at(_id).matches(log))
+                        ++indexedMatches[_id];
+                });
+    };
+
+    FilterMatchingResult ret;
+    ret.filters = installed.size();
+    ret.logs = receipts.size() * c_logsPerTransaction;
+    linear();
+    indexed();
+    ret.identical = linearMatches == indexedMatches;
+    for (auto const& matches : indexedMatches)
+        ret.matches += matches.second;
+    ret.linearNs = nsPerCall(linear, _minSeconds);
+    ret.indexedNs = nsPerCall(indexed, _minSeconds);
+    return ret;
+}
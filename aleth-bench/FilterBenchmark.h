@@ -0,0 +1,29 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Matching of the logs of a block against many installed filters.
+#pragma once
+
+#include <cstddef>
+
+namespace dev
+{
+namespace eth
+{
+struct FilterMatchingResult
+{
+    size_t filters = 0;
+    size_t logs = 0;         ///< Log entries in the block
+    size_t matches = 0;      ///< Log entries caught, counted once per filter that catches them
+    double linearNs = 0;     ///< Time to match the block against each filter in turn
+    double indexedNs = 0;    ///< Time to match the block through LogFilterIndex
+    bool identical = false;  ///< Whether both catch the same entries for each filter
+};
+
+/// Match a block of ERC-20-like logs against @a _filters filters on addresses and topics, both
+/// ways, each for at least @a _minSeconds.
+FilterMatchingResult benchmarkFilterMatching(size_t _filters, double _minSeconds);
+}  // namespace eth
+}  // namespace dev
@@ -0,0 +1,106 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "ImportBenchmark.h"
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/RLP.h>
+#include <libdevcore/TransientDirectory.h>
+#include <libethereum/BlockChain.h>
+#include <libethereum/ChainParams.h>
+#include <libethereum/State.h>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <numeric>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+namespace fs = boost::filesystem;
+
+namespace
+{
+void copyTree(fs::path const& _from, fs::path const& _to)
+{
+    for (fs::recursive_directory_iterator it{_from}, end; it != end; ++it)
+    {
+        fs::path const target = _to / fs::relative(it->path(), _from);
+        if (fs::is_directory(it->status()))
+            fs::create_directories(target);
+        else
+            fs::copy_file(it->path(), target);
+    }
+}
+
+double percentile(vector<double> const& _sorted, double _fraction)
+{
+    size_t const rank = static_cast<size_t>(ceil(_fraction * _sorted.size()));
+    return _sorted[max<size_t>(rank, 1) - 1];
+}
+}  // namespace
+
+vector<bytes> dev::eth::readBlocks(fs::path const& _file)
+{
+    bytes const data = contents(_file);
+    vector<bytes> ret;
+    for (bytesConstRef in{&data}; !in.empty();)
+    {
+        size_t const size = RLP(in, RLP::LaissezFaire).actualSize();
+        if (size == 0 || size > in.size())
+            BOOST_THROW_EXCEPTION(BadRLP() << errinfo_comment(
+                                      "Truncated block " + to_string(ret.size()) + " in " + _file.string()));
+        ret.push_back(in.cropped(0, size).toBytes());
+        in = in.cropped(size);
+    }
+    return ret;
+}
+
+ImportRun dev::eth::replayImport(ChainParams const& _params, fs::path const& _preState,
+    fs::path const& _workDir, vector<bytes> const& _blocks)
+{
+    // The copy must outlive the databases opened in it.
+    unique_ptr<TransientDirectory> const copy =
+        _workDir.empty() ? make_unique<TransientDirectory>() :
+                           make_unique<TransientDirectory>(
+                               (_workDir / ("aleth-bench-" + toString(FixedHash<4>::random()))).string());
+    copyTree(_preState, copy->path());
+
+    BlockChain bc{_params, copy->path(), WithExisting::Trust};
+    OverlayDB const stateDB = State::openDB(copy->path(), bc.genesisHash(), WithExisting::Trust);
+
+    ImportRun ret;
+    bc.setOnImportStages([&](VerifiedBlockRef const& _block, ImportStageDurations const& _stages) {
+        ret.gasUsed += _block.info.gasUsed();
+        for (auto const& stage : _stages)
+            ret.stages[stage.first].push_back(stage.second);
+    });
+
+    auto const start = chrono::steady_clock::now();
+    for (auto const& block : _blocks)
+        bc.import(block, stateDB);
+    ret.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return ret;
+}
+
+Distribution dev::eth::distribution(vector<double> _samples)
+{
+    Distribution ret;
+    if (_samples.empty())
+        return ret;
+
+    sort(_samples.begin(), _samples.end());
+    ret.count = _samples.size();
+    ret.mean = accumulate(_samples.begin(), _samples.end(), 0.0) / ret.count;
+    ret.p50 = percentile(_samples, 0.5);
+    ret.p90 = percentile(_samples, 0.9);
+    ret.p99 = percentile(_samples, 0.99);
+    ret.max = _samples.back();
+    return ret;
+}
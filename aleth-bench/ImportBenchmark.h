@@ -0,0 +1,54 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Replay of a recorded chain segment through BlockChain::import, timing every import stage.
+#pragma once
+
+#include <libdevcore/Common.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+struct ChainParams;
+
+struct ImportRun
+{
+    double seconds = 0;  ///< Time spent importing, without copying and opening the databases
+    u256 gasUsed;
+    /// Duration in seconds of each stage for every imported block, keyed by stage name.
+    std::map<std::string, std::vector<double>> stages;
+};
+
+struct Distribution
+{
+    size_t count = 0;
+    double mean = 0;
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double max = 0;
+};
+
+/// @returns the blocks of a file written by `aleth export`, that is concatenated block RLPs.
+std::vector<bytes> readBlocks(boost::filesystem::path const& _file);
+
+/// Import @a _blocks into a fresh copy of the database directory @a _preState, which must hold
+/// the chain up to the parent of the first block. The copy is made in a new directory under
+/// @a _workDir, or in the system temporary directory if it is empty, and removed afterwards.
+/// @throws whatever BlockChain::import throws for the first block that fails to import.
+ImportRun replayImport(ChainParams const& _params, boost::filesystem::path const& _preState,
+    boost::filesystem::path const& _workDir, std::vector<bytes> const& _blocks);
+
+/// @returns the summary of @a _samples, with nearest-rank percentiles.
+Distribution distribution(std::vector<double> _samples);
+}  // namespace eth
+}  // namespace dev
@@ -0,0 +1,147 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "PrecompileBenchmark.h"
+#include "BenchmarkUtils.h"
+
+#include <libdevcore/SHA3.h>
+#include <libdevcrypto/Common.h>
+#include <libethcore/ChainOperationParams.h>
+#include <libethcore/Precompiled.h>
+
+#include <map>
+#include <random>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+/// Generator of the alt_bn128 G2 group as encoded by the pairing precompile (EIP-197).
+char const c_g2Generator[] =
+    "198e9393920d483a7260bfb731fb5d25f1aa493335a9e71297e485b7aef312c2"
+    "1800deef121f1e76426a00665e5c4479674322d4f75edadd46debd5cd992f6ed"
+    "090689d0585ff075ec9e99ad690c3395bc4b313370b38ef355acdadcd122975b"
+    "12c85ea5db8c6deb4aab71808dcb408fe3d1e7690c43d37b4ce6cc0166fa7daa";
+
+bytes randomBytes(mt19937& _gen, size_t _size)
+{
+    bytes ret(_size);
+    for (auto& b : ret)
+        b = static_cast<byte>(_gen());
+    return ret;
+}
+
+bytes word(u256 const& _value)
+{
+    return toBigEndian(_value);
+}
+
+bytes modexpInput(bytes const& _base, bytes const& _exp, bytes const& _mod)
+{
+    return word(_base.size()) + word(_exp.size()) + word(_mod.size()) + _base + _exp + _mod;
+}
+
+/// @returns the G1 generator multiplied by @a _scalar, a valid point to add and pair.
+bytes g1Point(u256 const& _scalar)
+{
+    bytes const in = word(1) + word(2) + word(_scalar);
+    return PrecompiledRegistrar::executor("alt_bn128_G1_mul")(&in).second;
+}
+
+bytes blake2Input(mt19937& _gen, uint32_t _rounds)
+{
+    bytes ret(4);
+    toBigEndian(_rounds, ret);
+    ret += randomBytes(_gen, 64 + 128);  // state vector and message block
+    ret += bytes(16, 0);                 // offset counters
+    ret.push_back(1);                    // final block
+    return ret;
+}
+
+using Inputs = vector<pair<string, bytes>>;
+
+map<string, Inputs> specificInputs()
+{
+    mt19937 gen(1);
+    map<string, Inputs> ret;
+
+    h256 const hash = sha3(string("aleth-bench"));
+    SignatureStruct const signature{sign(Secret(sha3(hash)), hash)};
+    ret["ecrecover"] = {{"valid signature", hash.asBytes() + word(signature.v + 27) +
+                                                signature.r.asBytes() + signature.s.asBytes()}};
+
+    for (char const* name : {"sha256", "ripemd160", "identity"})
+        for (size_t size : {32, 256, 4096})
+            ret[name].emplace_back(to_string(size) + " bytes", randomBytes(gen, size));
+
+    Inputs& modexp = ret["modexp"];
+    for (size_t size : {32, 128, 256, 512})
+    {
+        bytes mod = randomBytes(gen, size);
+        mod.back() |= 1;
+        bytes const base = randomBytes(gen, size);
+        string const bits = to_string(size * 8) + " bit";
+        modexp.emplace_back(bits + " e=65537", modexpInput(base, fromHex("010001"), mod));
+        modexp.emplace_back(bits + " full exponent", modexpInput(base, randomBytes(gen, size), mod));
+    }
+    bytes evenMod = randomBytes(gen, 256);
+    evenMod.back() &= 0xfe;
+    modexp.emplace_back("2048 bit even modulus",
+        modexpInput(randomBytes(gen, 256), randomBytes(gen, 256), evenMod));
+
+    bytes const p = g1Point(u256(sha3(string("p"))));
+    bytes const q = g1Point(u256(sha3(string("q"))));
+    ret["alt_bn128_G1_add"] = {{"two points", p + q}};
+    ret["alt_bn128_G1_mul"] = {{"256 bit scalar", p + sha3(string("scalar")).asBytes()}};
+    Inputs& pairing = ret["alt_bn128_pairing_product"];
+    for (unsigned pairs : {1, 2, 4})
+    {
+        bytes in;
+        for (unsigned i = 0; i < pairs; ++i)
+            in += g1Point(i + 1) + fromHex(c_g2Generator);
+        pairing.emplace_back(to_string(pairs) + " pairs", in);
+    }
+
+    ret["blake2_compression"] = {
+        {"12 rounds", blake2Input(gen, 12)}, {"1024 rounds", blake2Input(gen, 1024)}};
+    return ret;
+}
+}  // namespace
+
+vector<PrecompileInput> dev::eth::precompileCorpus()
+{
+    map<string, Inputs> specific = specificInputs();
+    mt19937 gen(2);
+    vector<PrecompileInput> ret;
+    for (auto const& name : PrecompiledRegistrar::executorNames())
+    {
+        auto const inputs = specific.find(name);
+        if (inputs != specific.end())
+            for (auto& input : inputs->second)
+                ret.push_back({name, input.first, move(input.second)});
+        else
+            for (size_t size : {0, 32, 256})
+                ret.push_back({name, to_string(size) + " arbitrary bytes", randomBytes(gen, size)});
+    }
+    return ret;
+}
+
+PrecompileResult dev::eth::benchmarkPrecompile(PrecompileInput const& _input,
+    ChainOperationParams const& _params, u256 const& _blockNumber, double _minSeconds)
+{
+    PrecompiledExecutor const& exec = PrecompiledRegistrar::executor(_input.precompile);
+    bytesConstRef const data{&_input.data};
+
+    PrecompileResult ret;
+    ret.precompile = _input.precompile;
+    ret.input = _input.name;
+    ret.gas = PrecompiledRegistrar::pricer(_input.precompile)(data, _params, _blockNumber);
+    ret.success = exec(data).first;
+
+    ret.nsPerCall = nsPerCall([&]() { exec(data); }, _minSeconds, &ret.calls);
+    ret.gasPerSecond = ret.gas.convert_to<double>() * 1e9 / ret.nsPerCall;
+    return ret;
+}
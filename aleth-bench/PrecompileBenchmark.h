@@ -0,0 +1,48 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Speed of the precompiled contracts measured against the gas they are priced at.
+#pragma once
+
+#include <libdevcore/Common.h>
+
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+struct ChainOperationParams;
+
+struct PrecompileInput
+{
+    std::string precompile;  ///< Name in PrecompiledRegistrar
+    std::string name;        ///< Short description of the input
+    bytes data;
+};
+
+struct PrecompileResult
+{
+    std::string precompile;
+    std::string input;
+    bool success = false;  ///< What the executor returned for the input
+    bigint gas;
+    uint64_t calls = 0;
+    double nsPerCall = 0;
+    double gasPerSecond = 0;
+};
+
+/// @returns realistic inputs for every precompile in PrecompiledRegistrar: signatures, RSA-sized
+/// modexp operands, points on alt_bn128 and so on. Precompiles without specific inputs get
+/// arbitrary data of a few sizes.
+std::vector<PrecompileInput> precompileCorpus();
+
+/// Call the precompile with the input repeatedly for at least @a _minSeconds and compare the
+/// time taken to the gas it costs at @a _blockNumber.
+PrecompileResult benchmarkPrecompile(PrecompileInput const& _input,
+    ChainOperationParams const& _params, u256 const& _blockNumber, double _minSeconds);
+}  // namespace eth
+}  // namespace dev
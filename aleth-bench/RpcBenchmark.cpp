@@ -0,0 +1,114 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "RpcBenchmark.h"
+#include "BenchmarkUtils.h"
+
+#include <libethereum/BlockDetails.h>
+#include <libethereum/Transaction.h>
+#include <libethereum/TransactionReceipt.h>
+#include <libweb3jsonrpc/JsonHelper.h>
+#include <libweb3jsonrpc/JsonWriter.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::rpc;
+
+namespace
+{
+unsigned const c_blockTransactions = 200;
+unsigned const c_receiptLogs = 10;
+unsigned const c_filterLogs = 1000;
+
+/// Both ways of serialising a response, with the id and version members libjson-rpc-cpp adds.
+template <class... Args>
+SerialisationResult compare(string const& _name, double _minSeconds, Args const&... _args)
+{
+    auto const jsonValue = [&]() {
+        Json::Value response;
+        response["id"] = 1;
+        response["jsonrpc"] = "2.0";
+        response["result"] = toJson(_args...);
+        return Json::FastWriter().write(response);
+    };
+    string buffer;
+    auto const jsonWriter = [&]() {
+        buffer.clear();
+        JsonWriter writer{buffer};
+        writer.beginObject().key("id").value(1u).key("jsonrpc").value("2.0").key("result");
+        writeJson(writer, _args...);
+        writer.endObject();
+        buffer += '\n';
+    };
+
+    SerialisationResult ret;
+    ret.response = _name;
+    string const expected = jsonValue();
+    jsonWriter();
+    Json::Value parsed;
+    ret.identical = Json::Reader().parse(buffer, parsed, false) && Json::FastWriter().write(parsed) == expected;
+    ret.bytes = buffer.size();
+    ret.jsonValueNs = nsPerCall([&]() { jsonValue(); }, _minSeconds);
+    ret.jsonWriterNs = nsPerCall(jsonWriter, _minSeconds);
+    return ret;
+}
+
+/// A log as emitted by an ERC-20 transfer.
+LogEntry transferLog(unsigned _i)
+{
+    h256 const transfer = sha3(string("Transfer(address,address,uint256)"));
+    return LogEntry{Address{_i}, {transfer, h256{_i}, h256{_i + 1}}, h256{_i * 1000}.asBytes()};
+}
+}  // namespace
+
+vector<SerialisationResult> dev::eth::benchmarkSerialisation(double _minSeconds)
+{
+    BlockHeader header;
+    header.setNumber(9000000);
+    header.setTimestamp(1574706444);
+    header.setGasLimit(9990000);
+    header.setGasUsed(9980000);
+    header.setAuthor(Address{1});
+    header.setParentHash(h256{2});
+    header.setRoots(h256{3}, h256{4}, h256{5}, h256{6});
+    header.setExtraData(asBytes("aleth-bench"));
+    header.setDifficulty(u256{1} << 51);
+    h256 const blockHash = header.hash();
+
+    Secret const secret{sha3(string("aleth-bench"))};
+    Transactions transactions;
+    for (unsigned i = 0; i < c_blockTransactions; ++i)
+    {
+        // ERC-20 transfer calls with the sender recovered beforehand, as the client caches it.
+        transactions.emplace_back(0, 20000000000, 60000, Address{i}, bytes(68, byte(i)), i, secret);
+        transactions.back().sender();
+    }
+    TransactionHashes hashes;
+    for (auto const& t: transactions)
+        hashes.push_back(t.sha3());
+    BlockDetails const details{9000000, u256{1} << 73, h256{2}, {}, 40000};
+
+    LogEntries receiptLogs;
+    for (unsigned i = 0; i < c_receiptLogs; ++i)
+        receiptLogs.push_back(transferLog(i));
+    LocalisedTransactionReceipt const receipt{TransactionReceipt{1, 3000000, receiptLogs},
+        hashes[0], blockHash, 9000000, transactions[0].sender(), Address{1}, 0, 300000};
+
+    LocalisedLogEntries logs;
+    for (unsigned i = 0; i < c_filterLogs; ++i)
+        logs.emplace_back(transferLog(i), blockHash, 9000000, hashes[i % hashes.size()],
+            i % hashes.size(), i, BlockPolarity::Live);
+
+    string const transactionCount = " (" + to_string(c_blockTransactions) + " transactions)";
+    return {
+        compare("eth_getBlockByNumber, full" + transactionCount, _minSeconds, header, details,
+            UncleHashes{}, transactions),
+        compare("eth_getBlockByNumber, hashes" + transactionCount, _minSeconds, header, details,
+            UncleHashes{}, hashes),
+        compare("eth_getTransactionReceipt (" + to_string(c_receiptLogs) + " logs)", _minSeconds,
+            receipt),
+        compare("eth_getLogs (" + to_string(c_filterLogs) + " logs)", _minSeconds, logs),
+    };
+}
@@ -0,0 +1,30 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Serialisation of the largest JSON-RPC responses, through Json::Value as libjson-rpc-cpp does
+/// and straight into the response text with JsonWriter.
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+struct SerialisationResult
+{
+    std::string response;  ///< Method and the size of its result
+    size_t bytes = 0;      ///< Length of the response text
+    double jsonValueNs = 0;  ///< Time to build the Json::Value and write it with Json::FastWriter
+    double jsonWriterNs = 0;  ///< Time to write the same response with rpc::JsonWriter
+    bool identical = false;  ///< Whether both give the same JSON
+};
+
+/// Serialise responses to eth_getBlockByNumber, eth_getTransactionReceipt and eth_getLogs of
+/// typical mainnet sizes both ways, each for at least @a _minSeconds.
+std::vector<SerialisationResult> benchmarkSerialisation(double _minSeconds);
+}  // namespace eth
+}  // namespace dev
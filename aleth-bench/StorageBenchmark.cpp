@@ -0,0 +1,107 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "StorageBenchmark.h"
+#include "BenchmarkUtils.h"
+
+#include <libdevcore/MemoryDB.h>
+#include <libdevcore/SHA3.h>
+#include <libethereum/BlockDetails.h>
+#include <libethereum/ChainDataCompression.h>
+
+#include <functional>
+#include <random>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+unsigned const c_blocks = 200;
+unsigned const c_blockTransactions = 150;
+unsigned const c_contracts = 500;
+
+h256 padded(Address const& _address)
+{
+    return h256(_address, h256::AlignRight);
+}
+
+/// Receipts of token transfers: a Transfer log each, with small amounts and zero-padded addresses.
+bytes receipts(mt19937& _gen)
+{
+    h256 const transfer = sha3("Transfer(address,address,uint256)");
+    BlockReceipts ret;
+    u256 gasUsed;
+    for (unsigned i = 0; i < c_blockTransactions; ++i)
+    {
+        Address const token{sha3("token" + to_string(_gen() % c_contracts))};
+        LogEntries logs{LogEntry{token,
+            h256s{transfer, padded(Address{sha3(to_string(_gen()))}),
+                padded(Address{sha3(to_string(_gen()))})},
+            h256(u256(_gen()) * 1000000000).asBytes()}};
+        gasUsed += 30000 + _gen() % 30000;
+        ret.receipts.emplace_back(1, gasUsed, logs);
+    }
+    return ret.rlp();
+}
+
+/// @returns the result for @a _values, stored under their index.
+StorageResult measure(string const& _kind, vector<bytes> const& _values,
+    function<void(string const&)> const& _decode, double _minSeconds)
+{
+    StorageResult ret;
+    ret.kind = _kind;
+    ret.values = _values.size();
+    db::MemoryDB raw;
+    db::MemoryDB compressed;
+    vector<string> keys;
+    for (size_t i = 0; i < _values.size(); ++i)
+    {
+        keys.push_back(to_string(i));
+        string const value = compressChainData(&_values[i]);
+        raw.insert(db::Slice(keys.back()), (db::Slice)dev::ref(_values[i]));
+        compressed.insert(db::Slice(keys.back()), db::Slice(value));
+        ret.rawBytes += _values[i].size();
+        ret.compressedBytes += value.size();
+    }
+    if (_values.empty())
+        return ret;
+
+    // Same reads as BlockChain::block() and queryExtras().
+    auto const readAll = [&](db::MemoryDB const& _db) {
+        for (string const& key : keys)
+        {
+            string value = _db.lookup(db::Slice(key));
+            uncompressChainData(value);
+            _decode(value);
+        }
+    };
+    auto const compressAll = [&]() {
+        for (bytes const& value : _values)
+            compressChainData(&value);
+    };
+    double const values = _values.size();
+    ret.compressNs = nsPerCall(compressAll, _minSeconds) / values;
+    ret.rawReadNs = nsPerCall([&]() { readAll(raw); }, _minSeconds) / values;
+    ret.compressedReadNs = nsPerCall([&]() { readAll(compressed); }, _minSeconds) / values;
+    return ret;
+}
+}  // namespace
+
+vector<StorageResult> dev::eth::benchmarkChainDataStorage(
+    vector<bytes> const& _blocks, double _minSeconds)
+{
+    mt19937 gen(5);
+    vector<bytes> blockReceipts;
+    for (unsigned i = 0; i < c_blocks; ++i)
+        blockReceipts.push_back(receipts(gen));
+
+    vector<StorageResult> ret;
+    auto const decodeReceipts = [](string const& _value) { BlockReceipts const decoded{RLP(_value)}; };
+    ret.push_back(measure("receipts", blockReceipts, decodeReceipts, _minSeconds));
+    if (!_blocks.empty())
+        ret.push_back(measure("blocks", _blocks, [](string const&) {}, _minSeconds));
+    return ret;
+}
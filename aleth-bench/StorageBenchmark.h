@@ -0,0 +1,34 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Size and read time of the block bodies and receipts stored with and without compression.
+#pragma once
+
+#include <libdevcore/Common.h>
+
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+struct StorageResult
+{
+    std::string kind;
+    size_t values = 0;
+    size_t rawBytes = 0;
+    size_t compressedBytes = 0;
+    double compressNs = 0;          ///< Time to compress a value before writing it
+    double rawReadNs = 0;           ///< Time to read a value stored uncompressed
+    double compressedReadNs = 0;    ///< Time to read a value stored compressed
+};
+
+/// Store ERC-20-like block receipts, and the blocks @a _blocks if there are any, both ways and read
+/// them back as BlockChain does, each for at least @a _minSeconds.
+std::vector<StorageResult> benchmarkChainDataStorage(
+    std::vector<bytes> const& _blocks, double _minSeconds);
+}  // namespace eth
+}  // namespace dev
@@ -0,0 +1,544 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "ArithmeticBenchmark.h"
+#include "CallBenchmark.h"
+#include "FilterBenchmark.h"
+#include "ImportBenchmark.h"
+#include "PrecompileBenchmark.h"
+#include "RpcBenchmark.h"
+#include "StorageBenchmark.h"
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/DBFactory.h>
+#include <libdevcore/Log.h>
+#include <libethashseal/Ethash.h>
+#include <libethashseal/GenesisInfo.h>
+#include <libethcore/Common.h>
+#include <libethereum/ChainParams.h>
+#include <libevm/VMFactory.h>
+
+#include <aleth/buildinfo.h>
+
+#include <json/json.h>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+namespace fs = boost::filesystem;
+namespace po = boost::program_options;
+
+namespace
+{
+void version()
+{
+    auto const* buildinfo = aleth_get_buildinfo();
+    cout << "aleth-bench " << buildinfo->project_version << "\n";
+    cout << "Build: " << buildinfo->system_name << "/" << buildinfo->build_type << "\n";
+    exit(AlethErrors::Success);
+}
+
+enum class Benchmark
+{
+    None,
+    Precompiles,
+    Import,
+    Rpc,
+    Filters,
+    Storage,
+    Calls,
+    Arithmetic
+};
+
+int benchmarkPrecompiles(po::variables_map const& _vm)
+{
+    ChainParams const chainParams(genesisInfo(Network::MainNetwork));
+    u256 const blockNumber =
+        _vm.count("block-number") ? _vm["block-number"].as<u256>() : chainParams.muirGlacierForkBlock;
+    double const minSeconds = _vm["min-time"].as<double>();
+    double const minGasRate = _vm["min-gas-rate"].as<double>();
+    vector<string> const only =
+        _vm.count("precompile") ? _vm["precompile"].as<vector<string>>() : vector<string>{};
+
+    vector<PrecompileResult> results;
+    for (auto const& input : precompileCorpus())
+        if (only.empty() || find(only.begin(), only.end(), input.precompile) != only.end())
+            results.push_back(benchmarkPrecompile(input, chainParams, blockNumber, minSeconds));
+    if (results.empty())
+    {
+        cerr << "No precompile matches the given names.\n";
+        return AlethErrors::ArgumentProcessingFailure;
+    }
+
+    // Failed calls are charged the gas too, so they are held to the same rate.
+    bool belowThreshold = false;
+    if (_vm.count("json"))
+    {
+        Json::Value json{Json::arrayValue};
+        for (auto const& result : results)
+        {
+            Json::Value entry{Json::objectValue};
+            entry["precompile"] = result.precompile;
+            entry["input"] = result.input;
+            entry["success"] = result.success;
+            entry["gas"] = toString(result.gas);
+            entry["calls"] = Json::UInt64(result.calls);
+            entry["nsPerCall"] = result.nsPerCall;
+            entry["gasPerSecond"] = result.gasPerSecond;
+            entry["belowThreshold"] = result.gasPerSecond < minGasRate;
+            belowThreshold |= result.gasPerSecond < minGasRate;
+            json.append(entry);
+        }
+        cout << Json::StyledWriter().write(json);
+    }
+    else
+    {
+        cout << left << setw(28) << "precompile" << setw(24) << "input" << right << setw(10)
+             << "gas" << setw(14) << "ns/call" << setw(14) << "Mgas/s" << "\n";
+        for (auto const& result : results)
+        {
+            bool const slow = result.gasPerSecond < minGasRate;
+            belowThreshold |= slow;
+            cout << left << setw(28) << result.precompile << setw(24) << result.input << right
+                 << setw(10) << result.gas << setw(14) << fixed << setprecision(0)
+                 << result.nsPerCall << setw(14) << setprecision(2)
+                 << result.gasPerSecond / 1000000 << (result.success ? "" : "  (failed)")
+                 << (slow ? "  BELOW THRESHOLD" : "") << "\n";
+        }
+    }
+    return belowThreshold ? AlethErrors::BenchmarkBelowThreshold : AlethErrors::Success;
+}
+
+Json::Value toJson(Distribution const& _distribution)
+{
+    Json::Value ret{Json::objectValue};
+    ret["count"] = Json::UInt64(_distribution.count);
+    ret["mean"] = _distribution.mean;
+    ret["p50"] = _distribution.p50;
+    ret["p90"] = _distribution.p90;
+    ret["p99"] = _distribution.p99;
+    ret["max"] = _distribution.max;
+    return ret;
+}
+
+int benchmarkImport(po::variables_map const& _vm)
+{
+    if (!_vm.count("chain"))
+    {
+        cerr << "Specify the blocks to import with --chain.\n";
+        return AlethErrors::ArgumentProcessingFailure;
+    }
+    // Defaulting to the data directory would copy the node's own database on every run.
+    if (_vm["db-path"].defaulted() || !db::isDiskDatabase())
+    {
+        cerr << "Specify the pre-state database with --db-path and a disk database with --db.\n";
+        return AlethErrors::ArgumentProcessingFailure;
+    }
+    fs::path const preState = db::databasePath();
+    if (!fs::is_directory(preState))
+    {
+        cerr << "Pre-state database directory not found: " << preState << "\n";
+        return AlethErrors::ArgumentProcessingFailure;
+    }
+
+    ChainParams chainParams;
+    if (_vm.count("config"))
+    {
+        fs::path const configPath = _vm["config"].as<string>();
+        try
+        {
+            chainParams = ChainParams{contentsString(configPath), {}, configPath};
+        }
+        catch (...)
+        {
+            cerr << "Provided configuration is not well-formatted.\n";
+            return AlethErrors::ConfigFileInvalid;
+        }
+    }
+    else
+        chainParams =
+            ChainParams(genesisInfo(Network::MainNetwork), genesisStateRoot(Network::MainNetwork));
+
+    Ethash::init();
+    NoProof::init();
+    NoReward::init();
+
+    vector<bytes> const blocks = readBlocks(_vm["chain"].as<string>());
+    fs::path const workDir = _vm.count("work-dir") ? _vm["work-dir"].as<string>() : string{};
+    unsigned const warmupRuns = _vm["warmup-runs"].as<unsigned>();
+    unsigned const runs = _vm["runs"].as<unsigned>();
+
+    // Stage durations are pooled over the measured runs, per block.
+    vector<double> runSeconds;
+    map<string, vector<double>> stages;
+    u256 gasUsed;
+    for (unsigned i = 0; i < warmupRuns + runs; ++i)
+    {
+        ImportRun run = replayImport(chainParams, preState, workDir, blocks);
+        if (i < warmupRuns)
+            continue;
+        runSeconds.push_back(run.seconds);
+        gasUsed = run.gasUsed;
+        for (auto& stage : run.stages)
+            stages[stage.first].insert(
+                stages[stage.first].end(), stage.second.begin(), stage.second.end());
+    }
+    Distribution const total = distribution(runSeconds);
+    double const gasPerSecond = total.p50 > 0 ? gasUsed.convert_to<double>() / total.p50 : 0;
+
+    if (_vm.count("json"))
+    {
+        Json::Value json{Json::objectValue};
+        json["blocks"] = Json::UInt64(blocks.size());
+        json["gasUsed"] = toString(gasUsed);
+        json["runs"] = runs;
+        json["vm"] = _vm["vm"].as<string>();
+        json["db"] = _vm["db"].as<string>();
+        json["runSeconds"] = toJson(total);
+        json["gasPerSecond"] = gasPerSecond;
+        Json::Value& stagesJson = json["stageSeconds"] = Json::Value{Json::objectValue};
+        for (auto const& stage : stages)
+            stagesJson[stage.first] = toJson(distribution(stage.second));
+        cout << Json::StyledWriter().write(json);
+    }
+    else
+    {
+        cout << blocks.size() << " blocks, " << gasUsed << " gas, median run " << fixed
+             << setprecision(3) << total.p50 << " s (" << setprecision(2)
+             << gasPerSecond / 1000000 << " Mgas/s) over " << runs << " runs\n";
+        cout << left << setw(20) << "stage (ms)" << right << setw(10) << "count" << setw(10)
+             << "mean" << setw(10) << "p50" << setw(10) << "p90" << setw(10) << "p99" << setw(10)
+             << "max" << "\n";
+        for (auto const& stage : stages)
+        {
+            Distribution const d = distribution(stage.second);
+            cout << left << setw(20) << stage.first << right << setw(10) << d.count
+                 << setprecision(3) << setw(10) << d.mean * 1000 << setw(10) << d.p50 * 1000
+                 << setw(10) << d.p90 * 1000 << setw(10) << d.p99 * 1000 << setw(10)
+                 << d.max * 1000 << "\n";
+        }
+    }
+    return AlethErrors::Success;
+}
+
+int benchmarkRpc(po::variables_map const& _vm)
+{
+    vector<SerialisationResult> const results = benchmarkSerialisation(_vm["min-time"].as<double>());
+    bool identical = true;
+    if (_vm.count("json"))
+    {
+        Json::Value json{Json::arrayValue};
+        for (auto const& result : results)
+        {
+            Json::Value entry{Json::objectValue};
+            entry["response"] = result.response;
+            entry["bytes"] = Json::UInt64(result.bytes);
+            entry["jsonValueNs"] = result.jsonValueNs;
+            entry["jsonWriterNs"] = result.jsonWriterNs;
+            entry["identical"] = result.identical;
+            identical &= result.identical;
+            json.append(entry);
+        }
+        cout << Json::StyledWriter().write(json);
+    }
+    else
+    {
+        cout << left << setw(48) << "response" << right << setw(10) << "bytes" << setw(16)
+             << "Json::Value us" << setw(16) << "JsonWriter us" << setw(10) << "speedup" << "\n";
+        for (auto const& result : results)
+        {
+            identical &= result.identical;
+            cout << left << setw(48) << result.response << right << setw(10) << result.bytes
+                 << fixed << setprecision(1) << setw(16) << result.jsonValueNs / 1000 << setw(16)
+                 << result.jsonWriterNs / 1000 << setw(9) << result.jsonValueNs / result.jsonWriterNs
+                 << "x" << (result.identical ? "" : "  DIFFERENT OUTPUT") << "\n";
+        }
+    }
+    return identical ? AlethErrors::Success : AlethErrors::BenchmarkFailure;
+}
+
+int benchmarkFilters(po::variables_map const& _vm)
+{
+    FilterMatchingResult const result =
+        benchmarkFilterMatching(_vm["filters"].as<size_t>(), _vm["min-time"].as<double>());
+    if (_vm.count("json"))
+    {
+        Json::Value json{Json::objectValue};
+        json["filters"] = Json::UInt64(result.filters);
+        json["logs"] = Json::UInt64(result.logs);
+        json["matches"] = Json::UInt64(result.matches);
+        json["linearNs"] = result.linearNs;
+        json["indexedNs"] = result.indexedNs;
+        json["identical"] = result.identical;
+        cout << Json::StyledWriter().write(json);
+    }
+    else
+    {
+        cout << result.filters << " filters, block of " << result.logs << " logs, "
+             << result.matches << " matches\n";
+        cout << fixed << setprecision(1) << "each filter in turn: " << setw(12)
+             << result.linearNs / 1000 << " us/block\n";
+        cout << "indexed filters:     " << setw(12) << result.indexedNs / 1000 << " us/block ("
+             << result.linearNs / result.indexedNs << "x)"
+             << (result.identical ? "" : "  DIFFERENT MATCHES") << "\n";
+    }
+    return result.identical ? AlethErrors::Success : AlethErrors::BenchmarkFailure;
+}
+
+int benchmarkStorage(po::variables_map const& _vm)
+{
+    vector<bytes> const blocks =
+        _vm.count("chain") ? readBlocks(_vm["chain"].as<string>()) : vector<bytes>{};
+    vector<StorageResult> const results =
+        benchmarkChainDataStorage(blocks, _vm["min-time"].as<double>());
+    if (_vm.count("json"))
+    {
+        Json::Value json{Json::arrayValue};
+        for (auto const& result : results)
+        {
+            Json::Value entry{Json::objectValue};
+            entry["kind"] = result.kind;
+            entry["values"] = Json::UInt64(result.values);
+            entry["rawBytes"] = Json::UInt64(result.rawBytes);
+            entry["compressedBytes"] = Json::UInt64(result.compressedBytes);
+            entry["compressNs"] = result.compressNs;
+            entry["rawReadNs"] = result.rawReadNs;
+            entry["compressedReadNs"] = result.compressedReadNs;
+            json.append(entry);
+        }
+        cout << Json::StyledWriter().write(json);
+    }
+    else
+    {
+        cout << left << setw(10) << "values" << right << setw(8) << "count" << setw(14)
+             << "raw bytes" << setw(14) << "snappy bytes" << setw(8) << "ratio" << setw(14)
+             << "compress us" << setw(14) << "raw read us" << setw(16) << "snappy read us"
+             << "\n";
+        for (auto const& result : results)
+            cout << left << setw(10) << result.kind << right << setw(8) << result.values
+                 << setw(14) << result.rawBytes << setw(14) << result.compressedBytes << fixed
+                 << setprecision(2) << setw(8)
+                 << double(result.compressedBytes) / max<size_t>(result.rawBytes, 1)
+                 << setprecision(1) << setw(14) << result.compressNs / 1000 << setw(14)
+                 << result.rawReadNs / 1000 << setw(16) << result.compressedReadNs / 1000 << "\n";
+    }
+    return AlethErrors::Success;
+}
+
+int benchmarkCalls(po::variables_map const& _vm)
+{
+    vector<CallFramesResult> const results = benchmarkCallFrames(_vm["min-time"].as<double>());
+    bool success = true;
+    if (_vm.count("json"))
+    {
+        Json::Value json{Json::arrayValue};
+        for (auto const& result : results)
+        {
+            Json::Value entry{Json::objectValue};
+            entry["contract"] = result.contract;
+            entry["frames"] = result.frames;
+            entry["gasUsed"] = toString(result.gasUsed);
+            entry["success"] = result.success;
+            entry["unpooledNs"] = result.unpooledNs;
+            entry["pooledNs"] = result.pooledNs;
+            success &= result.success;
+            json.append(entry);
+        }
+        cout << Json::StyledWriter().write(json);
+    }
+    else
+    {
+        cout << left << setw(28) << "contract" << right << setw(8) << "frames" << setw(12)
+             << "gas" << setw(14) << "new VM us" << setw(14) << "pooled us" << setw(10)
+             << "speedup" << "\n";
+        for (auto const& result : results)
+        {
+            success &= result.success;
+            cout << left << setw(28) << result.contract << right << setw(8) << result.frames
+                 << setw(12) << result.gasUsed << fixed << setprecision(1) << setw(14)
+                 << result.unpooledNs / 1000 << setw(14) << result.pooledNs / 1000 << setw(9)
+                 << setprecision(2) << result.unpooledNs / result.pooledNs << "x"
+                 << (result.success ? "" : "  (failed)") << "\n";
+        }
+    }
+    return success ? AlethErrors::Success : AlethErrors::BenchmarkFailure;
+}
+
+int benchmarkArithmetic(po::variables_map const& _vm)
+{
+    vector<ArithmeticResult> const results =
+        benchmarkArithmeticPrograms(_vm["min-time"].as<double>());
+    bool success = true;
+    if (_vm.count("json"))
+    {
+        Json::Value json{Json::arrayValue};
+        for (auto const& result : results)
+        {
+            Json::Value entry{Json::objectValue};
+            entry["program"] = result.program;
+            entry["vm"] = _vm["vm"].as<string>();
+            entry["operations"] = Json::UInt64(result.operations);
+            entry["gasUsed"] = toString(result.gasUsed);
+            entry["success"] = result.success;
+            entry["nsPerRun"] = result.nsPerRun;
+            entry["nsPerOperation"] = result.nsPerOperation;
+            entry["gasPerSecond"] = result.gasPerSecond;
+            success &= result.success;
+            json.append(entry);
+        }
+        cout << Json::StyledWriter().write(json);
+    }
+    else
+    {
+        cout << _vm["vm"].as<string>() << " VM\n";
+        cout << left << setw(10) << "program" << right << setw(12) << "operations" << setw(12)
+             << "gas" << setw(14) << "us/run" << setw(10) << "ns/op" << setw(10) << "Mgas/s"
+             << "\n";
+        for (auto const& result : results)
+        {
+            success &= result.success;
+            cout << left << setw(10) << result.program << right << setw(12) << result.operations
+                 << setw(12) << result.gasUsed << fixed << setprecision(1) << setw(14)
+                 << result.nsPerRun / 1000 << setw(10) << result.nsPerOperation << setw(10)
+                 << setprecision(2) << result.gasPerSecond / 1000000
+                 << (result.success ? "" : "  WRONG RESULT") << "\n";
+        }
+    }
+    return success ? AlethErrors::Success : AlethErrors::BenchmarkFailure;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    setDefaultOrCLocale();
+    Benchmark benchmark = Benchmark::None;
+
+    po::options_description precompileOptions("Precompile options", c_lineWidth);
+    auto addPrecompileOption = precompileOptions.add_options();
+    addPrecompileOption("precompile", po::value<vector<string>>()->value_name("<name>"),
+        "Only benchmark the precompile <name>, can be given several times.");
+    addPrecompileOption("block-number", po::value<u256>()->value_name("<n>"),
+        "Price calls as in mainnet block <n> (default: latest fork).");
+    addPrecompileOption("min-gas-rate",
+        po::value<double>()->default_value(10000000)->value_name("<gas/s>"),
+        "Flag inputs executed at less than <gas/s> and exit with an error code.");
+
+    po::options_description importOptions("Import options", c_lineWidth);
+    auto addImportOption = importOptions.add_options();
+    addImportOption("chain", po::value<string>()->value_name("<file>"),
+        "Import the blocks in <file>, as written by aleth export; storage also stores them.");
+    addImportOption("config", po::value<string>()->value_name("<file>"),
+        "Configure the chain with the JSON in <file> (default: mainnet).");
+    addImportOption("runs", po::value<unsigned>()->default_value(3)->value_name("<n>"),
+        "Measure <n> imports of the whole chain segment.");
+    addImportOption("warmup-runs", po::value<unsigned>()->default_value(1)->value_name("<n>"),
+        "Import the chain segment <n> times before measuring.");
+    addImportOption("work-dir", po::value<string>()->value_name("<path>"),
+        "Copy the pre-state database under <path> for each run (default: temporary directory).");
+
+    po::options_description filterOptions("Filter options", c_lineWidth);
+    auto addFilterOption = filterOptions.add_options();
+    addFilterOption("filters", po::value<size_t>()->default_value(10000)->value_name("<n>"),
+        "Match a block against <n> installed log filters.");
+
+    po::options_description generalOptions("General options", c_lineWidth);
+    auto addGeneralOption = generalOptions.add_options();
+    addGeneralOption("min-time", po::value<double>()->default_value(0.5)->value_name("<s>"),
+        "Run each precompile input, RPC response, filter match, storage read, call-heavy "
+        "transaction or arithmetic program for at least <s> seconds.");
+    addGeneralOption("json", "Output the results as JSON.");
+    addGeneralOption("version,v", "Show the version and exit.");
+    addGeneralOption("help,h", "Show this help message and exit.");
+
+    po::options_description allowedOptions(
+        "Usage aleth-bench <options> precompiles|import|rpc|filters|storage|calls|arithmetic");
+    allowedOptions.add(precompileOptions)
+        .add(importOptions)
+        .add(filterOptions)
+        .add(db::databaseProgramOptions(c_lineWidth))
+        .add(vmProgramOptions(c_lineWidth))
+        .add(generalOptions);
+
+    po::variables_map vm;
+    vector<string> unrecognisedOptions;
+    try
+    {
+        po::parsed_options parsed =
+            po::command_line_parser(argc, argv).options(allowedOptions).allow_unregistered().run();
+        unrecognisedOptions = collect_unrecognized(parsed.options, po::include_positional);
+        po::store(parsed, vm);
+        po::notify(vm);
+    }
+    catch (po::error const& e)
+    {
+        cerr << e.what() << "\n";
+        return AlethErrors::ArgumentProcessingFailure;
+    }
+
+    for (auto const& arg : unrecognisedOptions)
+    {
+        if (arg == "precompiles")
+            benchmark = Benchmark::Precompiles;
+        else if (arg == "import")
+            benchmark = Benchmark::Import;
+        else if (arg == "rpc")
+            benchmark = Benchmark::Rpc;
+        else if (arg == "filters")
+            benchmark = Benchmark::Filters;
+        else if (arg == "storage")
+            benchmark = Benchmark::Storage;
+        else if (arg == "calls")
+            benchmark = Benchmark::Calls;
+        else if (arg == "arithmetic")
+            benchmark = Benchmark::Arithmetic;
+        else
+        {
+            cerr << "Unknown argument: " << arg << '\n';
+            return AlethErrors::UnknownArgument;
+        }
+    }
+    if (vm.count("version"))
+        version();
+    if (vm.count("help") || benchmark == Benchmark::None)
+    {
+        cout << allowedOptions;
+        return AlethErrors::Success;
+    }
+
+    // Keep the block import logs out of the results.
+    LoggingOptions loggingOptions;
+    loggingOptions.verbosity = VerbosityError;
+    setupLogging(loggingOptions);
+
+    try
+    {
+        switch (benchmark)
+        {
+        case Benchmark::Import:
+            return benchmarkImport(vm);
+        case Benchmark::Rpc:
+            return benchmarkRpc(vm);
+        case Benchmark::Filters:
+            return benchmarkFilters(vm);
+        case Benchmark::Storage:
+            return benchmarkStorage(vm);
+        case Benchmark::Calls:
+            return benchmarkCalls(vm);
+        case Benchmark::Arithmetic:
+            return benchmarkArithmetic(vm);
+        default:
+            return benchmarkPrecompiles(vm);
+        }
+    }
+    catch (boost::exception const& _e)
+    {
+        cerr << boost::diagnostic_information(_e);
+        return AlethErrors::BenchmarkFailure;
+    }
+}
@@ -21,15 +21,47 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/program_options.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <ctime>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <new>
+#include <system_error>
 
 using namespace std;
 using namespace dev;
 using namespace eth;
 namespace po = boost::program_options;
 
+namespace
+{
+/// Allocations made through operator new, counted per run in the benchmark mode only.
+atomic<bool> g_countAllocations{false};
+atomic<uint64_t> g_allocations{0};
+}  // namespace
+
+void* operator new(size_t _size)
+{
+    if (g_countAllocations.load(memory_order_relaxed))
+        g_allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(_size ? _size : 1))
+        return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* _p) noexcept
+{
+    free(_p);
+}
+
+void operator delete(void* _p, size_t) noexcept
+{
+    free(_p);
+}
+
 namespace
 {
 int64_t maxBlockGasLimit()
@@ -56,10 +88,87 @@ enum class Mode
     /// Test mode -- output information needed for test verification and
     /// benchmarking. The execution is not introspected not to degrade
     /// performance.
-    Test
+    Test,
+
+    /// Benchmark mode -- run the transaction repeatedly, on one VM or on several in turn, and
+    /// report the distribution of the execution times.
+    Benchmark
+};
+
+struct BenchmarkResult
+{
+    string vm;
+    ExecutionResult result;
+    u256 executionGas;             ///< Gas used by the code, without intrinsic gas and refunds
+    vector<double> seconds;        ///< Execution time of the measured runs, sorted
+    uint64_t allocations = 0;      ///< Allocations made by the last run
 };
+
+/// @returns the time under which @a _percent percent of the sorted @a _seconds are.
+double percentile(vector<double> const& _seconds, unsigned _percent)
+{
+    size_t const rank = (_seconds.size() * _percent + 99) / 100;
+    return _seconds[max<size_t>(rank, 1) - 1];
+}
+
+/// Runs @a _t, which must have its sender set, on the VM of the global kind, and then undoes its
+/// changes to @a _state so that the next run starts from the same state.
+ExecutionResult run(State& _state, EnvInfo const& _envInfo, SealEngineFace const& _se,
+    Transaction const& _t, Address const& _origin, double& o_seconds, u256& o_executionGas,
+    uint64_t& o_allocations)
+{
+    size_t const savepoint = _state.savepoint();
+    ExecutionResult ret;
+    {
+        Executive executive{_state, _envInfo, _se};
+        executive.setResultRecipient(ret);
+        executive.initialize(_t);
+        if (_t.isCreation())
+            executive.create(_t.sender(), _t.value(), _t.gasPrice(), _t.gas(), &_t.data(), _origin);
+        else
+            executive.call(_t.receiveAddress(), _t.sender(), _t.value(), _t.gasPrice(), &_t.data(),
+                _t.gas());
+
+        u256 const gas = executive.gas();
+        uint64_t const allocations = g_allocations.load(memory_order_relaxed);
+        Timer timer;
+        executive.go();
+        o_seconds = chrono::duration<double>(timer.duration()).count();
+        o_allocations = g_allocations.load(memory_order_relaxed) - allocations;
+        o_executionGas = gas - executive.gas();
+        executive.finalize();
+    }
+    _state.rollback(savepoint);
+    return ret;
 }
 
+/// Runs @a _t @a _warmup times and then @a _repeat times measured, on each of @a _vms in turn.
+vector<BenchmarkResult> benchmark(vector<string> const& _vms, unsigned _warmup, unsigned _repeat,
+    State& _state, EnvInfo const& _envInfo, SealEngineFace const& _se, Transaction const& _t,
+    Address const& _origin)
+{
+    vector<BenchmarkResult> ret;
+    for (auto const& vm : _vms)
+    {
+        if (!vm.empty())
+            VMFactory::setKind(vm);
+        BenchmarkResult result;
+        result.vm = vm.empty() ? "default" : vm;
+        double seconds = 0;
+        for (unsigned i = 0; i < _warmup + _repeat; ++i)
+        {
+            result.result = run(_state, _envInfo, _se, _t, _origin, seconds, result.executionGas,
+                result.allocations);
+            if (i >= _warmup)
+                result.seconds.push_back(seconds);
+        }
+        sort(result.seconds.begin(), result.seconds.end());
+        ret.push_back(move(result));
+    }
+    return ret;
+}
+}  // namespace
+
 class LastBlockHashes : public eth::LastBlockHashesFace
 {
 public:
@@ -125,6 +234,17 @@ int main(int argc, char** argv)
     addTraceOption("flat", "Minimal whitespace in the JSON.");
     addTraceOption("mnemonics", "Show instruction mnemonics in the trace (non-standard).\n");
 
+    po::options_description optionsForBenchmark("Options for bench", c_lineWidth);
+    auto addBenchmarkOption = optionsForBenchmark.add_options();
+    addBenchmarkOption("repeat", po::value<unsigned>()->default_value(100)->value_name("<n>"),
+        "Measure <n> runs of the transaction.");
+    addBenchmarkOption("warmup", po::value<unsigned>()->default_value(10)->value_name("<n>"),
+        "Run the transaction <n> times before measuring.");
+    addBenchmarkOption("compare",
+        po::value<vector<string>>()->multitoken()->value_name("<name>|<path>"),
+        "Run on each of the given VMs in turn instead of the one of --vm: legacy, interpreter or "
+        "the path of an EVMC VM.\n");
+
     LoggingOptions loggingOptions;
     po::options_description loggingProgramOptions(
         createLoggingProgramOptions(c_lineWidth, loggingOptions));
@@ -147,10 +267,12 @@ int main(int argc, char** argv)
             ->notifier([&](int64_t _t) { blockHeader.setTimestamp(_t); }),
         "<n> Set timestamp");
 
-    po::options_description allowedOptions("Usage ethvm <options> [trace|stats|output|test]");
+    po::options_description allowedOptions(
+        "Usage ethvm <options> [trace|stats|output|test|bench]");
     allowedOptions.add(vmProgramOptions(c_lineWidth))
         .add(networkOptions)
         .add(optionsForTrace)
+        .add(optionsForBenchmark)
         .add(loggingProgramOptions)
         .add(generalOptions)
         .add(transactionOptions);
@@ -175,6 +297,8 @@ int main(int argc, char** argv)
             mode = Mode::Trace;
         else if (arg == "test")
             mode = Mode::Test;
+        else if (arg == "bench")
+            mode = Mode::Benchmark;
         else
         {
             cerr << "Unknown argument: " << arg << '\n';
@@ -294,6 +418,64 @@ int main(int argc, char** argv)
 
     state.addBalance(sender, value);
 
+    if (mode == Mode::Benchmark)
+    {
+        t.forceSender(sender);
+        unsigned const repeat = vm["repeat"].as<unsigned>();
+        if (repeat == 0)
+        {
+            cerr << "Option --repeat must be at least 1.\n";
+            return AlethErrors::ArgumentProcessingFailure;
+        }
+        vector<string> const vms =
+            vm.count("compare") ? vm["compare"].as<vector<string>>() : vector<string>{""};
+        // Load every VM once before the first run, so that a wrong name stops here.
+        for (auto const& name : vms)
+        {
+            try
+            {
+                if (!name.empty())
+                    VMFactory::setKind(name);
+            }
+            catch (po::error const& _e)
+            {
+                cerr << "Option --compare: " << _e.what() << "\n";
+                return AlethErrors::ArgumentProcessingFailure;
+            }
+            catch (system_error const& _e)
+            {
+                cerr << "Option --compare: " << _e.what() << "\n";
+                return AlethErrors::ArgumentProcessingFailure;
+            }
+        }
+        g_countAllocations = true;
+        vector<BenchmarkResult> const results = benchmark(
+            vms, vm["warmup"].as<unsigned>(), repeat, state, envInfo, *se, t, origin);
+
+        cout << repeat << " runs after " << vm["warmup"].as<unsigned>() << " warmup runs\n";
+        cout << left << setw(24) << "vm" << right << setw(14) << "gas used" << setw(14)
+             << "median us" << setw(14) << "p99 us" << setw(12) << "Mgas/s" << setw(12)
+             << "allocs/run" << "\n";
+        bool allSame = true;
+        for (auto const& result : results)
+        {
+            double const median = percentile(result.seconds, 50);
+            BenchmarkResult const& first = results.front();
+            bool const same = result.result.output == first.result.output &&
+                              result.result.gasUsed == first.result.gasUsed &&
+                              result.result.excepted == first.result.excepted;
+            allSame &= same;
+            cout << left << setw(24) << result.vm << right << setw(14) << result.result.gasUsed
+                 << fixed << setprecision(1) << setw(14) << median * 1e6 << setw(14)
+                 << percentile(result.seconds, 99) * 1e6 << setprecision(2) << setw(12)
+                 << result.executionGas.convert_to<double>() / median / 1e6 << setw(12)
+                 << result.allocations
+                 << (result.result.excepted != TransactionException::None ? "  (exception)" : "")
+                 << (same ? "" : "  DIFFERENT RESULT") << "\n";
+        }
+        return allSame ? AlethErrors::Success : AlethErrors::BenchmarkFailure;
+    }
+
     Executive executive(state, envInfo, *se);
     ExecutionResult res;
     executive.setResultRecipient(res);
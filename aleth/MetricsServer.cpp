@@ -0,0 +1,69 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "MetricsServer.h"
+
+#include <memory>
+
+using namespace std;
+using namespace dev;
+namespace ba = boost::asio;
+namespace bi = ba::ip;
+
+namespace
+{
+struct Connection
+{
+    explicit Connection(ba::io_context& _ioContext) : socket(_ioContext) {}
+
+    bi::tcp::socket socket;
+    ba::streambuf request;
+    string response;
+};
+}  // namespace
+
+MetricsServer::MetricsServer(unsigned short _port, function<string()> _metrics)
+  : m_metrics(move(_metrics)),
+    m_acceptor(m_ioContext, bi::tcp::endpoint(bi::address_v4::loopback(), _port))
+{
+    accept();
+    m_thread = thread([this] { m_ioContext.run(); });
+}
+
+MetricsServer::~MetricsServer()
+{
+    m_ioContext.stop();
+    m_thread.join();
+}
+
+void MetricsServer::accept()
+{
+    auto connection = make_shared<Connection>(m_ioContext);
+    m_acceptor.async_accept(connection->socket, [this, connection](boost::system::error_code _ec) {
+        if (_ec)
+            return;
+        accept();
+
+        // The request itself is irrelevant, any path returns the metrics.
+        ba::async_read_until(connection->socket, connection->request, "\r\n\r\n",
+            [this, connection](boost::system::error_code _ec, size_t) {
+                if (_ec)
+                    return;
+                string const body = m_metrics();
+                connection->response =
+                    "HTTP/1.1 200 OK\r\n"
+                    "Content-Type: text/plain; version=0.0.4\r\n"
+                    "Content-Length: " +
+                    to_string(body.size()) +
+                    "\r\n"
+                    "Connection: close\r\n\r\n" +
+                    body;
+                ba::async_write(connection->socket, ba::buffer(connection->response),
+                    [connection](boost::system::error_code, size_t) {
+                        boost::system::error_code ignored;
+                        connection->socket.shutdown(bi::tcp::socket::shutdown_both, ignored);
+                    });
+            });
+    });
+}
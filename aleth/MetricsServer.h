@@ -0,0 +1,33 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Minimal HTTP endpoint for Prometheus to scrape the client metrics from.
+#pragma once
+
+#include <boost/asio.hpp>
+
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace dev
+{
+/// Answers every HTTP request on 127.0.0.1:<port> with the text returned by the metrics
+/// function, on a thread of its own.
+class MetricsServer
+{
+public:
+    MetricsServer(unsigned short _port, std::function<std::string()> _metrics);
+    ~MetricsServer();
+
+private:
+    void accept();
+
+    std::function<std::string()> m_metrics;
+    boost::asio::io_context m_ioContext;
+    boost::asio::ip::tcp::acceptor m_acceptor;
+    std::thread m_thread;
+};
+}  // namespace dev
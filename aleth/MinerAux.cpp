@@ -44,6 +44,8 @@ void MinerCLI::interpretOptions(variables_map const& _options)
     else
         m_miningThreads = UINT_MAX;
 
+    m_pinMiningThreads = _options.count("mining-pin-threads") > 0;
+
     if (_options.count("current-block"))
         m_currentBlock = _options["current-block"].as<unsigned int>();
     else
@@ -69,6 +71,8 @@ options_description MinerCLI::createProgramOptions(unsigned int _lineLength)
     addMiningOption("cpu,C", "When mining, use the CPU");
     addMiningOption("mining-threads,t", value<unsigned int>()->value_name("<n>"),
         "Limit number of CPU/GPU miners to n (default: use everything available on selected platform)");
+    addMiningOption("mining-pin-threads",
+        "Bind each CPU miner thread to its own CPU, spreading them over NUMA nodes (Linux only)");
     addMiningOption("current-block", value<unsigned int>()->value_name("<n>"),
         "Let the miner know the current block number at configuration time. Will help determine DAG size and required GPU memory");
     addMiningOption("disable-submit-hashrate", "When mining, don't submit hashrate to node\n");
@@ -79,7 +83,10 @@ options_description MinerCLI::createProgramOptions(unsigned int _lineLength)
 void MinerCLI::execute()
 {
     if (m_minerType == "cpu")
+    {
         EthashCPUMiner::setNumInstances(m_miningThreads);
+        EthashCPUMiner::setPinThreads(m_pinMiningThreads);
+    }
     else if (mode == OperationMode::Benchmark)
         doBenchmark(m_minerType, m_benchmarkWarmup, m_benchmarkTrial, m_benchmarkTrials);
 }
@@ -42,6 +42,7 @@ private:
     /// Mining options
     std::string m_minerType = "cpu";
     unsigned m_miningThreads = UINT_MAX;
+    bool m_pinMiningThreads = false;
     uint64_t m_currentBlock = 0;
 
     /// Benchmarking params
@@ -24,22 +24,26 @@
 #include <libethereum/SnapshotImporter.h>
 #include <libethereum/SnapshotStorage.h>
 #include <libevm/VMFactory.h>
+#include <libevm/VMProfiler.h>
 #include <libwebthree/WebThree.h>
 
 #include <libweb3jsonrpc/AccountHolder.h>
 #include <libweb3jsonrpc/Eth.h>
 #include <libweb3jsonrpc/ModularServer.h>
 #include <libweb3jsonrpc/IpcServer.h>
+#include <libweb3jsonrpc/Subscriptions.h>
 #include <libweb3jsonrpc/Net.h>
 #include <libweb3jsonrpc/Web3.h>
 #include <libweb3jsonrpc/AdminNet.h>
 #include <libweb3jsonrpc/AdminEth.h>
 #include <libweb3jsonrpc/Personal.h>
 #include <libweb3jsonrpc/Debug.h>
+#include <libweb3jsonrpc/Metrics.h>
 #include <libweb3jsonrpc/Test.h>
 
 #include "MinerAux.h"
 #include "AccountManager.h"
+#include "MetricsServer.h"
 
 #include <aleth/buildinfo.h>
 
@@ -76,7 +80,8 @@ enum class OperationMode
     Node,
     Import,
     ImportSnapshot,
-    Export
+    Export,
+    RecompressChainData
 };
 
 enum class Format
@@ -150,6 +155,7 @@ int main(int argc, char** argv)
     bool bootstrap = true;
     bool disableDiscovery = false;
     bool allowLocalDiscovery = false;
+    bool fastSync = false;
     static const unsigned NoNetworkID = (unsigned)-1;
     unsigned networkID = NoNetworkID;
 
@@ -214,6 +220,10 @@ int main(int argc, char** argv)
     addClientOption("ipcpath", po::value<string>()->value_name("<path>"),
         "Set .ipc socket path (default: data directory)");
     addClientOption("no-ipc", "Disable IPC server");
+    addClientOption("metrics-port", po::value<unsigned short>()->value_name("<port>"),
+        "Serve performance metrics in the Prometheus text format on 127.0.0.1:<port>");
+    addClientOption("vm-profile",
+        "Profile the operations executed by the VM, see debug_vmProfile (default: off)");
     addClientOption("admin", po::value<string>()->value_name("<password>"),
         "Specify admin session key for JSON-RPC (default: auto-generated and printed at "
         "start-up)");
@@ -221,7 +231,10 @@ int main(int argc, char** argv)
     addClientOption("rebuild,R",
         "Rebuild the blockchain from the existing database. This involves reimporting all blocks "
         "and will probably take a while.");
-    addClientOption("rescue", "Attempt to rescue a corrupt database\n");
+    addClientOption("rescue", "Attempt to rescue a corrupt database");
+    addClientOption("chain-data-compression",
+        po::value<string>()->value_name("<none/snappy>")->default_value("none"),
+        "Compress block bodies and receipts when storing them; either form is read\n");
     addClientOption("import-presale", po::value<string>()->value_name("<file>"),
         "Import a pre-sale key; you'll need to specify the password to this key");
     addClientOption("import-secret,s", po::value<string>()->value_name("<secret>"),
@@ -297,7 +310,10 @@ int main(int argc, char** argv)
     string peersetDescription = peersetDescriptionStream.str();
     addNetworkingOption("peerset", po::value<string>()->value_name("<list>"), peersetDescription.c_str());
     addNetworkingOption("no-discovery", "Disable node discovery; implies --no-bootstrap");
-    addNetworkingOption("pin", "Only accept or connect to trusted peers\n");
+    addNetworkingOption("pin", "Only accept or connect to trusted peers");
+    addNetworkingOption("fast-sync", po::bool_switch(&fastSync),
+        "When far behind the network, import blocks without executing them and download the "
+        "state of a recent block instead\n");
 
     std::string snapshotPath;
     po::options_description importExportMode("IMPORT/EXPORT MODES", c_lineWidth);
@@ -322,7 +338,10 @@ int main(int argc, char** argv)
         po::value<string>(&snapshotPath)->value_name("<path>"),
         "Download Parity Warp Sync snapshot data to the specified path");
     addImportExportOption("import-snapshot", po::value<string>()->value_name("<path>"),
-        "Import blockchain and state data from the Parity Warp Sync snapshot\n");
+        "Import blockchain and state data from the Parity Warp Sync snapshot");
+    addImportExportOption("recompress-chain-data",
+        "Rewrite the stored block bodies and receipts of the chain as --chain-data-compression "
+        "asks for\n");
 
     std::string const logChannels =
         "block blockhdr bq chain client debug discov error ethcap exec host impolite info net "
@@ -380,6 +399,17 @@ int main(int argc, char** argv)
         mode = OperationMode::ImportSnapshot;
         filename = vm["import-snapshot"].as<string>();
     }
+    if (vm.count("recompress-chain-data"))
+        mode = OperationMode::RecompressChainData;
+    {
+        string const compression = vm["chain-data-compression"].as<string>();
+        if (compression != "none" && compression != "snappy")
+        {
+            cerr << "Bad --chain-data-compression option: " << compression << "\n";
+            return AlethErrors::ArgumentProcessingFailure;
+        }
+        setChainDataCompression(compression == "snappy");
+    }
     if (vm.count("version"))
     {
         version();
@@ -440,6 +470,8 @@ int main(int argc, char** argv)
         ipc = true;
     if (vm.count("no-ipc"))
         ipc = false;
+    if (vm.count("vm-profile"))
+        VMProfiler::setEnabled(true);
     if (vm.count("mining"))
     {
         string m = vm["mining"].as<string>();
@@ -756,6 +788,17 @@ int main(int argc, char** argv)
     if (testingMode)
         chainParams.allowFutureBlocks = true;
 
+    if (mode == OperationMode::RecompressChainData)
+    {
+        BlockChain bc(chainParams, db::databasePath(), withExisting);
+        cout << "Rewriting the bodies and receipts of blocks 1 -> " << bc.number() << "\n";
+        bc.recompressChainData([](unsigned _done, unsigned _total) {
+            cout << "Rewritten " << _done << " of " << _total << " blocks\r" << flush;
+        });
+        cout << "\n";
+        return AlethErrors::Success;
+    }
+
     dev::WebThreeDirect web3(WebThreeDirect::composeClientVersion("aleth"), db::databasePath(),
         snapshotPath, chainParams, withExisting, netPrefs, &nodesState, testingMode);
 
@@ -923,6 +966,8 @@ int main(int argc, char** argv)
     c.setAuthor(author);
     if (networkID != NoNetworkID)
         c.setNetworkId(networkID);
+    if (fastSync)
+        c.enableFastSync();
 
     auto renderFullAddress = [&](Address const& _a) -> std::string
     {
@@ -942,6 +987,7 @@ int main(int argc, char** argv)
 
     unique_ptr<rpc::SessionManager> sessionManager;
     unique_ptr<SimpleAccountHolder> accountHolder;
+    unique_ptr<rpc::Subscriptions> subscriptions;
     unique_ptr<ModularServer<>> jsonrpcIpcServer;
 
 
@@ -997,7 +1043,9 @@ int main(int argc, char** argv)
             new rpc::Debug(*web3.ethereum()),
             testEth
         ));
+        subscriptions.reset(new rpc::Subscriptions(*web3.ethereum()));
         auto ipcConnector = new IpcServer("geth");
+        ipcConnector->setSubscriptions(subscriptions.get());
         jsonrpcIpcServer->addConnector(ipcConnector);
         ipcConnector->StartListening();
 
@@ -1009,6 +1057,21 @@ int main(int argc, char** argv)
         cout << "JSONRPC Admin Session Key: " << jsonAdmin << "\n";
     }
 
+    unique_ptr<MetricsServer> metricsServer;
+    if (vm.count("metrics-port"))
+    {
+        try
+        {
+            metricsServer.reset(new MetricsServer(vm["metrics-port"].as<unsigned short>(),
+                [&c] { return rpc::prometheusMetrics(c); }));
+        }
+        catch (boost::system::system_error const& _e)
+        {
+            cerr << "Failed to start the metrics server: " << _e.what() << "\n";
+            return AlethErrors::NetworkStartFailure;
+        }
+    }
+
     if (web3.isNetworkStarted())
     {
         for (auto const& p: preferredNodes)
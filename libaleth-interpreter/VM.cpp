@@ -5,6 +5,10 @@
 #include "VM.h"
 
 #include <aleth/version.h>
+#include <libdevcore/ObjectPool.h>
+
+#include <algorithm>
+#include <limits>
 
 namespace
 {
@@ -24,12 +28,30 @@ void delete_output(const evmc_result* result)
     delete[] result->output_data;
 }
 
+/// The most VM instances kept by a thread, and the largest buffer a kept instance holds on to.
+size_t const c_maxPooledVMs = 64;
+size_t const c_maxPooledBufferSize = 1024 * 1024;
+
+/// VM instances freed by finished frames, kept for the next ones on the same thread, so each
+/// call depth reuses the VM of the last frame there.
+thread_local dev::ObjectPool<dev::eth::VM> t_vms{c_maxPooledVMs, c_maxPooledBufferSize};
+
+struct RecycleVM
+{
+    void operator()(dev::eth::VM* _vm) const noexcept { t_vms.recycle(_vm); }
+};
+
+std::unique_ptr<dev::eth::VM, RecycleVM> takeVM()
+{
+    return std::unique_ptr<dev::eth::VM, RecycleVM>{t_vms.take()};
+}
+
 evmc_result execute(evmc_vm* _instance, const evmc_host_interface* _host,
     evmc_host_context* _context, evmc_revision _rev, const evmc_message* _msg, uint8_t const* _code,
     size_t _codeSize) noexcept
 {
     (void)_instance;
-    std::unique_ptr<dev::eth::VM> vm{new dev::eth::VM};
+    auto const vm = takeVM();
 
     evmc_result result = {};
     dev::eth::owning_bytes_ref output;
@@ -156,18 +178,28 @@ uint64_t VM::decodeJumpvDest(const byte* const _code, uint64_t& _pc, byte _voff)
 
 
 //
-// set current SP to SP', adjust SP' per _removed and _added items
+// charge the static gas of the block starting at the PC and check its stack bounds
 //
-void VM::adjustStack(int _required, int _change)
+void VM::beginBlock()
 {
-    m_SP = m_SPP;
-
-    // adjust stack and check bounds
-    if (m_stackEnd < m_SP + _required)
-        throwBadStack(_required, _change);
-    m_SPP -= _change;
-    if (m_SPP < m_stack)
-        throwBadStack(_required, _change);
+    // Falling through from a block enters the next one. A jump enters the block at its
+    // destination, which is a JUMPDEST and so begins one.
+    if (m_block + 1 < m_blocks.size() && m_blocks[m_block + 1].begin == m_PC)
+        ++m_block;
+    else
+        m_block = std::lower_bound(m_blocks.begin(), m_blocks.end(), m_PC,
+                      [](BasicBlock const& _block, uint64_t _pc) { return _block.begin < _pc; }) -
+                  m_blocks.begin();
+    m_nextBlockPC = m_block + 1 < m_blocks.size() ? m_blocks[m_block + 1].begin :
+                                                    std::numeric_limits<uint64_t>::max();
+
+    BasicBlock const& block = m_blocks[m_block];
+    int64_t const size = m_stackEnd - m_SPP;
+    if (size < block.stackRequired || size + block.stackGrowth > VMSchedule::stackLimit)
+        throwBadStack(block.stackRequired, block.stackGrowth);
+    if (m_io_gas < block.gas)
+        throwOutOfGas();
+    m_io_gas -= block.gas;
 }
 
 uint64_t VM::gasForMem(intx::uint512 const& _size)
@@ -211,14 +243,20 @@ void VM::logGasMem()
     updateMem(memNeed(m_SP[0], m_SP[1]));
 }
 
+template <evmc_revision Revision>
 void VM::fetchInstruction()
 {
+    if (m_PC == m_nextBlockPC)
+        beginBlock();
+
+    // The stack bounds have been checked for the whole block.
     m_OP = Instruction(m_code[m_PC]);
-    auto const metric = (*m_metrics)[static_cast<size_t>(m_OP)];
-    adjustStack(metric.stack_height_required, metric.stack_height_change);
+    auto const metric = s_metrics[Revision][static_cast<size_t>(m_OP)];
+    m_SP = m_SPP;
+    m_SPP -= metric.stack_height_change;
 
     // FEES...
-    m_runGas = metric.gas_cost;
+    m_runGas = s_chargedOnEntry[static_cast<size_t>(m_OP)] ? 0 : metric.gas_cost;
     m_newMemSize = m_mem.size();
     m_copyMemSize = 0;
 }
@@ -242,12 +280,25 @@ owning_bytes_ref VM::exec(const evmc_host_interface* _host, evmc_host_context* _
     m_context = _context;
     m_rev = _rev;
     m_metrics = &s_metrics[m_rev];
+    m_interpret = s_interpreters[m_rev];
     m_message = _msg;
     m_io_gas = uint64_t(_msg->gas);
     m_PC = 0;
     m_pCode = _code;
     m_codeSize = _codeSize;
 
+    // The VM may have run another frame before, whose buffers are reused without their contents.
+    m_tx_context = boost::none;
+    m_nSteps = 0;
+    m_mem.clear();
+    m_returnData.clear();
+    m_pool.clear();
+    m_jumpDests.clear();
+    m_beginSubs.clear();
+    m_SP = m_SPP = m_stackEnd;
+    m_block = 0;
+    m_nextBlockPC = 0;
+
     // trampoline to minimize depth of call stack when calling out
     m_bounce = &VM::initEntry;
     do
@@ -257,9 +308,41 @@ owning_bytes_ref VM::exec(const evmc_host_interface* _host, evmc_host_context* _
     return std::move(m_output);
 }
 
+void VM::recycle(size_t _maxBufferSize)
+{
+    m_host = nullptr;
+    m_context = nullptr;
+    m_message = nullptr;
+    m_output = {};
+
+    if (m_mem.capacity() > _maxBufferSize)
+        bytes().swap(m_mem);
+    if (m_code.capacity() > _maxBufferSize)
+        bytes().swap(m_code);
+    if (m_returnData.capacity() > _maxBufferSize)
+        bytes().swap(m_returnData);
+    if (m_pool.capacity() * sizeof(intx::uint256) > _maxBufferSize)
+        std::vector<intx::uint256>().swap(m_pool);
+    if (m_jumpDests.capacity() * sizeof(uint64_t) > _maxBufferSize)
+        std::vector<uint64_t>().swap(m_jumpDests);
+    if (m_blocks.capacity() * sizeof(BasicBlock) > _maxBufferSize)
+        std::vector<BasicBlock>().swap(m_blocks);
+}
+
+template <size_t... _revisions>
+std::array<VM::MemFnPtr, sizeof...(_revisions)> VM::makeInterpreters(
+    std::index_sequence<_revisions...>)
+{
+    return {{&VM::interpretCases<static_cast<evmc_revision>(_revisions)>...}};
+}
+
+std::array<VM::MemFnPtr, EVMC_MAX_REVISION + 1> const VM::s_interpreters =
+    VM::makeInterpreters(std::make_index_sequence<EVMC_MAX_REVISION + 1>{});
+
 //
 // main interpreter loop and switch
 //
+template <evmc_revision Revision>
 void VM::interpretCases()
 {
     INIT_CASES
@@ -272,7 +355,7 @@ void VM::interpretCases()
         CASE(CREATE2)
         {
             ON_OP();
-            if (m_rev < EVMC_CONSTANTINOPLE)
+            if (Revision < EVMC_CONSTANTINOPLE)
                 throwBadInstruction();
             if (m_message->flags & EVMC_STATIC)
                 throwDisallowedStateChange();
@@ -297,9 +380,9 @@ void VM::interpretCases()
         CASE(CALLCODE)
         {
             ON_OP();
-            if (m_OP == Instruction::DELEGATECALL && m_rev < EVMC_HOMESTEAD)
+            if (m_OP == Instruction::DELEGATECALL && Revision < EVMC_HOMESTEAD)
                 throwBadInstruction();
-            if (m_OP == Instruction::STATICCALL && m_rev < EVMC_BYZANTIUM)
+            if (m_OP == Instruction::STATICCALL && Revision < EVMC_BYZANTIUM)
                 throwBadInstruction();
             if (m_OP == Instruction::CALL && m_message->flags & EVMC_STATIC && m_SP[2] != 0)
                 throwDisallowedStateChange();
@@ -316,7 +399,7 @@ void VM::interpretCases()
 
             uint64_t b = (uint64_t)m_SP[0];
             uint64_t s = (uint64_t)m_SP[1];
-            m_output = owning_bytes_ref{std::move(m_mem), b, s};
+            m_output = copyMemory(m_mem, b, s);
             m_bounce = 0;
         }
         BREAK
@@ -324,7 +407,7 @@ void VM::interpretCases()
         CASE(REVERT)
         {
             // Pre-byzantium
-            if (m_rev < EVMC_BYZANTIUM)
+            if (Revision < EVMC_BYZANTIUM)
                 throwBadInstruction();
 
             ON_OP();
@@ -334,8 +417,7 @@ void VM::interpretCases()
 
             uint64_t b = (uint64_t)m_SP[0];
             uint64_t s = (uint64_t)m_SP[1];
-            owning_bytes_ref output{std::move(m_mem), b, s};
-            throwRevertInstruction(std::move(output));
+            throwRevertInstruction(copyMemory(m_mem, b, s));
         }
         BREAK;
 
@@ -352,9 +434,9 @@ void VM::interpretCases()
             // Starting with EIP150 (Tangerine Whistle), self-destructs need to pay account creation
             // gas. Starting with EIP158 (Spurious Dragon),
             // 0-value selfdestructs don't have to pay this charge.
-            if (m_rev >= EVMC_TANGERINE_WHISTLE)
+            if (Revision >= EVMC_TANGERINE_WHISTLE)
             {
-                if (m_rev == EVMC_TANGERINE_WHISTLE ||
+                if (Revision == EVMC_TANGERINE_WHISTLE ||
                     fromEvmC(m_host->get_balance(m_context, &m_message->destination)) > 0)
                 {
                     if (!m_host->account_exists(m_context, &destination))
@@ -537,7 +619,7 @@ void VM::interpretCases()
         CASE(EXP)
         {
             intx::uint256 expon = m_SP[1];
-            const int64_t byteCost = m_rev >= EVMC_SPURIOUS_DRAGON ? 50 : 10;
+            const int64_t byteCost = Revision >= EVMC_SPURIOUS_DRAGON ? 50 : 10;
             m_runGas = toInt63(VMSchedule::stepGas5 + byteCost * intx::count_significant_words<uint8_t>(expon));
             ON_OP();
             updateIOGas();
@@ -723,7 +805,7 @@ void VM::interpretCases()
         CASE(SHL)
         {
             // Pre-constantinople
-            if (m_rev < EVMC_CONSTANTINOPLE)
+            if (Revision < EVMC_CONSTANTINOPLE)
                 throwBadInstruction();
 
             ON_OP();
@@ -739,7 +821,7 @@ void VM::interpretCases()
         CASE(SHR)
         {
             // Pre-constantinople
-            if (m_rev < EVMC_CONSTANTINOPLE)
+            if (Revision < EVMC_CONSTANTINOPLE)
                 throwBadInstruction();
 
             ON_OP();
@@ -755,7 +837,7 @@ void VM::interpretCases()
         CASE(SAR)
         {
             // Pre-constantinople
-            if (m_rev < EVMC_CONSTANTINOPLE)
+            if (Revision < EVMC_CONSTANTINOPLE)
                 throwBadInstruction();
 
             ON_OP();
@@ -956,7 +1038,7 @@ void VM::interpretCases()
 
         CASE(RETURNDATASIZE)
         {
-            if (m_rev < EVMC_BYZANTIUM)
+            if (Revision < EVMC_BYZANTIUM)
                 throwBadInstruction();
 
             ON_OP();
@@ -1001,7 +1083,7 @@ void VM::interpretCases()
         CASE(RETURNDATACOPY)
         {
             ON_OP();
-            if (m_rev < EVMC_BYZANTIUM)
+            if (Revision < EVMC_BYZANTIUM)
                 throwBadInstruction();
             intx::uint512 const endOfAccess = intx::uint512(m_SP[1]) + intx::uint512(m_SP[2]);
             if (m_returnData.size() < endOfAccess)
@@ -1018,7 +1100,7 @@ void VM::interpretCases()
         CASE(EXTCODEHASH)
         {
             ON_OP();
-            if (m_rev < EVMC_CONSTANTINOPLE)
+            if (Revision < EVMC_CONSTANTINOPLE)
                 throwBadInstruction();
 
             updateIOGas();
@@ -1140,7 +1222,7 @@ void VM::interpretCases()
         {
             ON_OP();
 
-            if (m_rev < EVMC_ISTANBUL)
+            if (Revision < EVMC_ISTANBUL)
                 throwBadInstruction();
 
             updateIOGas();
@@ -1153,7 +1235,7 @@ void VM::interpretCases()
         {
             ON_OP();
 
-            if (m_rev < EVMC_ISTANBUL)
+            if (Revision < EVMC_ISTANBUL)
                 throwBadInstruction();
 
             updateIOGas();
@@ -1251,7 +1333,7 @@ void VM::interpretCases()
         {
             ON_OP();
             updateIOGas();
-            m_PC = verifyJumpDest(m_SP[0]);
+            m_PC = m_nextBlockPC = verifyJumpDest(m_SP[0]);
         }
         CONTINUE
 
@@ -1260,7 +1342,7 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
             if (m_SP[1])
-                m_PC = verifyJumpDest(m_SP[0]);
+                m_PC = m_nextBlockPC = verifyJumpDest(m_SP[0]);
             else
                 ++m_PC;
         }
@@ -1272,7 +1354,7 @@ void VM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_PC = uint64_t(m_SP[0]);
+            m_PC = m_nextBlockPC = uint64_t(m_SP[0]);
 #else
             throwBadInstruction();
 #endif
@@ -1286,7 +1368,7 @@ void VM::interpretCases()
             updateIOGas();
 
             if (m_SP[1])
-                m_PC = uint64_t(m_SP[0]);
+                m_PC = m_nextBlockPC = uint64_t(m_SP[0]);
             else
                 ++m_PC;
 #else
@@ -1368,7 +1450,7 @@ void VM::interpretCases()
             if (m_message->flags & EVMC_STATIC)
                 throwDisallowedStateChange();
 
-            if (m_rev >= EVMC_ISTANBUL && m_io_gas <= VMSchedule::callStipend)
+            if (Revision >= EVMC_ISTANBUL && m_io_gas <= VMSchedule::callStipend)
                 throwOutOfGas();
 
             auto const key = intx::be::store<evmc_uint256be>(m_SP[0]);
@@ -1387,8 +1469,8 @@ void VM::interpretCases()
                 break;
             case EVMC_STORAGE_UNCHANGED:
             case EVMC_STORAGE_MODIFIED_AGAIN:
-                m_runGas = (m_rev == EVMC_CONSTANTINOPLE || m_rev >= EVMC_ISTANBUL) ?
-                               (*m_metrics)[OP_SLOAD].gas_cost :
+                m_runGas = (Revision == EVMC_CONSTANTINOPLE || Revision >= EVMC_ISTANBUL) ?
+                               s_metrics[Revision][OP_SLOAD].gas_cost :
                                VMSchedule::sstoreResetGas;
                 break;
             }
@@ -1426,7 +1508,6 @@ void VM::interpretCases()
 
         CASE(JUMPDEST)
         {
-            m_runGas = VMSchedule::jumpdestGas;
             ON_OP();
             updateIOGas();
         }
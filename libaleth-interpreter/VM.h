@@ -12,6 +12,7 @@
 #include <evmc/instructions.h>
 
 #include <boost/optional.hpp>
+#include <utility>
 
 namespace dev
 {
@@ -56,6 +57,10 @@ public:
     owning_bytes_ref exec(const evmc_host_interface* _host, evmc_host_context* _context,
         evmc_revision _rev, const evmc_message* _msg, uint8_t const* _code, size_t _codeSize);
 
+    /// Drops what the last frame left behind and frees the buffers that grew beyond
+    /// @a _maxBufferSize bytes, so that the VM can be kept for another frame.
+    void recycle(size_t _maxBufferSize);
+
     uint64_t m_io_gas = 0;
 private:
     const evmc_host_interface* m_host = nullptr;
@@ -65,9 +70,15 @@ private:
     evmc_message const* m_message = nullptr;
     boost::optional<evmc_tx_context> m_tx_context;
     static std::array<std::array<evmc_instruction_metrics, 256>, EVMC_MAX_REVISION + 1> s_metrics;
+    /// Instructions whose static gas cost is charged on entry of their basic block, rather than
+    /// when they run.
+    static std::array<bool, 256> s_chargedOnEntry;
     void copyCode(int);
     typedef void (VM::*MemFnPtr)();
     MemFnPtr m_bounce = nullptr;
+    /// interpretCases() specialised for the revision of the current execution.
+    MemFnPtr m_interpret = nullptr;
+    static std::array<MemFnPtr, EVMC_MAX_REVISION + 1> const s_interpreters;
     uint64_t m_nSteps = 0;
 
     // return bytes
@@ -103,12 +114,33 @@ private:
     uint64_t m_newMemSize = 0;
     uint64_t m_copyMemSize = 0;
 
+    /// Run of instructions entered only at its first one and left only after its last one, so
+    /// that their static gas cost and stack bounds can be checked together when it is entered.
+    /// Instructions that read the gas left or end the run of code end a block.
+    struct BasicBlock
+    {
+        uint64_t begin;     ///< PC of the first instruction
+        uint64_t gas;       ///< Static gas cost of the instructions charged on entry
+        int stackRequired;  ///< Stack items needed on entry
+        int stackGrowth;    ///< Most stack items added above the size on entry
+    };
+    std::vector<BasicBlock> m_blocks;
+    size_t m_block = 0;          // current block
+    uint64_t m_nextBlockPC = 0;  // PC at which another block is entered
+
     // initialize interpreter
     void initEntry();
     void optimize();
+    void analyzeBlocks();
+    void beginBlock();
 
-    // interpreter loop & switch
+    // interpreter loop & switch, instantiated per revision so that the checks of the revision
+    // are resolved at compile time
+    template <evmc_revision Revision>
     void interpretCases();
+    template <size_t... _revisions>
+    static std::array<MemFnPtr, sizeof...(_revisions)> makeInterpreters(
+        std::index_sequence<_revisions...>);
 
     // interpreter cases that call out
     void caseCreate();
@@ -134,12 +166,12 @@ private:
     int64_t verifyJumpDest(intx::uint256 const& _dest, bool _throw = true);
 
     void onOperation() {}
-    void adjustStack(int _removed, int _added);
     uint64_t gasForMem(intx::uint512 const& _size);
     void updateIOGas();
     void updateGas();
     void updateMem(uint64_t _newMem);
     void logGasMem();
+    template <evmc_revision Revision>
     void fetchInstruction();
     
     uint64_t decodeJumpDest(const byte* const _code, uint64_t& _pc);
@@ -50,7 +50,7 @@ void VM::throwDisallowedStateChange()
     BOOST_THROW_EXCEPTION(DisallowedStateChange());
 }
 
-// throwBadStack is called from fetchInstruction() -> adjustStack()
+// throwBadStack is called from fetchInstruction() -> beginBlock()
 // its the only exception that can happen before ON_OP() log is done for an opcode case in VM.cpp
 // so the call to m_onFail is needed here
 void VM::throwBadStack(int _required, int _change)
@@ -99,7 +99,7 @@ int64_t VM::verifyJumpDest(intx::uint256 const& _dest, bool _throw)
 
 void VM::caseCreate()
 {
-    m_bounce = &VM::interpretCases;
+    m_bounce = m_interpret;
     m_runGas = VMSchedule::createGas;
 
     // Collect arguments.
@@ -161,7 +161,7 @@ void VM::caseCreate()
 
 void VM::caseCall()
 {
-    m_bounce = &VM::interpretCases;
+    m_bounce = m_interpret;
 
     evmc_message msg = {};
 
@@ -111,11 +111,11 @@ namespace eth
 #if EVM_SWITCH_DISPATCH
 
 #define INIT_CASES
-#define DO_CASES            \
-    for (;;)                \
-    {                       \
-        fetchInstruction(); \
-        switch (m_OP)       \
+#define DO_CASES                      \
+    for (;;)                          \
+    {                                 \
+        fetchInstruction<Revision>(); \
+        switch (m_OP)                 \
         {
 #define CASE(name) case Instruction::name:
 #define NEXT \
@@ -397,17 +397,17 @@ namespace eth
         &&SELFDESTRUCT,                         \
     };
 
-#define DO_CASES        \
-    fetchInstruction(); \
+#define DO_CASES                  \
+    fetchInstruction<Revision>(); \
     goto* jumpTable[(int)m_OP];
 #define CASE(name) \
     name:
-#define NEXT            \
-    ++m_PC;             \
-    fetchInstruction(); \
+#define NEXT                      \
+    ++m_PC;                       \
+    fetchInstruction<Revision>(); \
     goto* jumpTable[(int)m_OP];
-#define CONTINUE        \
-    fetchInstruction(); \
+#define CONTINUE                  \
+    fetchInstruction<Revision>(); \
     goto* jumpTable[(int)m_OP];
 #define BREAK return;
 #define DEFAULT
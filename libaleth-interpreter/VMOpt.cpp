@@ -7,7 +7,69 @@ namespace dev
 {
 namespace eth
 {
+namespace
+{
+/// @returns whether the instruction works out its whole gas cost when it runs, so that none of it
+/// can be charged on entry of its basic block.
+bool chargesOwnGas(Instruction _op)
+{
+    switch (_op)
+    {
+    case Instruction::SHA3:
+    case Instruction::EXP:
+    case Instruction::BLOCKHASH:
+    case Instruction::SSTORE:
+    case Instruction::LOG0:
+    case Instruction::LOG1:
+    case Instruction::LOG2:
+    case Instruction::LOG3:
+    case Instruction::LOG4:
+    case Instruction::CREATE:
+    case Instruction::CREATE2:
+    case Instruction::CALL:
+    case Instruction::CALLCODE:
+    case Instruction::DELEGATECALL:
+    case Instruction::STATICCALL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// @returns whether the instruction ends a basic block: it doesn't go on to the next
+/// instruction, or it reads the gas left, which must not include the cost of the instructions
+/// after it.
+bool endsBlock(Instruction _op)
+{
+    switch (_op)
+    {
+    case Instruction::STOP:
+    case Instruction::JUMP:
+    case Instruction::JUMPI:
+    case Instruction::JUMPC:
+    case Instruction::JUMPCI:
+    case Instruction::RETURN:
+    case Instruction::REVERT:
+    case Instruction::SELFDESTRUCT:
+    case Instruction::INVALID:
+    case Instruction::UNDEFINED:
+    case Instruction::GAS:
+    case Instruction::SSTORE:
+    case Instruction::CREATE:
+    case Instruction::CREATE2:
+    case Instruction::CALL:
+    case Instruction::CALLCODE:
+    case Instruction::DELEGATECALL:
+    case Instruction::STATICCALL:
+        return true;
+    default:
+        return false;
+    }
+}
+}  // namespace
+
 std::array<std::array<evmc_instruction_metrics, 256>, EVMC_MAX_REVISION + 1> VM::s_metrics;
+std::array<bool, 256> VM::s_chargedOnEntry;
 
 bool VM::initMetrics()
 {
@@ -25,6 +87,8 @@ bool VM::initMetrics()
         metrics[uint8_t(Instruction::JUMPC)] = metrics[uint8_t(Instruction::JUMP)];
         metrics[uint8_t(Instruction::JUMPCI)] = s_metrics[revision][uint8_t(Instruction::JUMPI)];
     };
+    for (size_t op = 0; op < s_chargedOnEntry.size(); ++op)
+        s_chargedOnEntry[op] = !chargesOwnGas(Instruction(op));
     return true;
 }
 
@@ -76,7 +140,9 @@ void VM::optimize()
             pc += (byte)op - (byte)Instruction::PUSH1 + 1;
         }
     }
-    
+
+    analyzeBlocks();
+
 #ifdef EVM_DO_FIRST_PASS_OPTIMIZATION
     
     TRACE_STR(1, "Do first pass optimizations")
@@ -154,12 +220,59 @@ void VM::optimize()
 }
 
 
+//
+// Split the code into basic blocks for beginBlock() to check on entry.
+//
+// Checking the static gas and the stack of a whole block on entry doesn't change whether it runs
+// to its end: it does if and only if the gas and the stack were enough for every instruction in
+// it. When it doesn't, the failure may come earlier or be another exception, but the frame loses
+// all its gas and effects all the same. Only the last instruction of a block can see the gas left
+// or leave it with gas to spare, so these see the same amount as when charging per instruction.
+//
+void VM::analyzeBlocks()
+{
+    TRACE_STR(1, "Split code into basic blocks")
+    size_t const nBytes = m_codeSize;
+    m_blocks.clear();
+    m_blocks.push_back({0, 0, 0, 0});
+    int change = 0;
+    size_t pc = 0;
+    for (; pc < nBytes; ++pc)
+    {
+        Instruction const op = Instruction(m_code[pc]);
+        if (op == Instruction::JUMPDEST && pc != m_blocks.back().begin)
+        {
+            m_blocks.push_back({pc, 0, 0, 0});
+            change = 0;
+        }
+
+        BasicBlock& block = m_blocks.back();
+        auto const& metric = (*m_metrics)[static_cast<size_t>(op)];
+        if (s_chargedOnEntry[static_cast<size_t>(op)] && metric.gas_cost > 0)
+            block.gas += metric.gas_cost;
+        block.stackRequired = std::max(block.stackRequired, metric.stack_height_required - change);
+        change += metric.stack_height_change;
+        block.stackGrowth = std::max(block.stackGrowth, change);
+
+        if ((byte)Instruction::PUSH1 <= (byte)op && (byte)op <= (byte)Instruction::PUSH32)
+            pc += (byte)op - (byte)Instruction::PUSH1 + 1;
+        if (endsBlock(op))
+        {
+            m_blocks.push_back({pc + 1, 0, 0, 0});
+            change = 0;
+        }
+    }
+    // Running off the end of the code runs the STOP padding it, in a block of its own.
+    if (m_blocks.back().begin < pc)
+        m_blocks.push_back({pc, 0, 0, 0});
+}
+
 //
 // Init interpreter on entry.
 //
 void VM::initEntry()
 {
-    m_bounce = &VM::interpretCases;
+    m_bounce = m_interpret;
     optimize();
 }
 }
@@ -0,0 +1,89 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "Arena.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+using namespace dev;
+
+size_t const Arena::c_firstBlockSize;
+size_t const Arena::c_maxSize;
+
+Arena::~Arena()
+{
+    assert(m_live == 0);
+    for (Block const& block : m_blocks)
+        ::operator delete(block.data);
+}
+
+void* Arena::allocate(size_t _size, size_t _alignment)
+{
+    // Blocks come from operator new, so they are aligned for any fundamental type.
+    assert(_alignment <= alignof(max_align_t) && (_alignment & (_alignment - 1)) == 0);
+    if (!m_blocks.empty())
+    {
+        size_t const start = (m_used + _alignment - 1) & ~(_alignment - 1);
+        if (start + _size <= m_blocks.back().size)
+        {
+            m_used = start + _size;
+            ++m_live;
+            return m_blocks.back().data + start;
+        }
+    }
+
+    if (m_capacity >= c_maxSize)
+        return ::operator new(_size);
+
+    size_t const next = m_blocks.empty() ? c_firstBlockSize : m_blocks.back().size * 2;
+    size_t const size = max(_size, min(next, c_maxSize - m_capacity));
+    m_blocks.push_back({static_cast<char*>(::operator new(size)), size});
+    m_capacity += size;
+    m_used = _size;
+    ++m_live;
+    return m_blocks.back().data;
+}
+
+void Arena::deallocate(void* _p) noexcept
+{
+    if (owns(_p))
+    {
+        assert(m_live > 0);
+        --m_live;
+    }
+    else
+        ::operator delete(_p);
+}
+
+bool Arena::release() noexcept
+{
+    if (m_live)
+        return false;
+    if (m_blocks.size() > 1)
+    {
+        // The last block is not the largest when it was cut to c_maxSize, or when an earlier one
+        // was made for a large allocation.
+        auto const largest = max_element(m_blocks.begin(), m_blocks.end(),
+            [](Block const& _a, Block const& _b) { return _a.size < _b.size; });
+        swap(*largest, m_blocks.back());
+        for (auto block = m_blocks.begin(); block + 1 != m_blocks.end(); ++block)
+            ::operator delete(block->data);
+        m_blocks.erase(m_blocks.begin(), m_blocks.end() - 1);
+        m_capacity = m_blocks.back().size;
+    }
+    m_used = 0;
+    return true;
+}
+
+bool Arena::owns(void* _p) const noexcept
+{
+    // The latest blocks are the largest and the most likely to hold it, and there are few.
+    char const* p = static_cast<char const*>(_p);
+    for (auto block = m_blocks.rbegin(); block != m_blocks.rend(); ++block)
+        if (less_equal<char const*>()(block->data, p) && less<char const*>()(p, block->data + block->size))
+            return true;
+    return false;
+}
@@ -0,0 +1,119 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Monotonic arena for short-lived containers, and an allocator to put them in it.
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace dev
+{
+/**
+ * @brief Memory handed out by bumping a pointer through large blocks, and taken back all at once.
+ *
+ * Freeing a single allocation only counts it as freed; its memory is reused once everything
+ * allocated from the arena has been freed and release() is called. This suits containers that
+ * are filled while something runs and emptied when it is done, like the account cache of State.
+ * Once the blocks add up to c_maxSize the arena leaves further allocations to the heap, so that
+ * memory held by something that is never emptied can't grow without bounds.
+ * @threadsafe No.
+ */
+class Arena
+{
+public:
+    static size_t const c_firstBlockSize = 64 * 1024;
+    static size_t const c_maxSize = 64 * 1024 * 1024;
+
+    Arena() = default;
+    Arena(Arena const&) = delete;
+    Arena& operator=(Arena const&) = delete;
+    ~Arena();
+
+    void* allocate(size_t _size, size_t _alignment);
+    void deallocate(void* _p) noexcept;
+
+    /// Makes all the memory of the arena available again if nothing allocated from it is still in
+    /// use, keeping only the largest block. @returns whether it did.
+    bool release() noexcept;
+
+    /// @returns the number of allocations from the arena not freed yet.
+    size_t live() const noexcept { return m_live; }
+    /// @returns the total size of the blocks held.
+    size_t capacity() const noexcept { return m_capacity; }
+
+private:
+    struct Block
+    {
+        char* data;
+        size_t size;
+    };
+
+    bool owns(void* _p) const noexcept;
+
+    std::vector<Block> m_blocks;
+    /// Offset of the first free byte in the last block.
+    size_t m_used = 0;
+    size_t m_capacity = 0;
+    size_t m_live = 0;
+};
+
+/// Allocator taking memory from an Arena, or from the heap if it has none. Copies of a container
+/// using it take their memory from the heap, since they may outlive the arena's contents.
+template <class T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+
+    ArenaAllocator() noexcept = default;
+    explicit ArenaAllocator(Arena* _arena) noexcept: m_arena(_arena) {}
+    template <class U>
+    ArenaAllocator(ArenaAllocator<U> const& _other) noexcept: m_arena(_other.arena())
+    {}
+
+    T* allocate(size_t _n)
+    {
+        if (!m_arena)
+            return static_cast<T*>(::operator new(_n * sizeof(T)));
+        return static_cast<T*>(m_arena->allocate(_n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* _p, size_t) noexcept
+    {
+        if (m_arena)
+            m_arena->deallocate(_p);
+        else
+            ::operator delete(_p);
+    }
+
+    ArenaAllocator select_on_container_copy_construction() const noexcept
+    {
+        return ArenaAllocator();
+    }
+
+    Arena* arena() const noexcept { return m_arena; }
+
+private:
+    Arena* m_arena = nullptr;
+};
+
+template <class T, class U>
+bool operator==(ArenaAllocator<T> const& _a, ArenaAllocator<U> const& _b) noexcept
+{
+    return _a.arena() == _b.arena();
+}
+
+template <class T, class U>
+bool operator!=(ArenaAllocator<T> const& _a, ArenaAllocator<U> const& _b) noexcept
+{
+    return !(_a == _b);
+}
+}  // namespace dev
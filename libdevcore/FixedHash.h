@@ -160,7 +160,7 @@ public:
         return (*this |= _h.template bloomPart<P, N>());
     }
 
-    template <unsigned P, unsigned M> inline bool containsBloom(FixedHash<M> const& _h)
+    template <unsigned P, unsigned M> inline bool containsBloom(FixedHash<M> const& _h) const
     {
         return contains(_h.template bloomPart<P, N>());
     }
@@ -0,0 +1,63 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "Histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dev
+{
+constexpr unsigned Histogram::c_bucketsPerOctave;
+
+Histogram::Histogram(double _min, unsigned _octaves)
+  : m_min(_min), m_buckets(_octaves * c_bucketsPerOctave)
+{}
+
+void Histogram::record(double _value)
+{
+    size_t bucket = 0;
+    if (_value >= m_min)
+        bucket = std::min<size_t>(
+            std::log2(_value / m_min) * c_bucketsPerOctave, m_buckets.size() - 1);
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+
+    double sum = m_sum.load(std::memory_order_relaxed);
+    while (!m_sum.compare_exchange_weak(sum, sum + _value, std::memory_order_relaxed))
+    {
+    }
+}
+
+double Histogram::mean() const
+{
+    uint64_t const n = count();
+    return n ? sum() / n : 0;
+}
+
+double Histogram::quantile(double _q) const
+{
+    // Count the buckets themselves, the total may be ahead of them while a value is recorded.
+    uint64_t total = 0;
+    for (auto const& bucket : m_buckets)
+        total += bucket.load(std::memory_order_relaxed);
+    if (!total)
+        return 0;
+
+    uint64_t const rank = std::max<uint64_t>(std::ceil(_q * total), 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < m_buckets.size(); ++i)
+    {
+        seen += m_buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+            return upperBound(i);
+    }
+    return upperBound(m_buckets.size() - 1);
+}
+
+double Histogram::upperBound(size_t _bucket) const
+{
+    return m_min * std::exp2(double(_bucket + 1) / c_bucketsPerOctave);
+}
+}  // namespace dev
@@ -0,0 +1,45 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Lock-free histogram for statistics recorded on hot paths and read from other threads.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dev
+{
+/// Histogram of positive values in logarithmic buckets, c_bucketsPerOctave per doubling, so
+/// quantiles are accurate to within 19%. Recording and reading never block each other.
+class Histogram
+{
+public:
+    static constexpr unsigned c_bucketsPerOctave = 4;
+
+    /// Values below @a _min, and from _min * 2^_octaves up, are counted in the first and the
+    /// last bucket respectively.
+    Histogram(double _min, unsigned _octaves);
+
+    void record(double _value);
+
+    uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+    double sum() const { return m_sum.load(std::memory_order_relaxed); }
+    double mean() const;
+
+    /// @returns the upper bound of the bucket holding the value of rank ceil(_q * count), or 0 if
+    /// nothing was recorded.
+    double quantile(double _q) const;
+
+private:
+    double upperBound(size_t _bucket) const;
+
+    double const m_min;
+    std::vector<std::atomic<uint64_t>> m_buckets;
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<double> m_sum{0};
+};
+}  // namespace dev
@@ -0,0 +1,65 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+namespace dev
+{
+/**
+ * @brief Objects given back by their users, kept to be handed out again instead of new ones.
+ *
+ * Meant to be thread_local: it's not thread-safe. Objects are handed out in the reverse order
+ * they were given back, so users that nest like call frames each get back the object of the last
+ * user at the same depth.
+ *
+ * T must have `void recycle(size_t _maxBufferSize)`, which resets it for its next user and frees
+ * its buffers larger than @a _maxBufferSize, so that the pool doesn't keep the memory of a rare
+ * user that needed a lot.
+ */
+template <class T>
+class ObjectPool
+{
+public:
+    ObjectPool(size_t _maxPooled, size_t _maxBufferSize)
+      : m_maxPooled(_maxPooled), m_maxBufferSize(_maxBufferSize)
+    {}
+
+    /// @returns a pooled object, or a new one if there is none. It must be given back with
+    /// recycle().
+    T* take()
+    {
+        if (m_pooled.empty())
+        {
+            m_pooled.reserve(m_maxPooled);
+            return new T;
+        }
+        T* ret = m_pooled.back().release();
+        m_pooled.pop_back();
+        return ret;
+    }
+
+    /// Keeps @a _object for the next take(), or deletes it if the pool is full.
+    void recycle(T* _object) noexcept
+    {
+        if (m_pooled.size() >= m_maxPooled)
+        {
+            delete _object;
+            return;
+        }
+        _object->recycle(m_maxBufferSize);
+        m_pooled.emplace_back(_object);
+    }
+
+    size_t size() const { return m_pooled.size(); }
+
+private:
+    size_t const m_maxPooled;
+    size_t const m_maxBufferSize;
+    std::vector<std::unique_ptr<T>> m_pooled;
+};
+
+}  // namespace dev
@@ -0,0 +1,258 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "ModExp.h"
+
+#include <libdevcore/CommonData.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+// Montgomery multiplication follows the CIOS method from C. K. Koc, T. Acar, B. S. Kaliski,
+// "Analyzing and Comparing Montgomery Multiplication Algorithms", IEEE Micro 16(3), 1996.
+
+namespace dev
+{
+namespace crypto
+{
+namespace
+{
+using Limb = uint64_t;
+
+/// Number of 64-bit limbs, least significant first.
+template <size_t N>
+using Number = std::array<Limb, N>;
+
+/// @returns the high half of _a * _b + _c + _d and stores the low half in @a o_low.
+/// The sum cannot overflow 128 bits.
+inline Limb mulAdd(Limb _a, Limb _b, Limb _c, Limb _d, Limb& o_low)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 const r = static_cast<unsigned __int128>(_a) * _b + _c + _d;
+    o_low = static_cast<Limb>(r);
+    return static_cast<Limb>(r >> 64);
+#else
+    Limb const aLow = _a & 0xffffffff;
+    Limb const aHigh = _a >> 32;
+    Limb const bLow = _b & 0xffffffff;
+    Limb const bHigh = _b >> 32;
+
+    Limb const lowLow = aLow * bLow;
+    Limb const lowHigh = aLow * bHigh;
+    Limb const highLow = aHigh * bLow;
+    Limb const middle = (lowLow >> 32) + (lowHigh & 0xffffffff) + (highLow & 0xffffffff);
+
+    Limb low = (middle << 32) | (lowLow & 0xffffffff);
+    Limb high = aHigh * bHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+    low += _c;
+    high += low < _c;
+    low += _d;
+    high += low < _d;
+    o_low = low;
+    return high;
+#endif
+}
+
+bytesConstRef stripLeadingZeros(bytesConstRef _in)
+{
+    size_t zeros = 0;
+    while (zeros < _in.size() && _in[zeros] == 0)
+        ++zeros;
+    return _in.cropped(zeros);
+}
+
+/// @a _in must not have more than 8 * N bytes.
+template <size_t N>
+Number<N> load(bytesConstRef _in)
+{
+    Number<N> ret{};
+    size_t const size = _in.size();
+    for (size_t i = 0; i < size; ++i)
+        ret[i / 8] |= Limb(_in[size - 1 - i]) << (8 * (i % 8));
+    return ret;
+}
+
+template <size_t N>
+void store(Number<N> const& _n, bytesRef o_out)
+{
+    size_t const size = o_out.size();
+    for (size_t i = 0; i < size; ++i)
+        o_out[size - 1 - i] = i < 8 * N ? byte(_n[i / 8] >> (8 * (i % 8))) : 0;
+}
+
+template <size_t N>
+bool lessThan(Number<N> const& _a, Number<N> const& _b)
+{
+    for (size_t i = N; i-- > 0;)
+        if (_a[i] != _b[i])
+            return _a[i] < _b[i];
+    return false;
+}
+
+/// Subtracts modulo 2^(64 * N).
+template <size_t N>
+void subtract(Number<N>& io_a, Number<N> const& _b)
+{
+    Limb borrow = 0;
+    for (size_t i = 0; i < N; ++i)
+    {
+        Limb const a = io_a[i];
+        Limb const difference = a - _b[i];
+        io_a[i] = difference - borrow;
+        borrow = (a < _b[i]) | (difference < borrow);
+    }
+}
+
+/// Arithmetic modulo an odd number m > 1 in the Montgomery domain, where x is represented as
+/// x * R mod m with R = 2^(64 * N).
+template <size_t N>
+class Montgomery
+{
+public:
+    explicit Montgomery(Number<N> const& _mod) : m_mod(_mod)
+    {
+        // Each Newton iteration doubles the number of correct low bits of m^-1, and m is its own
+        // inverse modulo 8.
+        Limb inverse = _mod[0];
+        for (unsigned i = 0; i < 5; ++i)
+            inverse *= 2 - _mod[0] * inverse;
+        m_negativeInverse = 0 - inverse;
+
+        m_r2[0] = 1;
+        for (size_t i = 0; i < 2 * 64 * N; ++i)
+            doubleMod(m_r2);
+    }
+
+    /// @returns _a * _b / R mod m, given _a * _b < R * m.
+    Number<N> mul(Number<N> const& _a, Number<N> const& _b) const
+    {
+        Limb t[N + 2] = {};
+        for (size_t i = 0; i < N; ++i)
+        {
+            Limb carry = 0;
+            for (size_t j = 0; j < N; ++j)
+                carry = mulAdd(_a[j], _b[i], t[j], carry, t[j]);
+            t[N] += carry;
+            t[N + 1] = t[N] < carry;
+
+            // Add the multiple of m that clears the lowest limb, then shift by one limb.
+            Limb const q = t[0] * m_negativeInverse;
+            Limb cleared;
+            carry = mulAdd(q, m_mod[0], t[0], 0, cleared);
+            for (size_t j = 1; j < N; ++j)
+                carry = mulAdd(q, m_mod[j], t[j], carry, t[j - 1]);
+            t[N - 1] = t[N] + carry;
+            t[N] = t[N + 1] + (t[N - 1] < carry);
+        }
+
+        Number<N> ret;
+        std::copy(t, t + N, ret.begin());
+        if (t[N] || !lessThan(ret, m_mod))
+            subtract(ret, m_mod);
+        return ret;
+    }
+
+    /// @returns _base ^ _exp mod m in the normal domain; @a _base must be less than R.
+    Number<N> pow(Number<N> const& _base, bytesConstRef _exp) const
+    {
+        // Fixed 4-bit window: the table holds _base^0 .. _base^15.
+        Number<N> one{};
+        one[0] = 1;
+        std::array<Number<N>, 16> table;
+        table[0] = mul(one, m_r2);
+        table[1] = mul(_base, m_r2);
+        for (size_t i = 2; i < table.size(); ++i)
+            table[i] = mul(table[i - 1], table[1]);
+
+        Number<N> ret = table[0];
+        bool started = false;
+        for (byte b : _exp)
+            for (int shift = 4; shift >= 0; shift -= 4)
+            {
+                if (started)
+                    for (unsigned i = 0; i < 4; ++i)
+                        ret = mul(ret, ret);
+                unsigned const window = (b >> shift) & 0xf;
+                if (window)
+                {
+                    ret = started ? mul(ret, table[window]) : table[window];
+                    started = true;
+                }
+            }
+        return mul(ret, one);
+    }
+
+private:
+    void doubleMod(Number<N>& io_x) const
+    {
+        Limb carry = 0;
+        for (size_t i = 0; i < N; ++i)
+        {
+            Limb const top = io_x[i] >> 63;
+            io_x[i] = (io_x[i] << 1) | carry;
+            carry = top;
+        }
+        if (carry || !lessThan(io_x, m_mod))
+            subtract(io_x, m_mod);
+    }
+
+    Number<N> m_mod;
+    Limb m_negativeInverse;  ///< -m^-1 mod 2^64
+    Number<N> m_r2{};        ///< R^2 mod m
+};
+
+template <size_t N>
+bool montgomeryModexp(bytesConstRef _base, bytesConstRef _exp, bytesConstRef _mod, bytesRef o_result)
+{
+    if (_base.size() > 8 * N)
+        return false;
+    Montgomery<N> const montgomery{load<N>(_mod)};
+    store(montgomery.pow(load<N>(_base), _exp), o_result);
+    return true;
+}
+}  // namespace
+
+void modexp(bytesConstRef _base, bytesConstRef _exp, bytesConstRef _mod, bytesRef o_result)
+{
+    if (!modexpMontgomery(_base, _exp, _mod, o_result))
+        modexpGeneric(_base, _exp, _mod, o_result);
+}
+
+bool modexpMontgomery(bytesConstRef _base, bytesConstRef _exp, bytesConstRef _mod, bytesRef o_result)
+{
+    bytesConstRef const mod = stripLeadingZeros(_mod);
+    bytesConstRef const base = stripLeadingZeros(_base);
+    if (mod.empty() || mod.size() > c_maxMontgomeryModulusSize || !(mod[mod.size() - 1] & 1))
+        return false;
+    assert(o_result.size() >= mod.size());
+
+    if (mod.size() == 1 && mod[0] == 1)
+    {
+        std::fill(o_result.begin(), o_result.end(), 0);
+        return true;
+    }
+
+    bytesConstRef const exp = stripLeadingZeros(_exp);
+    if (mod.size() <= 32)
+        return montgomeryModexp<4>(base, exp, mod, o_result);
+    if (mod.size() <= 64)
+        return montgomeryModexp<8>(base, exp, mod, o_result);
+    if (mod.size() <= 128)
+        return montgomeryModexp<16>(base, exp, mod, o_result);
+    if (mod.size() <= 256)
+        return montgomeryModexp<32>(base, exp, mod, o_result);
+    return montgomeryModexp<64>(base, exp, mod, o_result);
+}
+
+void modexpGeneric(bytesConstRef _base, bytesConstRef _exp, bytesConstRef _mod, bytesRef o_result)
+{
+    bigint const mod = fromBigEndian<bigint>(_mod);
+    bigint const result = mod != 0 ? boost::multiprecision::powm(fromBigEndian<bigint>(_base),
+                                         fromBigEndian<bigint>(_exp), mod) :
+                                     bigint{0};
+    toBigEndian(result, o_result);
+}
+}  // namespace crypto
+}  // namespace dev
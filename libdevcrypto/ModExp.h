@@ -0,0 +1,31 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Modular exponentiation of big-endian numbers, as used by the modexp precompile.
+#pragma once
+
+#include <libdevcore/Common.h>
+
+namespace dev
+{
+namespace crypto
+{
+/// Largest modulus, in bytes, handled by modexpMontgomery().
+constexpr size_t c_maxMontgomeryModulusSize = 512;
+
+/// Computes _base ^ _exp mod _mod, all big-endian, into @a o_result (big-endian, right-aligned,
+/// zero-padded to o_result.size()). A zero modulus gives zero.
+/// @a o_result must be at least as long as @a _mod.
+void modexp(bytesConstRef _base, bytesConstRef _exp, bytesConstRef _mod, bytesRef o_result);
+
+/// Fixed-width Montgomery multiplication for odd moduli of up to c_maxMontgomeryModulusSize
+/// bytes, with the base not longer than the modulus width it is computed in.
+/// @returns false, leaving @a o_result untouched, if the arguments are not supported.
+bool modexpMontgomery(bytesConstRef _base, bytesConstRef _exp, bytesConstRef _mod, bytesRef o_result);
+
+/// Generic implementation on arbitrary-precision integers, for any arguments.
+void modexpGeneric(bytesConstRef _base, bytesConstRef _exp, bytesConstRef _mod, bytesRef o_result);
+}
+}  // namespace dev
@@ -83,9 +83,8 @@ void Ethash::verify(Strictness _s, BlockHeader const& _bi, BlockHeader const& _p
     // check it hashes according to proof of work or that it's the genesis block.
     if (_s == CheckEverything && _bi.parentHash() && !verifySeal(_bi))
     {
-        ethash::result result =
-            ethash::hash(ethash::get_global_epoch_context(ethash::get_epoch_number(_bi.number())),
-                toEthash(_bi.hash(WithoutSeal)), toEthash(nonce(_bi)));
+        ethash::result result = ethash::hash(*m_epochContexts.context(_bi.number()),
+            toEthash(_bi.hash(WithoutSeal)), toEthash(nonce(_bi)));
 
         h256 mix{result.mix_hash.bytes, h256::ConstructFromPointer};
         h256 final{result.final_hash.bytes, h256::ConstructFromPointer};
@@ -152,9 +151,8 @@ bool Ethash::verifySeal(BlockHeader const& _blockHeader) const
     Nonce const n = nonce(_blockHeader);
     h256 const m = mixHash(_blockHeader);
 
-    auto& context =
-        ethash::get_global_epoch_context(ethash::get_epoch_number(_blockHeader.number()));
-    return ethash::verify(context, toEthash(h), toEthash(m), toEthash(n), toEthash(b));
+    auto const context = m_epochContexts.context(_blockHeader.number());
+    return ethash::verify(*context, toEthash(h), toEthash(m), toEthash(n), toEthash(b));
 }
 
 void Ethash::generateSeal(BlockHeader const& _bi)
@@ -6,6 +6,7 @@
 /// The Ethash proof of work algorithm.
 #pragma once
 
+#include "EthashEpochContexts.h"
 #include "EthashProofOfWork.h"
 #include <libethcore/SealEngine.h>
 #include <libethereum/Client.h>
@@ -85,6 +86,9 @@ public:
 
     void submitExternalHashrate(u256 const& _rate, h256 const& _id);
 
+    /// Timing of the generation of epoch contexts used for verification.
+    EpochContextStats epochContextStats() const { return m_epochContexts.stats(); }
+
 private:
     bool verifySeal(BlockHeader const& _blockHeader) const;
     bool quickVerifySeal(BlockHeader const& _blockHeader) const;
@@ -103,6 +107,9 @@ private:
     mutable std::unordered_map<h256, std::pair<u256, std::chrono::steady_clock::time_point>>
         m_externalRates;
     mutable SharedMutex x_externalRates;
+
+    /// Light contexts used to verify seals.
+    mutable EthashEpochContexts m_epochContexts;
 };
 
 DEV_SIMPLE_EXCEPTION(InvalidSealEngine);
@@ -7,19 +7,144 @@
 
 #include "EthashCPUMiner.h"
 #include "Ethash.h"
+#include "EthashCPUMinerDetail.h"
+
+#include <libdevcore/CommonIO.h>
 
 #include <ethash/ethash.hpp>
 
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
 #include <thread>
 #include <chrono>
+#include <limits>
 #include <random>
+#include <sstream>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 using namespace std;
 using namespace dev;
 using namespace eth;
 
 unsigned EthashCPUMiner::s_numInstances = 0;
+bool EthashCPUMiner::s_pinThreads = false;
+
+namespace
+{
+/// @returns whether @a _text is a CPU number, which is then in @a o_cpu.
+bool parseCpu(string const& _text, unsigned& o_cpu)
+{
+    // Bounded, so that a range can neither overflow nor make an absurdly long list.
+    unsigned const c_maxCpus = 65536;
+    if (_text.empty() || _text.size() > 5 ||
+        !all_of(_text.begin(), _text.end(), [](char _c) { return _c >= '0' && _c <= '9'; }))
+        return false;
+    o_cpu = stoul(_text);
+    return o_cpu < c_maxCpus;
+}
+
+#if defined(__linux__)
+unsigned const c_maxNumaNodes = 64;
 
+/// @returns the CPUs the calling thread may run on, taking one from each NUMA node in turn.
+vector<unsigned> allowedCpusAcrossNodes()
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+        return {};
+
+    vector<vector<unsigned>> nodes;
+    for (unsigned node = 0; node < c_maxNumaNodes; ++node)
+    {
+        vector<unsigned> cpus;
+        string const list =
+            contentsString("/sys/devices/system/node/node" + toString(node) + "/cpulist");
+        for (unsigned cpu : cpuminer::parseCpuList(list))
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))
+                cpus.push_back(cpu);
+        if (!cpus.empty())
+            nodes.push_back(move(cpus));
+    }
+    if (nodes.empty())
+    {
+        // No NUMA information: a single node with every allowed CPU.
+        nodes.emplace_back();
+        for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            if (CPU_ISSET(cpu, &allowed))
+                nodes.back().push_back(cpu);
+    }
+    return cpuminer::cpusAcrossNodes(nodes);
+}
+#endif
+
+/// Binds the calling thread, the miner @a _index, to a CPU of its own as far as there are enough.
+void pinThread(unsigned _index)
+{
+#if defined(__linux__)
+    // Computed by the first miner, before it is pinned and while it may still run anywhere.
+    static vector<unsigned> const s_cpus = allowedCpusAcrossNodes();
+    if (s_cpus.empty())
+        return;
+    unsigned const cpu = s_cpus[_index % s_cpus.size()];
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+        cwarn << "Failed to pin miner " << _index << " to CPU " << cpu;
+#else
+    (void)_index;
+#endif
+}
+}  // namespace
+
+uint64_t dev::eth::cpuminer::startNonce(h256 const& _headerHash, unsigned _index, unsigned _instances)
+{
+    static uint64_t const s_seed = mt19937_64(random_device{}())();
+    uint64_t const base = s_seed ^ fromBigEndian<uint64_t>(_headerHash.ref().cropped(0, 8));
+    // Rounded down, so that the last range ends before the first one starts.
+    uint64_t const range = numeric_limits<uint64_t>::max() / _instances;
+    return base + _index * range;
+}
+
+vector<unsigned> dev::eth::cpuminer::parseCpuList(string const& _list)
+{
+    vector<unsigned> ret;
+    istringstream in(_list);
+    string range;
+    while (getline(in, range, ','))
+    {
+        boost::trim(range);
+        size_t const dash = range.find('-');
+        unsigned first = 0;
+        unsigned last = 0;
+        if (!parseCpu(range.substr(0, dash), first) ||
+            !parseCpu(dash == string::npos ? range : range.substr(dash + 1), last) || first > last)
+            continue;
+        for (unsigned cpu = first; cpu <= last; ++cpu)
+            ret.push_back(cpu);
+    }
+    return ret;
+}
+
+vector<unsigned> dev::eth::cpuminer::cpusAcrossNodes(vector<vector<unsigned>> const& _nodes)
+{
+    size_t count = 0;
+    for (auto const& cpus : _nodes)
+        count += cpus.size();
+
+    vector<unsigned> ret;
+    for (size_t i = 0; ret.size() < count; ++i)
+        for (auto const& cpus : _nodes)
+            if (i < cpus.size())
+                ret.push_back(cpus[i]);
+    return ret;
+}
 
 EthashCPUMiner::EthashCPUMiner(GenericMiner<EthashProofOfWork>::ConstructionInfo const& _ci)
   : GenericMiner<EthashProofOfWork>(_ci)
@@ -65,29 +190,31 @@ void EthashCPUMiner::stopWorking()
 void EthashCPUMiner::minerBody()
 {
     setThreadName("miner" + toString(index()));
-
-    auto tid = std::this_thread::get_id();
-    static std::mt19937_64 s_eng((utcTime() + std::hash<decltype(tid)>()(tid)));
-
-    uint64_t tryNonce = s_eng();
+    if (s_pinThreads)
+        pinThread(index());
 
     // FIXME: Use epoch number, not seed hash in the work package.
     WorkPackage w = work();
+    h256 const headerHash = w.headerHash();
+    uint64_t tryNonce = cpuminer::startNonce(headerHash, index(), instances());
 
     int epoch = ethash::find_epoch_number(toEthash(w.seedHash));
+    // The full dataset is built once per epoch and shared by all the miners.
     auto& ethashContext = ethash::get_global_epoch_context_full(epoch);
 
+    auto const header = toEthash(headerHash);
     h256 boundary = w.boundary;
-    for (unsigned hashCount = 1; !m_shouldStop; tryNonce++, hashCount++)
+    cpuminer::HashBatch hashes{[this](unsigned _n) { accumulateHashes(_n); }};
+    for (; !m_shouldStop; tryNonce++)
     {
-        auto result = ethash::hash(ethashContext, toEthash(w.headerHash()), tryNonce);
+        auto result = ethash::hash(ethashContext, header, tryNonce);
+        hashes.count();
         h256 value = h256(result.final_hash.bytes, h256::ConstructFromPointer);
         if (value <= boundary && submitProof(EthashProofOfWork::Solution{(h64)(u64)tryNonce,
                                      h256(result.mix_hash.bytes, h256::ConstructFromPointer)}))
             break;
-        if (!(hashCount % 100))
-            accumulateHashes(100);
     }
+    hashes.flush();
 }
 
 std::string EthashCPUMiner::platformInfo()
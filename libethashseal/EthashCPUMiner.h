@@ -28,6 +28,10 @@ public:
     {
         s_numInstances = std::min<unsigned>(_instances, std::thread::hardware_concurrency());
     }
+    /// Sets whether each miner thread is bound to its own CPU. CPUs are handed out one NUMA node
+    /// after another, so that fewer threads than CPUs still use every node's memory bandwidth.
+    /// Only supported on Linux.
+    static void setPinThreads(bool _pin) { s_pinThreads = _pin; }
 
 protected:
     void kickOff() override;
@@ -35,6 +39,7 @@ protected:
 
 private:
     static unsigned s_numInstances;
+    static bool s_pinThreads;
 
     void startWorking();
     void stopWorking();
@@ -0,0 +1,68 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Parts of the CPU miner that work without a running miner, exposed for the unit tests.
+#pragma once
+
+#include <libdevcore/FixedHash.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+namespace cpuminer
+{
+/// Hashes done before they are added to the miner's hash count.
+unsigned const c_hashBatch = 100;
+
+/// @returns the nonce miner @a _index of @a _instances starts from on the work with
+/// @a _headerHash. Miners split the nonce space into equal ranges, so that they never try the
+/// same nonce; where the ranges start is random for each process, so that separate processes
+/// don't either.
+uint64_t startNonce(h256 const& _headerHash, unsigned _index, unsigned _instances);
+
+/// @returns the CPUs of @a _list, in the format of sysfs cpulist files, e.g. "0-3,8,10-11".
+/// Entries that are not a CPU number or an increasing range of them are skipped.
+std::vector<unsigned> parseCpuList(std::string const& _list);
+
+/// @returns the CPUs of @a _nodes, the CPUs of each NUMA node, taking one from each node in turn.
+std::vector<unsigned> cpusAcrossNodes(std::vector<std::vector<unsigned>> const& _nodes);
+
+/// Counts a miner's hashes and hands them to @a _accumulate a batch at a time, so that the
+/// miner's hash count is locked once per batch rather than once per hash.
+class HashBatch
+{
+public:
+    explicit HashBatch(std::function<void(unsigned)> _accumulate)
+      : m_accumulate(std::move(_accumulate))
+    {}
+
+    /// Counts one hash.
+    void count()
+    {
+        if (++m_count == c_hashBatch)
+            flush();
+    }
+
+    /// Hands over the hashes of the partial batch; called when the miner stops, or short runs
+    /// would under-report.
+    void flush()
+    {
+        if (m_count)
+            m_accumulate(m_count);
+        m_count = 0;
+    }
+
+private:
+    std::function<void(unsigned)> m_accumulate;
+    unsigned m_count = 0;
+};
+}  // namespace cpuminer
+}  // namespace eth
+}  // namespace dev
@@ -0,0 +1,110 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "EthashEpochContexts.h"
+
+#include <libdevcore/Common.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+EthashEpochContexts::~EthashEpochContexts()
+{
+    // The background build refers to members that must outlive it.
+    if (m_next.valid())
+        m_next.wait();
+}
+
+EthashEpochContexts::ContextPtr EthashEpochContexts::context(int64_t _blockNumber)
+{
+    int const epoch = ethash::get_epoch_number(static_cast<int>(_blockNumber));
+    bool const nearBoundary =
+        _blockNumber % ethash::epoch_length >= ethash::epoch_length - c_nextEpochLead;
+
+    shared_future<ContextPtr> pending;
+    {
+        Guard l(x_contexts);
+        if (epoch == m_currentEpoch)
+        {
+            ContextPtr ret = m_current;
+            if (nearBoundary)
+                scheduleNext(epoch);
+            return ret;
+        }
+        // Blocks of both sides of a boundary are verified at the same time, so the epoch before
+        // the current one must not need a new build every time it comes up.
+        if (epoch == m_previousEpoch)
+            return m_previous;
+        if (epoch == m_nextEpoch)
+            pending = m_next;
+    }
+
+    Timer waitTimer;
+    ContextPtr ret;
+    if (pending.valid())
+        ret = pending.get();
+    else
+    {
+        ret = build(epoch);
+        Guard l(x_stats);
+        ++m_stats.blockingGenerations;
+    }
+    DEV_GUARDED(x_stats)
+        m_stats.totalWaitSeconds += waitTimer.elapsed();
+
+    Guard l(x_contexts);
+    if (epoch > m_currentEpoch)
+    {
+        m_previousEpoch = m_currentEpoch;
+        m_previous = move(m_current);
+        m_currentEpoch = epoch;
+        m_current = ret;
+        if (m_nextEpoch <= epoch)
+        {
+            m_nextEpoch = -1;
+            m_next = {};
+        }
+        if (nearBoundary)
+            scheduleNext(epoch);
+    }
+    else if (epoch > m_previousEpoch)
+    {
+        // An older epoch never replaces the current one.
+        m_previousEpoch = epoch;
+        m_previous = ret;
+    }
+    return ret;
+}
+
+EpochContextStats EthashEpochContexts::stats() const
+{
+    Guard l(x_stats);
+    return m_stats;
+}
+
+EthashEpochContexts::ContextPtr EthashEpochContexts::build(int _epoch)
+{
+    Timer timer;
+    ContextPtr ret{ethash::create_epoch_context(_epoch)};
+    double const elapsed = timer.elapsed();
+
+    DEV_GUARDED(x_stats)
+    {
+        ++m_stats.generations;
+        m_stats.lastGenerationSeconds = elapsed;
+        m_stats.totalGenerationSeconds += elapsed;
+    }
+    LOG(m_logger) << "Generated Ethash context for epoch " << _epoch << " in " << elapsed << " s";
+    return ret;
+}
+
+void EthashEpochContexts::scheduleNext(int _epoch)
+{
+    // x_contexts must be held.
+    if (m_nextEpoch == _epoch + 1)
+        return;
+    m_nextEpoch = _epoch + 1;
+    m_next = async(launch::async, [this, _epoch] { return build(_epoch + 1); }).share();
+}
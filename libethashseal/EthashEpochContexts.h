@@ -0,0 +1,78 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Cache of Ethash light epoch contexts with background precomputation of the next epoch.
+#pragma once
+
+#include <libdevcore/Guards.h>
+#include <libdevcore/Log.h>
+
+#include <ethash/ethash.hpp>
+
+#include <future>
+#include <memory>
+
+namespace dev
+{
+namespace eth
+{
+
+/// Counters of epoch context generation.
+struct EpochContextStats
+{
+    unsigned generations = 0;         ///< Contexts built so far.
+    unsigned blockingGenerations = 0; ///< Contexts built while a verification was waiting.
+    double lastGenerationSeconds = 0; ///< Time taken to build the latest context.
+    double totalGenerationSeconds = 0;
+    double totalWaitSeconds = 0;      ///< Time verifications spent waiting for a context.
+};
+
+/**
+ * @brief Keeps the light contexts of the current, the previous and the next Ethash epoch.
+ *
+ * The current epoch is the highest one requested; requests for older epochs never replace it.
+ * Once a requested block is within c_nextEpochLead blocks of the epoch boundary, the context of
+ * the next epoch is built on a background thread, so that the first block of the new epoch does
+ * not stall verification while the light cache is generated.
+ * @threadsafe
+ */
+class EthashEpochContexts
+{
+public:
+    using ContextPtr = std::shared_ptr<ethash::epoch_context const>;
+
+    ~EthashEpochContexts();
+
+    /// Distance to the epoch boundary at which the next epoch's context starts being built.
+    static int const c_nextEpochLead = 1000;
+
+    /// @returns the context of the epoch containing @a _blockNumber.
+    ContextPtr context(int64_t _blockNumber);
+
+    EpochContextStats stats() const;
+
+private:
+    /// Build the context of @a _epoch, recording the time it took.
+    ContextPtr build(int _epoch);
+
+    /// Start building the context of the epoch following @a _epoch, unless already done.
+    void scheduleNext(int _epoch);
+
+    mutable Mutex x_contexts;
+    int m_currentEpoch = -1;
+    ContextPtr m_current;
+    int m_previousEpoch = -1;
+    ContextPtr m_previous;
+    int m_nextEpoch = -1;
+    std::shared_future<ContextPtr> m_next;
+
+    mutable Mutex x_stats;
+    EpochContextStats m_stats;
+
+    Logger m_logger{createLogger(VerbosityInfo, "ethash")};
+};
+
+}
+}
@@ -243,7 +243,9 @@ enum AlethErrors
     BadRlp,
     RlpDataNotAList,
     UnsupportedJsonType,
-    InvalidJson
+    InvalidJson,
+    BenchmarkBelowThreshold,
+    BenchmarkFailure
 };
 }
 }
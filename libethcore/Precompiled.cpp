@@ -11,6 +11,7 @@
 #include <libdevcrypto/Common.h>
 #include <libdevcrypto/Hash.h>
 #include <libdevcrypto/LibSnark.h>
+#include <libdevcrypto/ModExp.h>
 #include <libethcore/Common.h>
 using namespace std;
 using namespace dev;
@@ -32,6 +33,15 @@ PrecompiledPricer const& PrecompiledRegistrar::pricer(std::string const& _name)
     return get()->m_pricers[_name];
 }
 
+std::vector<std::string> PrecompiledRegistrar::executorNames()
+{
+    std::vector<std::string> ret;
+    for (auto const& exec : get()->m_execs)
+        ret.push_back(exec.first);
+    sort(ret.begin(), ret.end());
+    return ret;
+}
+
 namespace
 {
 bigint linearPricer(unsigned _base, unsigned _word, bytesConstRef _in)
@@ -137,6 +147,20 @@ bigint parseBigEndianRightPadded(bytesConstRef _in, bigint const& _begin, bigint
     return ret;
 }
 
+// Copy _count bytes of _in starting with _begin offset, right-padded with zeroes like
+// parseBigEndianRightPadded() does.
+bytes readRightPadded(bytesConstRef _in, bigint const& _begin, bigint const& _count)
+{
+    assert(_count <= numeric_limits<size_t>::max() / 8); // Otherwise, the return value would not fit in the memory.
+    bytes ret(static_cast<size_t>(_count));
+    if (_begin < _in.count())
+    {
+        size_t const begin{_begin};
+        _in.cropped(begin, min(ret.size(), _in.count() - begin)).copyTo(&ret);
+    }
+    return ret;
+}
+
 ETH_REGISTER_PRECOMPILED(modexp)(bytesConstRef _in)
 {
     bigint const baseLength(parseBigEndianRightPadded(_in, 0, 32));
@@ -144,20 +168,16 @@ ETH_REGISTER_PRECOMPILED(modexp)(bytesConstRef _in)
     bigint const modLength(parseBigEndianRightPadded(_in, 64, 32));
     assert(modLength <= numeric_limits<size_t>::max() / 8); // Otherwise gas should be too expensive.
     assert(baseLength <= numeric_limits<size_t>::max() / 8); // Otherwise, gas should be too expensive.
-    if (modLength == 0 && baseLength == 0)
-        return {true, bytes{}}; // This is a special case where expLength can be very big.
+    if (modLength == 0)
+        return {true, bytes{}}; // The result is empty; expLength can be very big if baseLength is 0.
     assert(expLength <= numeric_limits<size_t>::max() / 8);
 
-    bigint const base(parseBigEndianRightPadded(_in, 96, baseLength));
-    bigint const exp(parseBigEndianRightPadded(_in, 96 + baseLength, expLength));
-    bigint const mod(parseBigEndianRightPadded(_in, 96 + baseLength + expLength, modLength));
-
-    bigint const result = mod != 0 ? boost::multiprecision::powm(base, exp, mod) : bigint{0};
-
-    size_t const retLength(modLength);
-    bytes ret(retLength);
-    toBigEndian(result, ret);
+    bytes const base = readRightPadded(_in, 96, baseLength);
+    bytes const exp = readRightPadded(_in, 96 + baseLength, expLength);
+    bytes const mod = readRightPadded(_in, 96 + baseLength + expLength, modLength);
 
+    bytes ret(mod.size());
+    dev::crypto::modexp(&base, &exp, &mod, &ret);
     return {true, ret};
 }
 
@@ -7,6 +7,7 @@
 
 #include <unordered_map>
 #include <functional>
+#include <vector>
 #include <libdevcore/CommonData.h>
 #include <libdevcore/Exceptions.h>
 
@@ -32,6 +33,9 @@ public:
     /// Get the price calculator object for @a _name function or @throw PricerNotFound if not found.
     static PrecompiledPricer const& pricer(std::string const& _name);
 
+    /// Get the names of all registered executors, sorted.
+    static std::vector<std::string> executorNames();
+
     /// Register an executor. In general just use ETH_REGISTER_PRECOMPILED.
     static PrecompiledExecutor registerExecutor(std::string const& _name, PrecompiledExecutor const& _exec) { return (get()->m_execs[_name] = _exec); }
     /// Unregister an executor. Shouldn't generally be necessary.
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <libdevcore/Arena.h>
 #include <libdevcore/Common.h>
 #include <libdevcore/SHA3.h>
 #include <libdevcore/TrieCommon.h>
@@ -12,6 +13,8 @@
 
 #include <boost/filesystem/path.hpp>
 
+#include <unordered_map>
+
 namespace dev
 {
 class OverlayDB;
@@ -36,10 +39,17 @@ namespace eth
  * makes a dead account (this is ignored by State when writing out the Trie). Another three allow a basic
  * or contract account to be specified along with an initial balance. The fina two allow either a basic or
  * a contract account to be created with arbitrary values.
+ *
+ * The storage caches take their memory from the allocator the account is constructed with, which
+ * State uses to keep the accounts it caches in its arena.
  */
 class Account
 {
 public:
+    using allocator_type = ArenaAllocator<std::pair<u256 const, u256>>;
+    using StorageMap =
+        std::unordered_map<u256, u256, std::hash<u256>, std::equal_to<u256>, allocator_type>;
+
     /// Changedness of account to create.
     enum Changedness
     {
@@ -50,7 +60,9 @@ public:
     };
 
     /// Construct a dead Account.
-    Account() {}
+    explicit Account(allocator_type const& _alloc = allocator_type())
+      : m_storageOverlay(_alloc), m_storageOriginal(_alloc)
+    {}
 
     /// Construct an alive Account, with given endowment, for either a normal (non-contract) account
     /// or for a contract account in the conception phase, where the code is not yet known.
@@ -58,18 +70,41 @@ public:
 
     /// Explicit constructor for wierd cases of construction or a contract account.
     Account(u256 const& _nonce, u256 const& _balance, h256 const& _contractRoot,
-        h256 const& _codeHash, u256 const& _version, Changedness _c)
+        h256 const& _codeHash, u256 const& _version, Changedness _c,
+        allocator_type const& _alloc = allocator_type())
       : m_isAlive(true),
         m_isUnchanged(_c == Unchanged),
         m_nonce(_nonce),
         m_balance(_balance),
         m_storageRoot(_contractRoot),
         m_codeHash(_codeHash),
-        m_version(_version)
+        m_version(_version),
+        m_storageOverlay(_alloc),
+        m_storageOriginal(_alloc)
     {
         assert(_contractRoot);
     }
 
+    Account(Account const&) = default;
+    Account(Account&&) = default;
+    Account& operator=(Account const&) = default;
+    Account& operator=(Account&&) = default;
+
+    /// Copy @a _other, with storage caches taking their memory from @a _alloc.
+    Account(Account const& _other, allocator_type const& _alloc)
+      : m_isAlive(_other.m_isAlive),
+        m_isUnchanged(_other.m_isUnchanged),
+        m_hasNewCode(_other.m_hasNewCode),
+        m_nonce(_other.m_nonce),
+        m_balance(_other.m_balance),
+        m_storageRoot(_other.m_storageRoot),
+        m_codeHash(_other.m_codeHash),
+        m_version(_other.m_version),
+        m_storageOverlay(_other.m_storageOverlay, _alloc),
+        m_storageOriginal(_other.m_storageOriginal, _alloc),
+        m_codeCache(_other.m_codeCache)
+    {}
+
 
     /// Kill this account. Useful for the SELFDESTRUCT instruction.
     /// Following this call, isAlive() returns false.
@@ -136,7 +171,7 @@ public:
     u256 originalStorageValue(u256 const& _key, OverlayDB const& _db) const;
 
     /// @returns the storage overlay as a simple hash map.
-    std::unordered_map<u256, u256> const& storageOverlay() const { return m_storageOverlay; }
+    StorageMap const& storageOverlay() const { return m_storageOverlay; }
 
     /// Set a key/value pair in the account's storage. This actually goes into the overlay, for committing
     /// to the trie later.
@@ -215,10 +250,10 @@ private:
     u256 m_version = 0;
 
     /// The map with is overlaid onto whatever storage is implied by the m_storageRoot in the trie.
-    mutable std::unordered_map<u256, u256> m_storageOverlay;
+    mutable StorageMap m_storageOverlay;
 
     /// The cache of unmodifed storage items
-    mutable std::unordered_map<u256, u256> m_storageOriginal;
+    mutable StorageMap m_storageOriginal;
 
     /// The associated code for this account. The SHA3 of this should be equal to m_codeHash unless
     /// m_codeHash equals c_contractConceptionCodeHash.
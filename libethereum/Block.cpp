@@ -5,6 +5,7 @@
 
 #include "Block.h"
 
+#include "BlockBuilder.h"
 #include "BlockChain.h"
 #include "Executive.h"
 #include "ExtVM.h"
@@ -289,7 +290,18 @@ pair<TransactionReceipts, bool> Block::sync(BlockChain const& _bc, TransactionQu
     assert(_bc.currentHash() == m_currentBlock.parentHash());
     auto deadline =  chrono::steady_clock::now() + chrono::milliseconds(msTimeout);
 
-    for (int goodTxs = max(0, (int)transactions.size() - 1); goodTxs < (int)transactions.size();)
+    // Learn the gas usage of the candidates by executing them in parallel against the current
+    // state, so that they can be ordered to fill the remaining gas before committing any of them.
+    if (transactions.size() > 1)
+    {
+        uncommitToSeal();
+        BlockBuilder const builder{m_state, m_currentBlock, _bc.lastBlockHashes(), *sealEngine()};
+        transactions =
+            packTransactions(builder.simulate(transactions, deadline), gasLimitRemaining());
+    }
+
+    // Transactions that failed may succeed once others are in, so retry while progress is made.
+    for (unsigned goodTxs = 1; goodTxs > 0;)
     {
         goodTxs = 0;
         for (auto const& t : transactions)
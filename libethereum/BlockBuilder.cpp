@@ -0,0 +1,250 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "BlockBuilder.h"
+#include "LastBlockHashesFace.h"
+#include <libethcore/SealEngine.h>
+
+#include <libdevcore/Guards.h>
+#include <libdevcore/Log.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <queue>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+/// Threads that run simulations for every builder, started on first use and kept until exit.
+class SimulationPool
+{
+public:
+    explicit SimulationPool(unsigned _threads)
+    {
+        for (unsigned i = 0; i < _threads; ++i)
+            m_threads.emplace_back([this]() { work(); });
+    }
+
+    ~SimulationPool()
+    {
+        {
+            Guard l(x_tasks);
+            m_stopped = true;
+        }
+        m_ready.notify_all();
+        for (auto& t : m_threads)
+            t.join();
+    }
+
+    unsigned size() const { return m_threads.size(); }
+
+    void post(function<void()> _task)
+    {
+        {
+            Guard l(x_tasks);
+            m_tasks.push(move(_task));
+        }
+        m_ready.notify_one();
+    }
+
+private:
+    void work()
+    {
+        setThreadName("simulate");
+        while (true)
+        {
+            function<void()> task;
+            {
+                unique_lock<Mutex> l(x_tasks);
+                m_ready.wait(l, [this]() { return m_stopped || !m_tasks.empty(); });
+                if (m_stopped)
+                    return;
+                task = move(m_tasks.front());
+                m_tasks.pop();
+            }
+            task();
+        }
+    }
+
+    vector<thread> m_threads;
+    Mutex x_tasks;
+    condition_variable m_ready;
+    queue<function<void()>> m_tasks;
+    bool m_stopped = false;
+};
+
+/// The calling thread simulates too, so the pool has one thread less than the machine.
+SimulationPool& simulationPool()
+{
+    static SimulationPool s_pool{max(thread::hardware_concurrency(), 2U) - 1};
+    return s_pool;
+}
+}  // namespace
+
+BlockBuilder::BlockBuilder(State const& _state, BlockHeader const& _header,
+    LastBlockHashesFace const& _lh, SealEngineFace const& _sealEngine, unsigned _threads)
+  : m_state(_state),
+    m_header(_header),
+    m_lastHashes(_lh),
+    m_sealEngine(_sealEngine),
+    m_threads(max(_threads, 1U))
+{}
+
+SimulatedTransactions BlockBuilder::simulate(
+    Transactions const& _transactions, chrono::steady_clock::time_point _deadline) const
+{
+    SimulatedTransactions ret(_transactions.size());
+
+    // Group indices by sender, keeping the nonce order of each sender.
+    vector<vector<size_t>> groups;
+    unordered_map<Address, size_t> groupOfSender;
+    for (size_t i = 0; i < _transactions.size(); ++i)
+    {
+        ret[i].transaction = _transactions[i];
+        auto const inserted = groupOfSender.emplace(_transactions[i].sender(), groups.size());
+        if (inserted.second)
+            groups.emplace_back();
+        groups[inserted.first->second].push_back(i);
+    }
+
+    atomic<size_t> nextGroup{0};
+    auto const simulateGroups = [&]() {
+        for (size_t g = nextGroup++; g < groups.size(); g = nextGroup++)
+        {
+            if (chrono::steady_clock::now() >= _deadline)
+                break;
+            // Each group starts from a pristine copy, as selfdestructs are not undone by rollback.
+            State state(m_state);
+            for (size_t const i : groups[g])
+            {
+                SimulatedTransaction& sim = ret[i];
+                size_t const savepoint = state.savepoint();
+                try
+                {
+                    EnvInfo const envInfo{
+                        m_header, m_lastHashes, 0, m_sealEngine.chainParams().chainID};
+                    auto const resultReceipt =
+                        state.execute(envInfo, m_sealEngine, sim.transaction, Permanence::Uncommitted);
+                    sim.gasUsed = resultReceipt.second.cumulativeGasUsed();
+                    sim.valid = true;
+                }
+                catch (std::exception const&)
+                {
+                    // Later transactions of this sender would fail on the nonce.
+                    break;
+                }
+
+                ChangeLog const& changes = state.changeLog();
+                for (auto it = changes.begin() + savepoint; it != changes.end(); ++it)
+                    if (it->address != m_header.author())
+                        sim.modified.insert(it->address);
+            }
+        }
+    };
+
+    // The helpers use this frame, so they have to finish before anything leaves it, and an
+    // exception of any of them is thrown from here.
+    SimulationPool& pool = simulationPool();
+    unsigned const helpers = min<size_t>({m_threads - 1, pool.size(), groups.size()});
+    Mutex x_done;
+    condition_variable done;
+    unsigned running = helpers + 1;
+    exception_ptr error;
+    auto const runAndReport = [&]() {
+        exception_ptr e;
+        try
+        {
+            simulateGroups();
+        }
+        catch (...)
+        {
+            e = current_exception();
+        }
+        Guard l(x_done);
+        if (e && !error)
+            error = e;
+        if (--running == 0)
+            done.notify_one();
+    };
+    for (unsigned t = 0; t < helpers; ++t)
+        pool.post(runAndReport);
+    runAndReport();
+    {
+        unique_lock<Mutex> l(x_done);
+        done.wait(l, [&]() { return running == 0; });
+    }
+    if (error)
+        rethrow_exception(error);
+
+    return ret;
+}
+
+Transactions dev::eth::packTransactions(SimulatedTransactions const& _simulated, u256 const& _gasLeft)
+{
+    // Per-sender queues of transaction indices, in nonce order.
+    vector<vector<size_t>> chains;
+    unordered_map<Address, size_t> chainOfSender;
+    for (size_t i = 0; i < _simulated.size(); ++i)
+    {
+        auto const inserted = chainOfSender.emplace(_simulated[i].transaction.sender(), chains.size());
+        if (inserted.second)
+            chains.emplace_back();
+        chains[inserted.first->second].push_back(i);
+    }
+
+    // Heads of the chains, highest gas price first and original order among equal prices.
+    using Head = pair<size_t, size_t>;  // chain index, position in chain
+    auto const lowerPriority = [&](Head const& _a, Head const& _b) {
+        Transaction const& a = _simulated[chains[_a.first][_a.second]].transaction;
+        Transaction const& b = _simulated[chains[_b.first][_b.second]].transaction;
+        return a.gasPrice() < b.gasPrice() ||
+               (a.gasPrice() == b.gasPrice() &&
+                   chains[_a.first][_a.second] > chains[_b.first][_b.second]);
+    };
+    priority_queue<Head, vector<Head>, decltype(lowerPriority)> heads(lowerPriority);
+    for (size_t c = 0; c < chains.size(); ++c)
+        if (_simulated[chains[c].front()].valid)
+            heads.emplace(c, 0);
+
+    Transactions ret;
+    vector<bool> packed(_simulated.size(), false);
+    unordered_map<Address, Address> modifiedBy;  // account -> sender whose transaction changed it
+    u256 gasLeft = _gasLeft;
+    while (!heads.empty())
+    {
+        Head const head = heads.top();
+        heads.pop();
+        size_t const index = chains[head.first][head.second];
+        SimulatedTransaction const& sim = _simulated[index];
+        Address const sender = sim.transaction.sender();
+
+        if (sim.transaction.gas() > gasLeft)
+            continue;  // The rest of this sender's transactions can't go in without this one.
+
+        bool conflicting = false;
+        for (auto const& a : sim.modified)
+        {
+            auto const it = modifiedBy.emplace(a, sender).first;
+            conflicting = conflicting || it->second != sender;
+        }
+
+        u256 const expectedGas = conflicting ? sim.transaction.gas() : sim.gasUsed;
+        gasLeft -= min(expectedGas, gasLeft);
+        ret.push_back(sim.transaction);
+        packed[index] = true;
+
+        size_t const next = head.second + 1;
+        if (next < chains[head.first].size() && _simulated[chains[head.first][next]].valid)
+            heads.emplace(head.first, next);
+    }
+
+    for (size_t i = 0; i < _simulated.size(); ++i)
+        if (!packed[i])
+            ret.push_back(_simulated[i].transaction);
+    return ret;
+}
@@ -0,0 +1,76 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Parallel pre-simulation and packing of pending transactions into a block.
+#pragma once
+
+#include "State.h"
+#include "Transaction.h"
+#include <libethcore/BlockHeader.h>
+
+#include <chrono>
+#include <thread>
+
+namespace dev
+{
+namespace eth
+{
+
+class LastBlockHashesFace;
+class SealEngineFace;
+
+/// Outcome of executing a candidate transaction on top of the block's state, in isolation from
+/// the candidates of other senders.
+struct SimulatedTransaction
+{
+    Transaction transaction;
+    bool valid = false;     ///< Whether execution succeeded; if not, gasUsed and modified are empty.
+    u256 gasUsed;           ///< Gas used by the transaction alone.
+    AddressHash modified;   ///< Accounts changed by the transaction, except the block author.
+};
+
+using SimulatedTransactions = std::vector<SimulatedTransaction>;
+
+/**
+ * @brief Executes candidate transactions in parallel against a snapshot of a block's state.
+ *
+ * Transactions are grouped by sender and each group is executed in order on its own copy of the
+ * state, so that a sender's consecutive nonces can be simulated without the candidates of other
+ * senders. Nothing is written back to the original state. The groups run on a pool of threads
+ * shared by all builders, which is started once.
+ */
+class BlockBuilder
+{
+public:
+    BlockBuilder(State const& _state, BlockHeader const& _header, LastBlockHashesFace const& _lh,
+        SealEngineFace const& _sealEngine, unsigned _threads = std::thread::hardware_concurrency());
+
+    /// Simulate @a _transactions, which must be ordered so that each sender's transactions are in
+    /// nonce order (as TransactionQueue::topTransactions() returns them). No further sender is
+    /// started once @a _deadline has passed; its transactions are left invalid.
+    /// @returns one entry per transaction, in the same order.
+    SimulatedTransactions simulate(Transactions const& _transactions,
+        std::chrono::steady_clock::time_point _deadline =
+            std::chrono::steady_clock::time_point::max()) const;
+
+private:
+    State const& m_state;
+    BlockHeader const& m_header;
+    LastBlockHashesFace const& m_lastHashes;
+    SealEngineFace const& m_sealEngine;
+    unsigned m_threads;
+};
+
+/// Order simulated transactions for execution: greedily by gas price into @a _gasLeft, keeping
+/// each sender's transactions in nonce order. A transaction is packed only if its gas limit fits
+/// into the gas expected to remain at that point; transactions that modify an account already
+/// modified by a packed transaction of another sender are budgeted at their full gas limit, as
+/// their simulated gas usage may be stale.
+/// @returns the packed transactions, followed by the ones that failed simulation or did not fit,
+/// in their original order.
+Transactions packTransactions(SimulatedTransactions const& _simulated, u256 const& _gasLeft);
+
+}
+}
@@ -22,6 +22,8 @@
 #include <boost/exception/errinfo_nested_exception.hpp>
 #include <boost/filesystem.hpp>
 
+#include <array>
+
 using namespace std;
 using namespace dev;
 using namespace dev::eth;
@@ -44,7 +46,9 @@ std::ostream& dev::eth::operator<<(std::ostream& _out, BlockChain const& _bc)
             const string key(_key.data(), _key.size());
             try
             {
-                BlockHeader d(bytesConstRef{_value});
+                string value(_value.data(), _value.size());
+                uncompressChainData(value);
+                BlockHeader d{bytesConstRef(&value)};
                 _out << toHex(key) << ":   " << d.number() << " @ " << d.parentHash()
                      << (cmp == key ? "  BEST" : "") << std::endl;
             }
@@ -96,6 +100,21 @@ db::Slice dev::eth::toSlice(uint64_t _n, unsigned _sub)
 namespace
 {
 
+/// Adds a block body or receipts to @a _batch, compressed if chain data compression is on.
+void insertChainData(db::WriteBatchFace& _batch, db::Slice _key, bytesConstRef _rlp)
+{
+    if (chainDataCompression())
+    {
+        string const compressed = compressChainData(_rlp);
+        _batch.insert(_key, db::Slice(compressed));
+    }
+    else
+        _batch.insert(_key, db::Slice(_rlp));
+}
+
+/// Hashes of the 256 blocks ending at the most recently requested one, kept in a ring buffer
+/// indexed by block number. Moving to a child of the current head costs a single step; a reorg
+/// costs one step per replaced block until the common ancestor is found in the buffer.
 class LastBlockHashes: public LastBlockHashesFace
 {
 public:
@@ -103,28 +122,89 @@ public:
 
     h256s precedingHashes(h256 const& _mostRecentHash) const override
     {
+        h256s ret(c_size);
         Guard l(m_lastHashesMutex);
-        if (m_lastHashes.empty() || m_lastHashes.front() != _mostRecentHash)
+        if (!update(_mostRecentHash))
         {
-            m_lastHashes.resize(256);
-            m_lastHashes[0] = _mostRecentHash;
-            for (unsigned i = 0; i < 255; ++i)
-                m_lastHashes[i + 1] = m_lastHashes[i] ? m_bc.info(m_lastHashes[i]).parentHash() : h256();
+            ret[0] = _mostRecentHash;
+            return ret;
         }
-        return m_lastHashes;
+        for (unsigned i = 0; i < c_size && i <= m_headNumber; ++i)
+            ret[i] = m_hashes[(m_headNumber - i) % c_size];
+        return ret;
+    }
+
+    h256 precedingHash(h256 const& _mostRecentHash, unsigned _distance) const override
+    {
+        if (_distance >= c_size)
+            return h256();
+        Guard l(m_lastHashesMutex);
+        if (!update(_mostRecentHash))
+            return _distance == 0 ? _mostRecentHash : h256();
+        return _distance <= m_headNumber ? m_hashes[(m_headNumber - _distance) % c_size] : h256();
     }
 
     void clear() override
     {
         Guard l(m_lastHashesMutex);
-        m_lastHashes.clear();
+        m_head = h256();
     }
 
 private:
+    static unsigned const c_size = 256;
+
+    static unsigned lowestNumber(unsigned _headNumber)
+    {
+        return _headNumber >= c_size - 1 ? _headNumber - (c_size - 1) : 0;
+    }
+
+    /// Move the window to end at @a _mostRecentHash, walking back through the block details until
+    /// an ancestor already in the window is met. m_lastHashesMutex must be held.
+    /// @returns false if the block is unknown.
+    bool update(h256 const& _mostRecentHash) const
+    {
+        if (m_head && m_head == _mostRecentHash)
+            return true;
+
+        BlockDetails details = m_bc.details(_mostRecentHash);
+        if (!details)
+            return false;
+
+        unsigned const headNumber = details.number;
+        unsigned const lowest = lowestNumber(headNumber);
+        // The old window can supply the rest only if it reaches down as far as the new one.
+        bool const reuse = m_head && lowestNumber(m_headNumber) <= lowest;
+        h256 hash = _mostRecentHash;
+        for (unsigned number = headNumber;; --number)
+        {
+            h256& slot = m_hashes[number % c_size];
+            if (reuse && hash && number <= m_headNumber && slot == hash)
+                break;
+            slot = hash;
+            if (number == lowest)
+                break;
+            // Ancestors of a block inserted without its parent are not known.
+            if (hash)
+                hash = details.parentHash;
+            if (hash)
+            {
+                details = m_bc.details(hash);
+                if (!details)
+                    hash = h256();
+            }
+        }
+
+        m_head = _mostRecentHash;
+        m_headNumber = headNumber;
+        return true;
+    }
+
     BlockChain const& m_bc;
 
     mutable Mutex m_lastHashesMutex;
-    mutable h256s m_lastHashes;
+    mutable std::array<h256, c_size> m_hashes;
+    mutable h256 m_head;                ///< Most recent hash in m_hashes; null if invalid.
+    mutable unsigned m_headNumber = 0;
 };
 
 void addBlockInfo(Exception& io_ex, BlockHeader const& _header, bytes&& _blockData)
@@ -305,6 +385,10 @@ bool BlockChain::open(fs::path const& _path, WithExisting _we)
     // database because the extras database format may have changed
     m_lastBlockNumber = info(m_lastBlockHash).number();
 
+    if (!rebuildNeeded)
+        m_bloomBits.open(
+            *m_extrasDB, m_lastBlockNumber, [this](unsigned _number) { return blockBloom(_number); });
+
     LOG(m_loggerInfo) << "Opened blockchain database. Latest block hash: " << currentHash()
                       << (!rebuildNeeded ? "(rebuild not needed)" : "*** REBUILD NEEDED ***");
     return rebuildNeeded;
@@ -340,7 +424,7 @@ void BlockChain::close()
     m_receipts.clear();
     m_transactionAddresses.clear();
     m_blockHashes.clear();
-    m_blocksBlooms.clear();
+    m_bloomBits.close();
     m_cacheUsage.clear();
     m_inUse.clear();
     m_lastBlockHashes->clear();
@@ -394,7 +478,7 @@ void BlockChain::rebuild(
     m_receipts.clear();
     m_transactionAddresses.clear();
     m_blockHashes.clear();
-    m_blocksBlooms.clear();
+    m_bloomBits.open(*m_extrasDB, 0, [this](unsigned _number) { return blockBloom(_number); });
     m_lastBlockHashes->clear();
     m_lastBlockHash = genesisHash();
     m_lastBlockNumber = 0;
@@ -593,9 +677,13 @@ pair<ImportResult, ImportRoute> BlockChain::attemptImport(bytes const& _block, O
 
 ImportRoute BlockChain::import(bytes const& _block, OverlayDB const& _db, bool _mustBeNew)
 {
+    ImportPerformanceLogger performanceLogger;
+
     // VERIFY: populates from the block and checks the block is internally coherent.
     VerifiedBlockRef const block = verifyBlock(&_block, m_onBad, ImportRequirements::OutOfOrderChecks);
-    return import(block, _db, _mustBeNew);
+    performanceLogger.onStageFinished("verification");
+
+    return import(block, _db, _mustBeNew, performanceLogger);
 }
 
 void BlockChain::insert(bytes const& _block, bytesConstRef _receipts, bool _mustBeNew)
@@ -673,7 +761,7 @@ void BlockChain::insert(VerifiedBlockRef _block, bytesConstRef _receipts, bool _
             m_details[_block.info.parentHash()].childHashes.push_back(_block.info.hash());
     }
 
-    blocksWriteBatch->insert(toSlice(_block.info.hash()), db::Slice(_block.block));
+    insertChainData(*blocksWriteBatch, toSlice(_block.info.hash()), _block.block);
     DEV_READ_GUARDED(x_details)
     extrasWriteBatch->insert(toSlice(_block.info.parentHash(), ExtraDetails),
         (db::Slice)dev::ref(m_details[_block.info.parentHash()].rlp()));
@@ -685,7 +773,7 @@ void BlockChain::insert(VerifiedBlockRef _block, bytesConstRef _receipts, bool _
         toSlice(_block.info.hash(), ExtraDetails), (db::Slice)dev::ref(bd.rlp()));
     extrasWriteBatch->insert(
         toSlice(_block.info.hash(), ExtraLogBlooms), (db::Slice)dev::ref(blb.rlp()));
-    extrasWriteBatch->insert(toSlice(_block.info.hash(), ExtraReceipts), (db::Slice)_receipts);
+    insertChainData(*extrasWriteBatch, toSlice(_block.info.hash(), ExtraReceipts), _receipts);
 
     try
     {
@@ -712,9 +800,14 @@ void BlockChain::insert(VerifiedBlockRef _block, bytesConstRef _receipts, bool _
 
 ImportRoute BlockChain::import(VerifiedBlockRef const& _block, OverlayDB const& _db, bool _mustBeNew)
 {
-    //@tidy This is a behemoth of a method - could do to be split into a few smaller ones.
-
     ImportPerformanceLogger performanceLogger;
+    return import(_block, _db, _mustBeNew, performanceLogger);
+}
+
+ImportRoute BlockChain::import(VerifiedBlockRef const& _block, OverlayDB const& _db,
+    bool _mustBeNew, ImportPerformanceLogger& _performanceLogger)
+{
+    //@tidy This is a behemoth of a method - could do to be split into a few smaller ones.
 
     // Check block doesn't already exist first!
     if (_mustBeNew)
@@ -751,7 +844,7 @@ ImportRoute BlockChain::import(VerifiedBlockRef const& _block, OverlayDB const&
     LOG(m_loggerDetail) << "Attempting import of block " << _block.info.hash() << " (#"
                         << _block.info.number() << ") ...";
 
-    performanceLogger.onStageFinished("preliminaryChecks");
+    _performanceLogger.onStageFinished("preliminaryChecks");
 
     BlockReceipts br;
     u256 td;
@@ -765,11 +858,13 @@ ImportRoute BlockChain::import(VerifiedBlockRef const& _block, OverlayDB const&
         for (unsigned i = 0; i < s.pending().size(); ++i)
             br.receipts.push_back(s.receipt(i));
 
+        _performanceLogger.onStageFinished("enactment");
+
         s.cleanup();
 
         td = pd.totalDifficulty + tdIncrease;
 
-        performanceLogger.onStageFinished("enactment");
+        _performanceLogger.onStageFinished("stateCommit");
     }
     catch (BadRoot& ex)
     {
@@ -787,7 +882,7 @@ ImportRoute BlockChain::import(VerifiedBlockRef const& _block, OverlayDB const&
 
     // All ok - insert into DB
     bytes const receipts = br.rlp();
-    return insertBlockAndExtras(_block, ref(receipts), td, performanceLogger);
+    return insertBlockAndExtras(_block, ref(receipts), td, _performanceLogger);
 }
 
 ImportRoute BlockChain::insertWithoutParent(bytes const& _block, bytesConstRef _receipts, u256 const& _totalDifficulty)
@@ -844,7 +939,7 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
 
         _performanceLogger.onStageFinished("collation");
 
-        blocksWriteBatch->insert(toSlice(_block.info.hash()), db::Slice(_block.block));
+        insertChainData(*blocksWriteBatch, toSlice(_block.info.hash()), _block.block);
         DEV_READ_GUARDED(x_details)
         extrasWriteBatch->insert(toSlice(_block.info.parentHash(), ExtraDetails),
             (db::Slice)dev::ref(m_details[_block.info.parentHash()].rlp()));
@@ -860,7 +955,7 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
         extrasWriteBatch->insert(
             toSlice(_block.info.hash(), ExtraLogBlooms), (db::Slice)dev::ref(blb.rlp()));
 
-        extrasWriteBatch->insert(toSlice(_block.info.hash(), ExtraReceipts), (db::Slice)_receipts);
+        insertChainData(*extrasWriteBatch, toSlice(_block.info.hash(), ExtraReceipts), _receipts);
 
         _performanceLogger.onStageFinished("writing");
     }
@@ -891,6 +986,7 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
 
         // Go through ret backwards (i.e. from new head to common) until hash != last.parent and
         // update m_transactionAddresses, m_blockHashes
+        vector<pair<unsigned, LogBloom>> blockBlooms;
         for (auto i = route.rbegin(); i != route.rend() && *i != common; ++i)
         {
             BlockHeader tbi;
@@ -900,23 +996,10 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
                 tbi = BlockHeader(block(*i));
 
             // Collate logs into blooms.
-            h256s alteredBlooms;
             {
-                LogBloom blockBloom = tbi.logBloom();
-                blockBloom.shiftBloom<3>(sha3(tbi.author().ref()));
-
-                // Pre-memoize everything we need before locking x_blocksBlooms
-                for (unsigned level = 0, index = (unsigned)tbi.number(); level < c_bloomIndexLevels; level++, index /= c_bloomIndexSize)
-                    blocksBlooms(chunkId(level, index / c_bloomIndexSize));
-
-                WriteGuard l(x_blocksBlooms);
-                for (unsigned level = 0, index = (unsigned)tbi.number(); level < c_bloomIndexLevels; level++, index /= c_bloomIndexSize)
-                {
-                    unsigned i = index / c_bloomIndexSize;
-                    unsigned o = index % c_bloomIndexSize;
-                    alteredBlooms.push_back(chunkId(level, i));
-                    m_blocksBlooms[alteredBlooms.back()].blooms[o] |= blockBloom;
-                }
+                LogBloom bloom = tbi.logBloom();
+                bloom.shiftBloom<3>(sha3(tbi.author().ref()));
+                blockBlooms.emplace_back((unsigned)tbi.number(), bloom);
             }
             // Collate transaction hashes and remember who they were.
             //h256s newTransactionAddresses;
@@ -932,14 +1015,14 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
             }
 
             // Update database with them.
-            ReadGuard l1(x_blocksBlooms);
-            for (auto const& h: alteredBlooms)
-                extrasWriteBatch->insert(
-                    toSlice(h, ExtraBlocksBlooms), (db::Slice)dev::ref(m_blocksBlooms[h].rlp()));
             extrasWriteBatch->insert(toSlice(h256(tbi.number()), ExtraBlockHash),
                 (db::Slice)dev::ref(BlockHash(tbi.hash()).rlp()));
         }
 
+        // The index takes the blocks in order, from the one after the common ancestor.
+        for (auto i = blockBlooms.rbegin(); i != blockBlooms.rend(); ++i)
+            m_bloomBits.append(i->first, i->second, *extrasWriteBatch);
+
         // FINALLY! change our best hash.
         {
             newLastBlockHash = _block.info.hash();
@@ -959,6 +1042,8 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
                             << _block.info.number() << ")";
     }
 
+    _performanceLogger.onStageFinished("checkBest");
+
     try
     {
         m_blocksDB->commit(std::move(blocksWriteBatch));
@@ -999,7 +1084,7 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
             }
         }
 
-    _performanceLogger.onStageFinished("checkBest");
+    _performanceLogger.onStageFinished("databaseCommit");
 
     unsigned const gasPerSecond = static_cast<double>(_block.info.gasUsed()) / _performanceLogger.stageDuration("enactment");
     _performanceLogger.onFinished({
@@ -1010,8 +1095,8 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
         {"gasUsed", toString(_block.info.gasUsed())}
     });
 
-    if (!route.empty())
-        noteCanonChanged();
+    if (m_onImportStages)
+        m_onImportStages(_block, _performanceLogger.stages());
 
     if (isImportedAndBest && m_onBlockImport)
         m_onBlockImport(_block.info);
@@ -1029,44 +1114,34 @@ ImportRoute BlockChain::insertBlockAndExtras(VerifiedBlockRef const& _block, byt
     return ImportRoute{dead, fresh, _block.transactions};
 }
 
-void BlockChain::clearBlockBlooms(unsigned _begin, unsigned _end)
+void BlockChain::recompressChainData(ProgressCallback const& _progress)
 {
-    //   ... c c c c c c c c c c C o o o o o o
-    //   ...                               /=15        /=21
-    // L0...| ' | ' | ' | ' | ' | ' | ' | 'b|x'x|x'x|x'e| /=11
-    // L1...|   '   |   '   |   '   |   ' b | x ' x | x ' e |   /=6
-    // L2...|       '       |       '   b   |   x   '   x   |   e   /=3
-    // L3...|               '       b       |       x       '       e
-    // model: c_bloomIndexLevels = 4, c_bloomIndexSize = 2
-
-    //   ...                               /=15        /=21
-    // L0...| ' ' ' | ' ' ' | ' ' ' | ' ' 'b|x'x'x'x|x'e' ' |
-    // L1...|       '       '       '   b   |   x   '   x   '   e   '       |
-    // L2...|               b               '               x               '                e              '                               |
-    // model: c_bloomIndexLevels = 2, c_bloomIndexSize = 4
-
-    // algorithm doesn't have the best memoisation coherence, but eh well...
-
-    unsigned beginDirty = _begin;
-    unsigned endDirty = _end;
-    for (unsigned level = 0; level < c_bloomIndexLevels; level++, beginDirty /= c_bloomIndexSize, endDirty = (endDirty - 1) / c_bloomIndexSize + 1)
-    {
-        // compute earliest & latest index for each level, rebuild from previous levels.
-        for (unsigned item = beginDirty; item != endDirty; ++item)
+    bool const compress = chainDataCompression();
+    auto const recompress = [compress](db::DatabaseFace& _db, db::WriteBatchFace& _batch,
+                                db::Slice _key) {
+        string value = _db.lookup(_key);
+        if (value.empty() || isCompressedChainData(value) == compress)
+            return;
+        uncompressChainData(value);
+        insertChainData(_batch, _key, bytesConstRef(&value));
+    };
+
+    unsigned const head = number();
+    std::unique_ptr<db::WriteBatchFace> blocksWriteBatch = m_blocksDB->createWriteBatch();
+    std::unique_ptr<db::WriteBatchFace> extrasWriteBatch = m_extrasDB->createWriteBatch();
+    for (unsigned n = 1; n <= head; ++n)
+    {
+        h256 const hash = numberHash(n);
+        recompress(*m_blocksDB, *blocksWriteBatch, toSlice(hash));
+        recompress(*m_extrasDB, *extrasWriteBatch, toSlice(hash, ExtraReceipts));
+        if (n % 1000 == 0 || n == head)
         {
-            unsigned bunch = item / c_bloomIndexSize;
-            unsigned offset = item % c_bloomIndexSize;
-            auto id = chunkId(level, bunch);
-            LogBloom acc;
-            if (!!level)
-            {
-                // rebuild the bloom from the previous (lower) level (if there is one).
-                auto lowerChunkId = chunkId(level - 1, item);
-                for (auto const& bloom: blocksBlooms(lowerChunkId).blooms)
-                    acc |= bloom;
-            }
-            blocksBlooms(id);   // make sure it has been memoized.
-            m_blocksBlooms[id].blooms[offset] = acc;
+            m_blocksDB->commit(std::move(blocksWriteBatch));
+            m_extrasDB->commit(std::move(extrasWriteBatch));
+            blocksWriteBatch = m_blocksDB->createWriteBatch();
+            extrasWriteBatch = m_extrasDB->createWriteBatch();
+            if (_progress)
+                _progress(n, head);
         }
     }
 }
@@ -1142,7 +1217,6 @@ void BlockChain::rewind(unsigned _newHead)
             cwarn << "Fail writing to extras database. Bombing out.";
             exit(-1);
         }
-        noteCanonChanged();
     }
 }
 
@@ -1227,12 +1301,9 @@ void BlockChain::updateStats() const
     DEV_READ_GUARDED(x_details)
         m_lastStats.memDetails = getHashSize(m_details);
     size_t logBloomsSize = 0;
-    size_t blocksBloomsSize = 0;
     DEV_READ_GUARDED(x_logBlooms)
         logBloomsSize = getHashSize(m_logBlooms);
-    DEV_READ_GUARDED(x_blocksBlooms)
-        blocksBloomsSize = getHashSize(m_blocksBlooms);
-    m_lastStats.memLogBlooms = logBloomsSize + blocksBloomsSize;
+    m_lastStats.memLogBlooms = logBloomsSize + m_bloomBits.memoryUsage();
     DEV_READ_GUARDED(x_receipts)
         m_lastStats.memReceipts = getHashSize(m_receipts);
     DEV_READ_GUARDED(x_blockHashes)
@@ -1295,12 +1366,6 @@ void BlockChain::garbageCollect(bool _force)
             m_transactionAddresses.erase(id.first);
             break;
         }
-        case ExtraBlocksBlooms:
-        {
-            WriteGuard l(x_blocksBlooms);
-            m_blocksBlooms.erase(id.first);
-            break;
-        }
         }
     }
     m_cacheUsage.pop_back();
@@ -1343,78 +1408,27 @@ void BlockChain::clearCachesDuringChainReversion(unsigned _firstInvalid)
     DEV_WRITE_GUARDED(x_transactionAddresses)
         m_transactionAddresses.clear(); // TODO: could perhaps delete them individually?
 
-    // If we are reverting previous blocks, we need to clear their blooms (in particular, to
-    // rebuild any higher level blooms that they contributed to).
-    clearBlockBlooms(_firstInvalid, end);
+    // If we are reverting previous blocks, we need to remove their blooms from the index.
+    m_bloomBits.rewind(_firstInvalid, [this](unsigned _number) { return blockBloom(_number); });
 }
 
-static inline unsigned upow(unsigned a, unsigned b) { if (!b) return 1; while (--b > 0) a *= a; return a; }
-static inline unsigned ceilDiv(unsigned n, unsigned d) { return (n + d - 1) / d; }
-//static inline unsigned floorDivPow(unsigned n, unsigned a, unsigned b) { return n / upow(a, b); }
-//static inline unsigned ceilDivPow(unsigned n, unsigned a, unsigned b) { return ceilDiv(n, upow(a, b)); }
-
-// Level 1
-// [xxx.            ]
-
-// Level 0
-// [.x............F.]
-// [........x.......]
-// [T.............x.]
-// [............    ]
-
-// F = 14. T = 32
-
-vector<unsigned> BlockChain::withBlockBloom(LogBloom const& _b, unsigned _earliest, unsigned _latest) const
-{
-    vector<unsigned> ret;
-
-    // start from the top-level
-    unsigned u = upow(c_bloomIndexSize, c_bloomIndexLevels);
-
-    // run through each of the top-level blockbloom blocks
-    for (unsigned index = _earliest / u; index <= ceilDiv(_latest, u); ++index)             // 0
-        ret += withBlockBloom(_b, _earliest, _latest, c_bloomIndexLevels - 1, index);
-
-    return ret;
-}
-
-vector<unsigned> BlockChain::withBlockBloom(LogBloom const& _b, unsigned _earliest, unsigned _latest, unsigned _level, unsigned _index) const
+LogBloom BlockChain::blockBloom(unsigned _number) const
 {
-    // 14, 32, 1, 0
-        // 14, 32, 0, 0
-        // 14, 32, 0, 1
-        // 14, 32, 0, 2
-
-    vector<unsigned> ret;
-
-    unsigned uCourse = upow(c_bloomIndexSize, _level + 1);
-    // 256
-        // 16
-    unsigned uFine = upow(c_bloomIndexSize, _level);
-    // 16
-        // 1
-
-    unsigned obegin = _index == _earliest / uCourse ? _earliest / uFine % c_bloomIndexSize : 0;
-    // 0
-        // 14
-        // 0
-        // 0
-    unsigned oend = _index == _latest / uCourse ? (_latest / uFine) % c_bloomIndexSize + 1 : c_bloomIndexSize;
-    // 3
-        // 16
-        // 16
-        // 1
-
-    BlocksBlooms bb = blocksBlooms(_level, _index);
-    for (unsigned o = obegin; o < oend; ++o)
-        if (bb.blooms[o].contains(_b))
-        {
-            // This level has something like what we want.
-            if (_level > 0)
-                ret += withBlockBloom(_b, _earliest, _latest, _level - 1, o + _index * c_bloomIndexSize);
-            else
-                ret.push_back(o + _index * c_bloomIndexSize);
-        }
+    h256 const hash = numberHash(_number);
+    BlockHeader header;
+    if (hash == m_genesisHash)
+        header = genesis();
+    else
+    {
+        // Read around the block cache, since a whole section of the chain is indexed at once.
+        string data = hash ? m_blocksDB->lookup(toSlice(hash)) : string();
+        if (data.empty())
+            return LogBloom();
+        uncompressChainData(data);
+        header = BlockHeader(bytesConstRef(&data));
+    }
+    LogBloom ret = header.logBloom();
+    ret.shiftBloom<3>(sha3(header.author().ref()));
     return ret;
 }
 
@@ -1465,12 +1479,13 @@ bytes BlockChain::block(h256 const& _hash) const
             return it->second;
     }
 
-    string const d = m_blocksDB->lookup(toSlice(_hash));
+    string d = m_blocksDB->lookup(toSlice(_hash));
     if (d.empty())
     {
         cwarn << "Couldn't find requested block:" << _hash;
         return bytes();
     }
+    uncompressChainData(d);
 
     noteUsed(_hash);
 
@@ -1493,12 +1508,13 @@ bytes BlockChain::headerData(h256 const& _hash) const
             return BlockHeader::extractHeader(&it->second).data().toBytes();
     }
 
-    string const d = m_blocksDB->lookup(toSlice(_hash));
+    string d = m_blocksDB->lookup(toSlice(_hash));
     if (d.empty())
     {
         cwarn << "Couldn't find requested block:" << _hash;
         return bytes();
     }
+    uncompressChainData(d);
 
     noteUsed(_hash);
 
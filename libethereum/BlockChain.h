@@ -7,6 +7,8 @@
 #include "Account.h"
 #include "BlockDetails.h"
 #include "BlockQueue.h"
+#include "BloomBitsIndex.h"
+#include "ChainDataCompression.h"
 #include "ChainParams.h"
 #include "DatabasePaths.h"
 #include "LastBlockHashesFace.h"
@@ -48,6 +50,9 @@ class State;
 class Block;
 class ImportPerformanceLogger;
 
+/// Durations in seconds of the stages of a block import, keyed by stage name.
+using ImportStageDurations = std::unordered_map<std::string, double>;
+
 DEV_SIMPLE_EXCEPTION(AlreadyHaveBlock);
 DEV_SIMPLE_EXCEPTION(FutureTime);
 DEV_SIMPLE_EXCEPTION(TransientError);
@@ -70,7 +75,8 @@ enum {
     ExtraTransactionAddress,
     ExtraLogBlooms,
     ExtraReceipts,
-    ExtraBlocksBlooms
+    ExtraBlocksBlooms,  ///< No longer written; the index has been replaced by ExtraBloomBits.
+    ExtraBloomBits
 };
 
 using ProgressCallback = std::function<void(unsigned, unsigned)>;
@@ -181,25 +187,14 @@ public:
 
     int chainID() const { return m_params.chainID; }
 
-    /** Get the block blooms for a number of blocks. Thread-safe.
-     * @returns the object pertaining to the blocks:
-     * level 0:
-     * 0x, 0x + 1, .. (1x - 1)
-     * 1x, 1x + 1, .. (2x - 1)
-     * ...
-     * (255x .. (256x - 1))
-     * level 1:
-     * 0x .. (1x - 1), 1x .. (2x - 1), ..., (255x .. (256x - 1))
-     * 256x .. (257x - 1), 257x .. (258x - 1), ..., (511x .. (512x - 1))
-     * ...
-     * level n, index i, offset o:
-     * i * (x ^ n) + o * x ^ (n - 1)
-     */
-    BlocksBlooms blocksBlooms(unsigned _level, unsigned _index) const { return blocksBlooms(chunkId(_level, _index)); }
-    BlocksBlooms blocksBlooms(h256 const& _chunkId) const { return queryExtras<BlocksBlooms, ExtraBlocksBlooms>(_chunkId, m_blocksBlooms, x_blocksBlooms, NullBlocksBlooms); }
-    LogBloom blockBloom(unsigned _number) const { return blocksBlooms(chunkId(0, _number / c_bloomIndexSize)).blooms[_number % c_bloomIndexSize]; }
-    std::vector<unsigned> withBlockBloom(LogBloom const& _b, unsigned _earliest, unsigned _latest) const;
-    std::vector<unsigned> withBlockBloom(LogBloom const& _b, unsigned _earliest, unsigned _latest, unsigned _topLevel, unsigned _index) const;
+    /// Get the bloom of the logs and the author of a block on the canonical chain, as indexed for
+    /// withBlockBloom(). Thread-safe.
+    LogBloom blockBloom(unsigned _number) const;
+    /// @returns the numbers, in increasing order, of the blocks on the canonical chain between
+    /// @a _earliest and @a _latest whose blockBloom() contains @a _b, or any of @a _blooms.
+    /// Thread-safe.
+    std::vector<unsigned> withBlockBloom(LogBloom const& _b, unsigned _earliest, unsigned _latest) const { return withBlockBloom(LogBlooms{_b}, _earliest, _latest); }
+    std::vector<unsigned> withBlockBloom(LogBlooms const& _blooms, unsigned _earliest, unsigned _latest) const { return m_bloomBits.matching(_blooms, _earliest, _latest); }
 
     /// Returns true if transaction is known. Thread-safe
     bool isKnownTransaction(h256 const& _transactionHash) const { TransactionAddress ta = queryExtras<TransactionAddress, ExtraTransactionAddress>(_transactionHash, m_transactionAddresses, x_transactionAddresses, NullTransactionAddress); return !!ta; }
@@ -239,6 +234,11 @@ public:
     /// Alter the head of the chain to some prior block along it.
     void rewind(unsigned _newHead);
 
+    /// Rewrite the bodies and receipts of the blocks of the canonical chain that aren't stored as
+    /// chainDataCompression() asks for. Those of other blocks are left as they are, since either
+    /// form can be read.
+    void recompressChainData(ProgressCallback const& _progress = ProgressCallback());
+
     /// Rescue the database.
     void rescue(OverlayDB const& _db);
 
@@ -291,6 +291,13 @@ public:
     /// Change the function that is called when a new block is imported
     void setOnBlockImport(std::function<void(BlockHeader const&)> _t) { m_onBlockImport = _t; }
 
+    /// Change the function that is called after each block import or insertion with the
+    /// durations in seconds of the import stages, keyed by stage name, including "total".
+    void setOnImportStages(std::function<void(VerifiedBlockRef const&, ImportStageDurations const&)> _t)
+    {
+        m_onImportStages = _t;
+    }
+
     /// Get a pre-made genesis State object.
     Block genesisBlock(OverlayDB const& _db) const;
 
@@ -312,8 +319,6 @@ public:
     void setChainStartBlockNumber(unsigned _number);
 
 private:
-    static h256 chunkId(unsigned _level, unsigned _index) { return h256(_index * 0xff + _level); }
-
     /// Initialise everything and ready for openning the database.
     void init(ChainParams const& _p);
     /// Open the database. Returns whether or not the database needs to be rebuilt.
@@ -323,6 +328,8 @@ private:
     /// Finalise everything and close the database.
     void close();
 
+    ImportRoute import(VerifiedBlockRef const& _block, OverlayDB const& _db, bool _mustBeNew,
+        ImportPerformanceLogger& _performanceLogger);
     ImportRoute insertBlockAndExtras(VerifiedBlockRef const& _block, bytesConstRef _receipts, u256 const& _totalDifficulty, ImportPerformanceLogger& _performanceLogger);
     void checkBlockIsNew(VerifiedBlockRef const& _block) const;
     void checkBlockTimestamp(BlockHeader const& _header) const;
@@ -338,9 +345,11 @@ private:
                 return it->second;
         }
 
-        std::string const s = (_extrasDB ? _extrasDB : m_extrasDB.get())->lookup(toSlice(_h, N));
+        std::string s = (_extrasDB ? _extrasDB : m_extrasDB.get())->lookup(toSlice(_h, N));
         if (s.empty())
             return _n;
+        if (N == ExtraReceipts)
+            uncompressChainData(s);
 
         noteUsed(_h, N);
 
@@ -361,7 +370,6 @@ private:
     /// Clears all caches from the tip of the chain up to (including) _firstInvalid.
     /// These include the blooms, the block hashes and the transaction lookup tables.
     void clearCachesDuringChainReversion(unsigned _firstInvalid);
-    void clearBlockBlooms(unsigned _begin, unsigned _end);
 
     /// The caches of the disk DB and their locks.
     mutable SharedMutex x_blocks;
@@ -376,8 +384,9 @@ private:
     mutable TransactionAddressHash m_transactionAddresses;
     mutable SharedMutex x_blockHashes;
     mutable BlockHashHash m_blockHashes;
-    mutable SharedMutex x_blocksBlooms;
-    mutable BlocksBloomsHash m_blocksBlooms;
+
+    /// Index of the blooms of the canonical blocks, kept in the extras DB.
+    BloomBitsIndex m_bloomBits{ExtraBloomBits};
 
     using CacheID = std::pair<h256, unsigned>;
     mutable Mutex x_cacheUsage;
@@ -387,7 +396,6 @@ private:
     void noteUsed(uint64_t const& _h, unsigned _extra = (unsigned)-1) const { (void)_h; (void)_extra; } // don't note non-hash types
     std::chrono::system_clock::time_point m_lastCollection;
 
-    void noteCanonChanged() const { m_lastBlockHashes->clear(); }
     std::unique_ptr<LastBlockHashesFace> m_lastBlockHashes;
 
     void updateStats() const;
@@ -413,6 +421,7 @@ private:
 
     std::function<void(Exception&)> m_onBad;                                    ///< Called if we have a block that doesn't verify.
     std::function<void(BlockHeader const&)> m_onBlockImport;                                        ///< Called if we have imported a new block into the db
+    std::function<void(VerifiedBlockRef const&, ImportStageDurations const&)> m_onImportStages;  ///< Called with the stage durations of each import
 
     mutable Logger m_logger{createLogger(VerbosityDebug, "chain")};
     mutable Logger m_loggerDetail{createLogger(VerbosityTrace, "chain")};
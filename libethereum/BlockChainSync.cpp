@@ -5,9 +5,12 @@
 #include "BlockChainSync.h"
 
 #include "BlockChain.h"
+#include "BlockChainImporter.h"
 #include "BlockQueue.h"
 #include "EthereumCapability.h"
+#include "StateDownloader.h"
 #include <libdevcore/Common.h>
+#include <libdevcore/CommonIO.h>
 #include <libdevcore/TrieHash.h>
 #include <libethcore/Exceptions.h>
 #include <libp2p/Host.h>
@@ -33,6 +36,20 @@ namespace  // Helper functions.
 constexpr unsigned c_maxPeerUknownNewBlocks = 1024; /// Max number of unknown new blocks peer can give us
 constexpr unsigned c_maxRequestHeaders = 1024;
 constexpr unsigned c_maxRequestBodies = 1024;
+constexpr unsigned c_initialRequestBodies = 128;  ///< Body request size for peers we haven't timed yet
+constexpr unsigned c_minRequestBodies = 16;
+constexpr double c_targetResponseTime = 2.0;  ///< Seconds a body request should take to be answered
+constexpr double c_minStragglerTime = 3.0;    ///< Seconds before a body request can be reassigned
+constexpr double c_statsWeight = 0.25;        ///< Weight of the latest sample in the moving averages
+constexpr unsigned c_maxRequestReceipts = 256;
+constexpr unsigned c_maxRequestNodes = 384;
+/// Distance of the fast sync pivot from the best known block. Peers keep the state of recent
+/// blocks only.
+constexpr unsigned c_pivotDistance = 64;
+/// Minimum number of blocks to import without execution for fast sync to be worth it
+constexpr unsigned c_minFastSyncBlocks = 1024;
+/// Distance the best known block can move ahead of the pivot before the state download follows it
+constexpr unsigned c_pivotMoveDistance = 128;
 
 template<typename T> bool haveItem(std::map<unsigned, T>& _container, unsigned _number)
 {
@@ -137,6 +154,24 @@ template<typename T> void mergeInto(std::map<unsigned, std::vector<T>>& _contain
 
 }  // Anonymous namespace -- helper functions.
 
+unsigned dev::eth::bodyRequestSize(double _throughput)
+{
+    if (_throughput == 0)
+        return c_initialRequestBodies;
+    double const size = _throughput * c_targetResponseTime;
+    return static_cast<unsigned>(
+        max<double>(c_minRequestBodies, min<double>(c_maxRequestBodies, size)));
+}
+
+bool dev::eth::isStraggler(double _elapsed, unsigned _requestedItems, double _ownerThroughput,
+    double _requesterThroughput)
+{
+    double const expected =
+        _ownerThroughput > 0 ? _requestedItems / _ownerThroughput : c_targetResponseTime;
+    return _elapsed >= max(c_minStragglerTime, 2 * expected) &&
+           _requesterThroughput > _ownerThroughput;
+}
+
 BlockChainSync::BlockChainSync(EthereumCapability& _host)
   : m_host(_host),
     m_chainStartBlock(_host.chain().chainStartBlockNumber()),
@@ -270,6 +305,8 @@ void BlockChainSync::syncPeer(NodeID const& _peerID, bool _force)
             LOG(m_loggerInfo) << "Starting full sync";
             LOG(m_logger) << "Syncing with peer " << peer.id();
             m_state = SyncState::Blocks;
+            if (m_pivotBlock != 0 && m_lastImportedBlock == m_pivotBlock)
+                startStateDownload();
         }
         
         // Request tip of peer's chain
@@ -283,6 +320,9 @@ void BlockChainSync::syncPeer(NodeID const& _peerID, bool _force)
         requestBlocks(_peerID);
         return;
     }
+
+    if (m_state == SyncState::State)
+        requestState(_peerID);
 }
 
 void BlockChainSync::continueSync()
@@ -310,7 +350,8 @@ void BlockChainSync::requestBlocks(NodeID const& _peerID)
     unsigned index = 0;
     if (m_haveCommonHeader && !m_headers.empty() && m_headers.begin()->first == m_lastImportedBlock + 1)
     {
-        while (header != m_headers.end() && neededBodies.size() < c_maxRequestBodies && index < header->second.size())
+        unsigned const maxBodies = bodyRequestSize(_peerID);
+        while (header != m_headers.end() && neededBodies.size() < maxBodies && index < header->second.size())
         {
             unsigned block = header->first + index;
             if (m_downloadingBodies.count(block) == 0 && !haveItem(m_bodies, block))
@@ -328,9 +369,10 @@ void BlockChainSync::requestBlocks(NodeID const& _peerID)
     if (neededBodies.size() > 0)
     {
         m_bodySyncPeers[_peerID] = neededNumbers;
+        noteRequest(_peerID, neededBodies.size(), true);
         m_host.peer(_peerID).requestBlockBodies(neededBodies);
     }
-    else
+    else if (!requestReceipts(_peerID) && !reassignStraggler(_peerID))
     {
         // check if need to download headers
         unsigned start = 0;
@@ -377,6 +419,7 @@ void BlockChainSync::requestBlocks(NodeID const& _peerID)
                 {
                     m_headerSyncPeers[_peerID] = headers;
                     assert(!haveItem(m_headers, start));
+                    noteRequest(_peerID, count, false);
                     m_host.peer(_peerID).requestBlockHeaders(start, count, 0, false);
                 }
                 else if (start >= next->first)
@@ -407,6 +450,15 @@ void BlockChainSync::clearPeerDownload(NodeID const& _peerID)
             m_downloadingBodies.erase(block);
         m_bodySyncPeers.erase(syncPeer);
     }
+    syncPeer = m_receiptSyncPeers.find(_peerID);
+    if (syncPeer != m_receiptSyncPeers.end())
+    {
+        for (unsigned block : syncPeer->second)
+            m_downloadingReceipts.erase(block);
+        m_receiptSyncPeers.erase(syncPeer);
+    }
+    if (m_stateDownloader)
+        m_stateDownloader->releasePeer(_peerID);
     m_daoChallengedPeers.erase(_peerID);
 }
 
@@ -434,6 +486,21 @@ void BlockChainSync::clearPeerDownload()
         else
             ++s;
     }
+    for (auto s = m_receiptSyncPeers.begin(); s != m_receiptSyncPeers.end();)
+    {
+        if (!m_host.capabilityHost().peerSessionInfo(s->first))
+        {
+            for (unsigned block : s->second)
+                m_downloadingReceipts.erase(block);
+            m_receiptSyncPeers.erase(s++);
+        }
+        else
+            ++s;
+    }
+    if (m_stateDownloader)
+        for (auto const& peerID : m_stateDownloader->requestingPeers())
+            if (!m_host.capabilityHost().peerSessionInfo(peerID))
+                m_stateDownloader->releasePeer(peerID);
     for (auto s = m_daoChallengedPeers.begin(); s != m_daoChallengedPeers.end();)
     {
         if (!m_host.capabilityHost().peerSessionInfo(*s))
@@ -441,6 +508,293 @@ void BlockChainSync::clearPeerDownload()
         else
             ++s;
     }
+    for (auto s = m_peerStats.begin(); s != m_peerStats.end();)
+    {
+        if (!m_host.capabilityHost().peerSessionInfo(s->first))
+            m_peerStats.erase(s++);
+        else
+            ++s;
+    }
+}
+
+void BlockChainSync::noteRequest(NodeID const& _peerID, unsigned _count, bool _bodies)
+{
+    auto& stats = m_peerStats[_peerID];
+    stats.status.id = _peerID;
+    stats.requestTime = chrono::steady_clock::now();
+    stats.requestedItems = _count;
+    stats.requestedBodies = _bodies;
+    stats.awaitingResponse = true;
+}
+
+void BlockChainSync::noteResponse(NodeID const& _peerID, size_t _itemCount)
+{
+    auto it = m_peerStats.find(_peerID);
+    if (it == m_peerStats.end() || !it->second.awaitingResponse)
+        return;
+
+    auto& stats = it->second;
+    stats.awaitingResponse = false;
+    double const rtt =
+        chrono::duration<double>(chrono::steady_clock::now() - stats.requestTime).count();
+    double const throughput = _itemCount / max(rtt, 0.001);
+
+    PeerSyncStatus& status = stats.status;
+    bool const first = status.responses == 0;
+    status.rtt = first ? rtt : (1 - c_statsWeight) * status.rtt + c_statsWeight * rtt;
+    // Only bodies are sized adaptively, and partial answers tell little about how fast a peer
+    // could deliver a full request.
+    if (stats.requestedBodies && (status.throughput == 0 || _itemCount >= stats.requestedItems))
+        status.throughput = status.throughput == 0 ?
+                                throughput :
+                                (1 - c_statsWeight) * status.throughput + c_statsWeight * throughput;
+    ++status.responses;
+    status.itemsReceived += _itemCount;
+    status.requestSize = bodyRequestSize(_peerID);
+
+    auto& capabilityHost = m_host.capabilityHost();
+    capabilityHost.addNote(
+        _peerID, "sync.rtt", toString(static_cast<unsigned>(status.rtt * 1000)) + "ms");
+    capabilityHost.addNote(
+        _peerID, "sync.throughput", toString(static_cast<unsigned>(status.throughput)) + "/s");
+    capabilityHost.addNote(_peerID, "sync.requestSize", toString(status.requestSize));
+}
+
+unsigned BlockChainSync::bodyRequestSize(NodeID const& _peerID) const
+{
+    auto it = m_peerStats.find(_peerID);
+    return eth::bodyRequestSize(it == m_peerStats.end() ? 0 : it->second.status.throughput);
+}
+
+bool BlockChainSync::reassignStraggler(NodeID const& _peerID)
+{
+    // Bodies are imported in order, so the request holding the lowest block is the one stalling
+    // the import.
+    auto owner = m_bodySyncPeers.end();
+    unsigned lowest = numeric_limits<unsigned>::max();
+    for (auto it = m_bodySyncPeers.begin(); it != m_bodySyncPeers.end(); ++it)
+        if (it->first != _peerID && !it->second.empty() && it->second.front() < lowest)
+        {
+            lowest = it->second.front();
+            owner = it;
+        }
+    if (owner == m_bodySyncPeers.end())
+        return false;
+
+    auto const ownerStats = m_peerStats.find(owner->first);
+    if (ownerStats == m_peerStats.end() || !ownerStats->second.awaitingResponse ||
+        !ownerStats->second.requestedBodies)
+        return false;
+    double const elapsed =
+        chrono::duration<double>(chrono::steady_clock::now() - ownerStats->second.requestTime)
+            .count();
+    auto const requesterStats = m_peerStats.find(_peerID);
+    double const requesterThroughput =
+        requesterStats == m_peerStats.end() ? 0 : requesterStats->second.status.throughput;
+    if (!isStraggler(elapsed, ownerStats->second.requestedItems,
+            ownerStats->second.status.throughput, requesterThroughput))
+        return false;
+
+    NodeID const ownerID = owner->first;
+    h256s hashes;
+    vector<unsigned> numbers;
+    for (unsigned block : owner->second)
+    {
+        auto const header = findItem(m_headers, block);
+        if (header && !haveItem(m_bodies, block))
+        {
+            hashes.push_back(header->hash);
+            numbers.push_back(block);
+        }
+        else
+            m_downloadingBodies.erase(block);
+    }
+    m_bodySyncPeers.erase(owner);
+    if (hashes.empty())
+        return false;
+
+    LOG(m_logger) << "Re-requesting " << hashes.size() << " block bodies from " << _peerID
+                  << " after waiting " << elapsed << " s for " << ownerID;
+    ++ownerStats->second.status.reassigned;
+    // The blocks stay in m_downloadingBodies; whichever peer answers first provides them.
+    m_bodySyncPeers[_peerID] = numbers;
+    noteRequest(_peerID, hashes.size(), true);
+    m_host.peer(_peerID).requestBlockBodies(hashes);
+    return true;
+}
+
+void BlockChainSync::enableFastSync(std::unique_ptr<BlockChainImporterFace> _importer)
+{
+    RecursiveGuard l(x_sync);
+    m_fastSyncImporter = move(_importer);
+
+    // The head has no state if a previous fast sync was interrupted during the state download.
+    BlockHeader const head = host().chain().info();
+    if (!host().db().exists(head.stateRoot()))
+    {
+        LOG(m_loggerInfo) << "State of block #" << head.number()
+                          << " is incomplete, resuming its download";
+        m_pivotBlock = static_cast<unsigned>(head.number());
+    }
+}
+
+void BlockChainSync::updatePivot()
+{
+    if (!m_fastSyncImporter || m_highestBlock < c_pivotDistance)
+        return;
+
+    unsigned const pivot = m_highestBlock - c_pivotDistance;
+    if (m_pivotBlock == 0)
+    {
+        if (m_haveCommonHeader && pivot >= m_lastImportedBlock + c_minFastSyncBlocks)
+        {
+            LOG(m_loggerInfo) << "Starting fast sync, importing blocks up to #" << pivot
+                              << " without execution";
+            m_pivotBlock = pivot;
+        }
+    }
+    else if (m_state == SyncState::State && pivot >= m_pivotBlock + c_pivotMoveDistance)
+    {
+        // Catch up with the chain, as peers keep the state of recent blocks only. Whatever has
+        // been downloaded of the old state stays in the database and is not fetched again.
+        LOG(m_loggerInfo) << "Moving fast sync pivot from #" << m_pivotBlock << " to #" << pivot;
+        m_pivotBlock = pivot;
+        m_state = SyncState::Blocks;
+    }
+}
+
+bool BlockChainSync::requestReceipts(NodeID const& _peerID)
+{
+    if (m_pivotBlock <= m_lastImportedBlock || !m_haveCommonHeader || m_headers.empty() ||
+        m_headers.begin()->first != m_lastImportedBlock + 1)
+        return false;
+
+    auto const& headers = *m_headers.begin();
+    h256s neededReceipts;
+    vector<unsigned> neededNumbers;
+    for (size_t i = 0; i < headers.second.size() && neededReceipts.size() < c_maxRequestReceipts;
+         ++i)
+    {
+        unsigned const block = headers.first + static_cast<unsigned>(i);
+        if (block > m_pivotBlock)
+            break;
+        if (m_downloadingReceipts.count(block) || m_receipts.count(block))
+            continue;
+        // Blocks without transactions have no receipts to download.
+        if (BlockHeader(headers.second[i].data, HeaderData).receiptsRoot() == EmptyTrie)
+            continue;
+        neededReceipts.push_back(headers.second[i].hash);
+        neededNumbers.push_back(block);
+        m_downloadingReceipts.insert(block);
+    }
+    if (neededReceipts.empty())
+        return false;
+
+    m_receiptSyncPeers[_peerID] = neededNumbers;
+    noteRequest(_peerID, neededReceipts.size(), false);
+    m_host.peer(_peerID).requestReceipts(neededReceipts);
+    return true;
+}
+
+void BlockChainSync::collectFastBlocks()
+{
+    auto& headers = *m_headers.begin();
+    auto& bodies = *m_bodies.begin();
+
+    u256 totalDifficulty = host().chain().details(m_lastImportedBlockHash).totalDifficulty;
+    size_t i = 0;
+    for (; i < headers.second.size() && i < bodies.second.size(); ++i)
+    {
+        unsigned const number = headers.first + static_cast<unsigned>(i);
+        if (number > m_pivotBlock)
+            break;
+
+        BlockHeader const header(headers.second[i].data, HeaderData);
+        bytes receipts = RLPEmptyList;
+        if (header.receiptsRoot() != EmptyTrie)
+        {
+            auto const downloaded = m_receipts.find(number);
+            if (downloaded == m_receipts.end())
+                break;
+            receipts = move(downloaded->second);
+            m_receipts.erase(downloaded);
+        }
+
+        totalDifficulty += header.difficulty();
+        RLP const body(bodies.second[i]);
+        try
+        {
+            m_fastSyncImporter->importBlock(
+                header, body[0], body[1], RLP(receipts), totalDifficulty);
+        }
+        catch (Exception const& _e)
+        {
+            LOG(m_loggerWarning) << "Failed to import block #" << number
+                                 << ", restarting sync: " << _e.what();
+            restartSync();
+            return;
+        }
+        m_lastImportedBlock = number;
+        m_lastImportedBlockHash = header.hash();
+    }
+
+    if (i == 0)
+        return;
+    LOG(m_logger) << "Imported " << i << " blocks without execution, up to #"
+                  << m_lastImportedBlock;
+
+    auto newHeaders = std::move(headers.second);
+    newHeaders.erase(newHeaders.begin(), newHeaders.begin() + i);
+    auto newBodies = std::move(bodies.second);
+    newBodies.erase(newBodies.begin(), newBodies.begin() + i);
+    m_headers.erase(m_headers.begin());
+    m_bodies.erase(m_bodies.begin());
+    if (!newHeaders.empty())
+        m_headers[m_lastImportedBlock + 1] = newHeaders;
+    if (!newBodies.empty())
+        m_bodies[m_lastImportedBlock + 1] = newBodies;
+
+    if (m_lastImportedBlock == m_pivotBlock)
+        startStateDownload();
+    DEV_INVARIANT_CHECK_HERE;
+}
+
+void BlockChainSync::startStateDownload()
+{
+    BlockHeader const pivot = host().chain().info(m_lastImportedBlockHash);
+    if (!m_stateDownloader)
+        m_stateDownloader.reset(new StateDownloader(host().db()));
+    m_stateDownloader->setRoot(pivot.stateRoot());
+
+    LOG(m_loggerInfo) << "Downloading state of block #" << pivot.number();
+    m_state = SyncState::State;
+    if (m_stateDownloader->isComplete())
+        completeStateDownload();
+}
+
+void BlockChainSync::requestState(NodeID const& _peerID)
+{
+    clearPeerDownload(_peerID);
+    h256s const nodes = m_stateDownloader->requestNodes(_peerID, c_maxRequestNodes);
+    if (nodes.empty())
+        return;
+
+    noteRequest(_peerID, nodes.size(), false);
+    m_host.peer(_peerID).requestNodeData(nodes);
+}
+
+void BlockChainSync::completeStateDownload()
+{
+    LOG(m_loggerInfo) << "State of block #" << m_pivotBlock << " downloaded ("
+                      << m_stateDownloader->downloadedNodes()
+                      << " nodes), continuing with full sync";
+    // Fast sync is done once, blocks are executed from now on.
+    m_stateDownloader.reset();
+    m_fastSyncImporter.reset();
+    m_pivotBlock = 0;
+    m_receipts.clear();
+    m_state = SyncState::Blocks;
+    collectBlocks();
 }
 
 void BlockChainSync::logNewBlock(h256 const& _h)
@@ -455,6 +809,7 @@ void BlockChainSync::onPeerBlockHeaders(NodeID const& _peerID, RLP const& _r)
     size_t itemCount = _r.itemCount();
     LOG(m_logger) << "BlocksHeaders (" << dec << itemCount << " entries) "
                   << (itemCount ? "" : ": NoMoreHeaders") << " from " << _peerID;
+    noteResponse(_peerID, itemCount);
 
     if (m_daoChallengedPeers.find(_peerID) != m_daoChallengedPeers.end())
     {
@@ -468,7 +823,9 @@ void BlockChainSync::onPeerBlockHeaders(NodeID const& _peerID, RLP const& _r)
     }
 
     clearPeerDownload(_peerID);
-    if (m_state != SyncState::Blocks && m_state != SyncState::Waiting)
+    // Headers of the chain head keep arriving while the state is downloaded.
+    if (m_state != SyncState::Blocks && m_state != SyncState::Waiting &&
+        m_state != SyncState::State)
     {
         LOG(m_logger) << "Ignoring unexpected blocks from " << _peerID;
         return;
@@ -581,6 +938,7 @@ void BlockChainSync::onPeerBlockHeaders(NodeID const& _peerID, RLP const& _r)
                 m_headerIdToNumber[headerId] = blockNumber;
         }
     }
+    updatePivot();
     collectBlocks();
     continueSync();
 }
@@ -602,6 +960,7 @@ void BlockChainSync::onPeerBlockBodies(NodeID const& _peerID, RLP const& _r)
     size_t itemCount = _r.itemCount();
     LOG(m_logger) << "BlocksBodies (" << dec << itemCount << " entries) "
                   << (itemCount ? "" : ": NoMoreBodies") << " from " << _peerID;
+    noteResponse(_peerID, itemCount);
     clearPeerDownload(_peerID);
     if (m_state != SyncState::Blocks && m_state != SyncState::Waiting) {
         LOG(m_logger) << "Ignoring unexpected blocks from " << _peerID;
@@ -645,6 +1004,81 @@ void BlockChainSync::onPeerBlockBodies(NodeID const& _peerID, RLP const& _r)
     continueSync();
 }
 
+void BlockChainSync::onPeerReceipts(NodeID const& _peerID, RLP const& _r)
+{
+    RecursiveGuard l(x_sync);
+    DEV_INVARIANT_CHECK;
+    size_t itemCount = _r.itemCount();
+    LOG(m_logger) << "Receipts (" << dec << itemCount << " entries) from " << _peerID;
+    noteResponse(_peerID, itemCount);
+
+    vector<unsigned> requested;
+    auto const syncPeer = m_receiptSyncPeers.find(_peerID);
+    if (syncPeer != m_receiptSyncPeers.end())
+        requested = syncPeer->second;
+    clearPeerDownload(_peerID);
+    if (m_state != SyncState::Blocks)
+    {
+        LOG(m_logger) << "Ignoring unexpected receipts from " << _peerID;
+        return;
+    }
+    if (itemCount == 0)
+    {
+        LOG(m_loggerDetail) << "Peer " << _peerID << " does not have the receipts requested";
+        m_host.capabilityHost().updateRating(_peerID, -1);
+    }
+    // Receipts come in the order of the request.
+    for (size_t i = 0; i < itemCount && i < requested.size(); ++i)
+    {
+        unsigned const blockNumber = requested[i];
+        Header const* header = findItem(m_headers, blockNumber);
+        if (!header || m_receipts.count(blockNumber))
+            continue;
+
+        RLP const receipts(_r[i]);
+        h256 const receiptsRoot = trieRootOver(receipts.itemCount(),
+            [&](unsigned _j) { return rlp(_j); },
+            [&](unsigned _j) { return receipts[_j].data().toBytes(); });
+        if (receiptsRoot != BlockHeader(header->data, HeaderData).receiptsRoot())
+        {
+            LOG(m_loggerDetail) << "Invalid receipts of block " << blockNumber << " from "
+                                << _peerID;
+            m_host.capabilityHost().updateRating(_peerID, -1);
+            continue;
+        }
+        m_receipts[blockNumber] = receipts.data().toBytes();
+    }
+    collectBlocks();
+    continueSync();
+}
+
+void BlockChainSync::onPeerNodeData(NodeID const& _peerID, RLP const& _r)
+{
+    RecursiveGuard l(x_sync);
+    DEV_INVARIANT_CHECK;
+    size_t itemCount = _r.itemCount();
+    LOG(m_logger) << "NodeData (" << dec << itemCount << " entries) from " << _peerID;
+    noteResponse(_peerID, itemCount);
+
+    if (!m_stateDownloader)
+    {
+        LOG(m_logger) << "Ignoring unexpected node data from " << _peerID;
+        return;
+    }
+    if (itemCount == 0)
+    {
+        LOG(m_loggerDetail) << "Peer " << _peerID << " does not have the state requested";
+        m_host.capabilityHost().updateRating(_peerID, -1);
+    }
+    m_stateDownloader->onNodeData(_peerID, _r);
+    LOG(m_logger) << "State download: " << m_stateDownloader->downloadedNodes()
+                  << " nodes stored, " << m_stateDownloader->pendingNodes() << " pending";
+
+    if (m_state == SyncState::State && m_stateDownloader->isComplete())
+        completeStateDownload();
+    continueSync();
+}
+
 void BlockChainSync::collectBlocks()
 {
     if (!m_haveCommonHeader || m_headers.empty() || m_bodies.empty())
@@ -656,6 +1090,14 @@ void BlockChainSync::collectBlocks()
     if (headers.first != bodies.first || headers.first != m_lastImportedBlock + 1)
         return;
 
+    if (headers.first <= m_pivotBlock)
+    {
+        collectFastBlocks();
+        return;
+    }
+    if (m_state == SyncState::State)
+        return;  // Blocks after the pivot can be executed only once its state is here
+
     unsigned success = 0;
     unsigned future = 0;
     unsigned got = 0;
@@ -849,6 +1291,11 @@ SyncStatus BlockChainSync::status() const
     res.startBlockNumber = m_startingBlock;
     res.currentBlockNumber = host().chain().number();
     res.highestBlockNumber = m_highestBlock;
+    for (auto const& stats : m_peerStats)
+    {
+        res.peers.push_back(stats.second.status);
+        res.peers.back().requestSize = bodyRequestSize(stats.first);
+    }
     return res;
 }
 
@@ -861,6 +1308,9 @@ void BlockChainSync::resetSync()
     m_headerSyncPeers.clear();
     m_bodySyncPeers.clear();
     m_headerIdToNumber.clear();
+    m_receipts.clear();
+    m_downloadingReceipts.clear();
+    m_receiptSyncPeers.clear();
     m_syncingTotalDifficulty = 0;
     m_state = SyncState::NotSynced;
 }
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -21,8 +23,10 @@ class RLPStream;
 namespace eth
 {
 class EthereumCapability;
+class BlockChainImporterFace;
 class BlockQueue;
 class EthereumPeer;
+class StateDownloader;
 
 /**
  * @brief Base BlockChain synchronization strategy class.
@@ -57,6 +61,12 @@ public:
     /// Called by peer once it has new block bodies
     void onPeerNewBlock(NodeID const& _peerID, RLP const& _r);
 
+    /// Called by peer once it has state trie nodes
+    void onPeerNodeData(NodeID const& _peerID, RLP const& _r);
+
+    /// Called by peer once it has block receipts
+    void onPeerReceipts(NodeID const& _peerID, RLP const& _r);
+
     void onPeerNewHashes(NodeID const& _peerID, std::vector<std::pair<h256, u256>> const& _hashes);
 
     /// Called by peer when it is disconnecting
@@ -68,6 +78,10 @@ public:
     /// @returns Synchonization status
     SyncStatus status() const;
 
+    /// Import blocks far behind the best peer without executing them and download the state of a
+    /// recent block instead. Blocks are inserted into the chain with @a _importer.
+    void enableFastSync(std::unique_ptr<BlockChainImporterFace> _importer);
+
     static char const* stateName(SyncState _s) { return s_stateNames[static_cast<int>(_s)]; }
 
 private:
@@ -91,6 +105,27 @@ private:
     bool verifyDaoChallengeResponse(RLP const& _r);
     void logImported(unsigned _success, unsigned _future, unsigned _got, unsigned _unknown);
 
+    /// Record that a request for @a _count headers or bodies was sent to the peer.
+    void noteRequest(NodeID const& _peerID, unsigned _count, bool _bodies);
+    /// Update the peer's round-trip time and throughput on receiving its response.
+    void noteResponse(NodeID const& _peerID, size_t _itemCount);
+    /// @returns the number of bodies to ask the peer for, so that it answers in about
+    /// c_targetResponseTime.
+    unsigned bodyRequestSize(NodeID const& _peerID) const;
+    /// Ask @a _peerID for the bodies of the oldest body request if its peer is lagging and slower.
+    /// @returns true if the request was made.
+    bool reassignStraggler(NodeID const& _peerID);
+
+    /// Choose or move the block up to which blocks are imported without execution.
+    void updatePivot();
+    /// Ask the peer for receipts of blocks up to the pivot. @returns true if the request was made.
+    bool requestReceipts(NodeID const& _peerID);
+    /// Import downloaded blocks up to the pivot along with their receipts.
+    void collectFastBlocks();
+    void startStateDownload();
+    void requestState(NodeID const& _peerID);
+    void completeStateDownload();
+
 private:
     struct Header
     {
@@ -147,6 +182,26 @@ private:
     /// Peers to m_downloadingBodies number map
     std::map<NodeID, std::vector<unsigned>> m_bodySyncPeers;
     std::unordered_map<HeaderId, unsigned, HeaderIdHash> m_headerIdToNumber;
+
+    struct PeerDownloadStats
+    {
+        PeerSyncStatus status;
+        std::chrono::steady_clock::time_point requestTime;  ///< When the pending request was sent.
+        unsigned requestedItems = 0;                         ///< Size of the pending request.
+        bool requestedBodies = false;                        ///< Whether it asked for bodies.
+        bool awaitingResponse = false;
+    };
+    /// Download statistics of peers we requested blocks from
+    std::map<NodeID, PeerDownloadStats> m_peerStats;
+
+    std::unique_ptr<BlockChainImporterFace> m_fastSyncImporter;  ///< Set while fast sync is enabled
+    unsigned m_pivotBlock = 0;  ///< Last block imported without execution, 0 if none
+    std::unique_ptr<StateDownloader> m_stateDownloader;  ///< Downloads the state of the pivot block
+    std::map<unsigned, bytes> m_receipts;                ///< Downloaded receipts of blocks up to the pivot
+    std::unordered_set<unsigned> m_downloadingReceipts;  ///< Set of block receipts numbers being downloaded
+    /// Peers to m_downloadingReceipts number map
+    std::map<NodeID, std::vector<unsigned>> m_receiptSyncPeers;
+
     bool m_haveCommonHeader = false;			///< True if common block for our and remote chain has been found
     unsigned m_lastImportedBlock = 0; 			///< Last imported block number
     h256 m_lastImportedBlockHash;				///< Last imported block hash
@@ -165,5 +220,16 @@ private:
 
 std::ostream& operator<<(std::ostream& _out, SyncStatus const& _sync);
 
+/// @returns the number of bodies to ask a peer for, so that it answers in about two seconds.
+/// @param _throughput the bodies per second the peer delivered so far, 0 if not yet measured.
+unsigned bodyRequestSize(double _throughput);
+
+/// @returns whether a body request for @a _requestedItems bodies, sent @a _elapsed seconds ago
+/// to a peer delivering @a _ownerThroughput bodies per second, should be handed to a peer
+/// delivering @a _requesterThroughput. It is once the request is overdue and the other peer is
+/// faster.
+bool isStraggler(double _elapsed, unsigned _requestedItems, double _ownerThroughput,
+    double _requesterThroughput);
+
 }
 }
@@ -17,8 +17,6 @@ namespace eth
 
 // TODO: OPTIMISE: constructors take bytes, RLP used only in necessary classes.
 
-constexpr unsigned c_bloomIndexSize = 16;
-constexpr unsigned c_bloomIndexLevels = 2;
 
 constexpr unsigned c_invalidNumber = (unsigned)-1;
 
@@ -62,16 +60,6 @@ struct BlockLogBlooms
     mutable unsigned size;
 };
 
-struct BlocksBlooms
-{
-    BlocksBlooms() {}
-    BlocksBlooms(RLP const& _r) { blooms = _r.toArray<LogBloom, c_bloomIndexSize>(); size = _r.data().size(); }
-    bytes rlp() const { bytes r = dev::rlp(blooms); size = r.size(); return r; }
-
-    std::array<LogBloom, c_bloomIndexSize> blooms;
-    mutable unsigned size;
-};
-
 struct BlockReceipts
 {
     BlockReceipts() {}
@@ -112,14 +100,12 @@ using BlockLogBloomsHash = std::unordered_map<h256, BlockLogBlooms>;
 using BlockReceiptsHash = std::unordered_map<h256, BlockReceipts>;
 using TransactionAddressHash = std::unordered_map<h256, TransactionAddress>;
 using BlockHashHash = std::unordered_map<uint64_t, BlockHash>;
-using BlocksBloomsHash = std::unordered_map<h256, BlocksBlooms>;
 
 static const BlockDetails NullBlockDetails;
 static const BlockLogBlooms NullBlockLogBlooms;
 static const BlockReceipts NullBlockReceipts;
 static const TransactionAddress NullTransactionAddress;
 static const BlockHash NullBlockHash;
-static const BlocksBlooms NullBlocksBlooms;
 
 }
 }
@@ -0,0 +1,268 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "BloomBitsIndex.h"
+#include "BlockChain.h"
+
+#include <libdevcore/RLP.h>
+
+#include <cassert>
+#include <map>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+unsigned const c_bloomBits = LogBloom::size * 8;
+/// Size of a row stored as a bitmap. Rows stored as lists of 2-byte offsets are shorter.
+size_t const c_bitmapSize = BloomBitsIndex::c_sectionSize / 8;
+string const c_sectionCountKey{"bloomBitsSections"};
+
+db::Slice rowKey(unsigned _section, unsigned _bit, unsigned _extra)
+{
+    return toSlice(uint64_t(_section) * c_bloomBits + _bit, _extra);
+}
+
+template <class Row>
+string encode(Row const& _row)
+{
+    string ret;
+    if (_row.count() * 2 < c_bitmapSize)
+    {
+        for (unsigned i = 0; i < _row.size(); ++i)
+            if (_row[i])
+            {
+                ret.push_back(char(i >> 8));
+                ret.push_back(char(i & 0xff));
+            }
+    }
+    else
+    {
+        ret.assign(c_bitmapSize, '\0');
+        for (unsigned i = 0; i < _row.size(); ++i)
+            if (_row[i])
+                ret[i / 8] |= char(1 << (i % 8));
+    }
+    return ret;
+}
+
+template <class Row>
+Row decode(string const& _data)
+{
+    Row ret;
+    if (_data.size() == c_bitmapSize)
+    {
+        for (unsigned i = 0; i < ret.size(); ++i)
+            if (byte(_data[i / 8]) & (1 << (i % 8)))
+                ret.set(i);
+    }
+    else
+        for (size_t i = 0; i + 1 < _data.size(); i += 2)
+            ret.set(unsigned(byte(_data[i])) << 8 | byte(_data[i + 1]));
+    return ret;
+}
+
+/// @returns the bloom bits set in @a _bloom.
+vector<unsigned> setBits(LogBloom const& _bloom)
+{
+    vector<unsigned> ret;
+    for (unsigned i = 0; i < c_bloomBits; ++i)
+        if (_bloom[i / 8] & (1 << (i % 8)))
+            ret.push_back(i);
+    return ret;
+}
+}  // namespace
+
+void BloomBitsIndex::open(db::DatabaseFace& _db, unsigned _head, BlockBloom const& _blockBloom)
+{
+    WriteGuard l(x_index);
+    m_db = &_db;
+    m_tail.clear();
+    string const sectionCount = _db.lookup(db::Slice(c_sectionCountKey));
+    m_sections = sectionCount.empty() ? 0 : RLP(sectionCount).toInt<unsigned>();
+
+    // The sections are written with the blocks, before the head moves to them.
+    unsigned const complete = (_head + 1) / c_sectionSize;
+    if (m_sections > complete)
+        removeSections(complete);
+    else if (m_sections < complete)
+        LOG(m_logger) << "Indexing the log blooms of blocks " << m_sections * c_sectionSize
+                      << " -> " << complete * c_sectionSize - 1 << ", this may take a while";
+
+    for (unsigned n = m_sections * c_sectionSize; n <= _head; ++n)
+    {
+        m_tail.push_back(_blockBloom(n));
+        if (m_tail.size() == c_sectionSize)
+        {
+            auto batch = _db.createWriteBatch();
+            writeSection(*batch);
+            writeSectionCount(*batch);
+            _db.commit(move(batch));
+        }
+    }
+}
+
+void BloomBitsIndex::close()
+{
+    WriteGuard l(x_index);
+    m_db = nullptr;
+    m_sections = 0;
+    m_tail.clear();
+}
+
+void BloomBitsIndex::append(unsigned _number, LogBloom const& _bloom, db::WriteBatchFace& _batch)
+{
+    WriteGuard l(x_index);
+    unsigned next = m_sections * c_sectionSize + m_tail.size();
+    assert(_number >= next);
+    unsigned const sections = m_sections;
+
+    // Gaps are only left by chains that don't start at genesis, and can span whole sections.
+    while (next < _number)
+        if (m_tail.empty() && _number - next >= c_sectionSize)
+        {
+            ++m_sections;
+            next += c_sectionSize;
+        }
+        else
+        {
+            m_tail.push_back(LogBloom());
+            ++next;
+            if (m_tail.size() == c_sectionSize)
+                writeSection(_batch);
+        }
+
+    m_tail.push_back(_bloom);
+    if (m_tail.size() == c_sectionSize)
+        writeSection(_batch);
+    if (m_sections != sections)
+        writeSectionCount(_batch);
+}
+
+void BloomBitsIndex::rewind(unsigned _number, BlockBloom const& _blockBloom)
+{
+    WriteGuard l(x_index);
+    unsigned const tailStart = m_sections * c_sectionSize;
+    if (_number >= tailStart)
+    {
+        m_tail.resize(min<size_t>(m_tail.size(), _number - tailStart));
+        return;
+    }
+
+    unsigned const section = _number / c_sectionSize;
+    removeSections(section);
+    m_tail.clear();
+    for (unsigned n = section * c_sectionSize; n < _number; ++n)
+        m_tail.push_back(_blockBloom(n));
+}
+
+vector<unsigned> BloomBitsIndex::matching(
+    vector<LogBloom> const& _blooms, unsigned _earliest, unsigned _latest) const
+{
+    vector<unsigned> ret;
+    ReadGuard l(x_index);
+    unsigned const tailStart = m_sections * c_sectionSize;
+    unsigned const end = tailStart + m_tail.size();
+    if (!m_db || _blooms.empty() || _earliest >= end)
+        return ret;
+    _latest = min(_latest, end - 1);
+
+    vector<vector<unsigned>> bits;
+    for (LogBloom const& bloom : _blooms)
+        bits.push_back(setBits(bloom));
+
+    for (unsigned section = _earliest / c_sectionSize;
+         section < m_sections && section * c_sectionSize <= _latest; ++section)
+    {
+        unsigned const first = section * c_sectionSize;
+        Row inRange;
+        for (unsigned n = max(_earliest, first); n <= min(_latest, first + c_sectionSize - 1); ++n)
+            inRange.set(n - first);
+
+        // Rows are read once, although the blooms of a filter usually share some of their bits.
+        map<unsigned, Row> rows;
+        Row matches;
+        for (auto const& bloomBits : bits)
+        {
+            Row candidates = inRange;
+            for (unsigned bit : bloomBits)
+            {
+                auto found = rows.find(bit);
+                if (found == rows.end())
+                    found = rows.emplace(bit, row(section, bit)).first;
+                candidates &= found->second;
+                if (candidates.none())
+                    break;
+            }
+            matches |= candidates;
+        }
+        for (unsigned i = 0; i < c_sectionSize; ++i)
+            if (matches[i])
+                ret.push_back(first + i);
+    }
+
+    for (unsigned n = max(_earliest, tailStart); n <= _latest; ++n)
+        for (LogBloom const& bloom : _blooms)
+            if (m_tail[n - tailStart].contains(bloom))
+            {
+                ret.push_back(n);
+                break;
+            }
+    return ret;
+}
+
+unsigned BloomBitsIndex::size() const
+{
+    ReadGuard l(x_index);
+    return m_sections * c_sectionSize + m_tail.size();
+}
+
+size_t BloomBitsIndex::memoryUsage() const
+{
+    ReadGuard l(x_index);
+    return m_tail.size() * sizeof(LogBloom);
+}
+
+BloomBitsIndex::Row BloomBitsIndex::row(unsigned _section, unsigned _bit) const
+{
+    return decode<Row>(m_db->lookup(rowKey(_section, _bit, m_extra)));
+}
+
+void BloomBitsIndex::writeSection(db::WriteBatchFace& _batch)
+{
+    assert(m_tail.size() == c_sectionSize);
+    vector<Row> rows(c_bloomBits);
+    for (unsigned i = 0; i < c_sectionSize; ++i)
+        for (unsigned bit : setBits(m_tail[i]))
+            rows[bit].set(i);
+
+    // Rows of sections that aren't complete are never stored, so empty ones can be skipped.
+    for (unsigned bit = 0; bit < c_bloomBits; ++bit)
+        if (rows[bit].any())
+        {
+            string const data = encode(rows[bit]);
+            _batch.insert(rowKey(m_sections, bit, m_extra), db::Slice(data));
+        }
+    ++m_sections;
+    m_tail.clear();
+}
+
+void BloomBitsIndex::removeSections(unsigned _section)
+{
+    auto batch = m_db->createWriteBatch();
+    for (unsigned section = _section; section < m_sections; ++section)
+        for (unsigned bit = 0; bit < c_bloomBits; ++bit)
+            batch->kill(rowKey(section, bit, m_extra));
+    m_sections = _section;
+    writeSectionCount(*batch);
+    m_db->commit(move(batch));
+}
+
+void BloomBitsIndex::writeSectionCount(db::WriteBatchFace& _batch) const
+{
+    bytes const count = rlp(m_sections);
+    _batch.insert(db::Slice(c_sectionCountKey), (db::Slice)dev::ref(count));
+}
@@ -0,0 +1,95 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Bit-sliced index of the log blooms of the canonical chain.
+#pragma once
+
+#include <libdevcore/Guards.h>
+#include <libdevcore/Log.h>
+#include <libdevcore/db.h>
+#include <libethcore/Common.h>
+
+#include <bitset>
+#include <functional>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+/**
+ * @brief Index of the blocks whose bloom has each of the 2048 bloom bits set.
+ *
+ * The chain is cut into sections of c_sectionSize blocks. For a complete section, the index stores
+ * one row per bloom bit: the offsets of the blocks of the section that have the bit, kept as a
+ * sorted list while there are few and as a bitmap otherwise. The blocks whose bloom contains a
+ * given one are then found by ANDing the rows of its set bits, a handful per address or topic,
+ * instead of checking the bloom of every block. The blooms of the blocks after the last complete
+ * section are kept in memory and checked directly, until the section is complete and written out.
+ *
+ * Rows of complete sections only exist in the database, under the keys of the given extras kind.
+ * @threadsafe
+ */
+class BloomBitsIndex
+{
+public:
+    /// @returns the bloom of the canonical block numbered @a _number.
+    using BlockBloom = std::function<LogBloom(unsigned _number)>;
+
+    static unsigned const c_sectionSize = 4096;
+
+    /// @param _extra the extras kind whose keys hold the rows.
+    explicit BloomBitsIndex(unsigned _extra): m_extra(_extra) {}
+
+    /// Starts using @a _db, where the head of the chain is block @a _head. The blooms of the blocks
+    /// after the last complete section are read with @a _blockBloom, as are those of any complete
+    /// section that hasn't been indexed yet.
+    void open(db::DatabaseFace& _db, unsigned _head, BlockBloom const& _blockBloom);
+    void close();
+
+    /// Adds block @a _number, with @a _bloom, after the last block added; blocks skipped have empty
+    /// blooms. The rows of a section it completes are written to @a _batch.
+    void append(unsigned _number, LogBloom const& _bloom, db::WriteBatchFace& _batch);
+
+    /// Removes the blocks from @a _number on, reading any blooms still needed of the section of
+    /// @a _number with @a _blockBloom.
+    void rewind(unsigned _number, BlockBloom const& _blockBloom);
+
+    /// @returns the numbers, in increasing order, of the blocks in [@a _earliest, @a _latest] whose
+    /// bloom contains any of @a _blooms.
+    std::vector<unsigned> matching(
+        std::vector<LogBloom> const& _blooms, unsigned _earliest, unsigned _latest) const;
+
+    /// @returns the number of blocks added.
+    unsigned size() const;
+    /// @returns the number of bytes used in memory.
+    size_t memoryUsage() const;
+
+private:
+    using Row = std::bitset<c_sectionSize>;
+
+    /// @returns the row of bloom bit @a _bit in complete section @a _section.
+    Row row(unsigned _section, unsigned _bit) const;
+    /// Writes the rows of the section made of the blooms in m_tail to @a _batch, and clears it.
+    void writeSection(db::WriteBatchFace& _batch);
+    /// Removes the complete sections from @a _section on from the database.
+    void removeSections(unsigned _section);
+    /// Writes the number of complete sections to @a _batch.
+    void writeSectionCount(db::WriteBatchFace& _batch) const;
+
+    unsigned const m_extra;
+
+    mutable SharedMutex x_index;
+    db::DatabaseFace* m_db = nullptr;
+    /// Number of complete sections, all in the database.
+    unsigned m_sections = 0;
+    /// Blooms of the blocks of the incomplete section.
+    std::vector<LogBloom> m_tail;
+
+    Logger m_logger{createLogger(VerbosityInfo, "chain")};
+};
+
+}  // namespace eth
+}  // namespace dev
@@ -0,0 +1,55 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "ChainDataCompression.h"
+
+#include <snappy.h>
+
+#include <atomic>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+/// RLP lists start with 0xc0 or above, and bodies and receipts are lists.
+char const c_snappyTag = 0;
+
+atomic<bool> g_compress{false};
+}  // namespace
+
+void dev::eth::setChainDataCompression(bool _compress)
+{
+    g_compress = _compress;
+}
+
+bool dev::eth::chainDataCompression()
+{
+    return g_compress;
+}
+
+bool dev::eth::isCompressedChainData(string const& _stored)
+{
+    return !_stored.empty() && _stored[0] == c_snappyTag;
+}
+
+string dev::eth::compressChainData(bytesConstRef _rlp)
+{
+    string ret(1 + snappy::MaxCompressedLength(_rlp.size()), c_snappyTag);
+    size_t size = 0;
+    snappy::RawCompress(reinterpret_cast<char const*>(_rlp.data()), _rlp.size(), &ret[1], &size);
+    ret.resize(1 + size);
+    return ret;
+}
+
+void dev::eth::uncompressChainData(string& io_stored)
+{
+    if (!isCompressedChainData(io_stored))
+        return;
+    string uncompressed;
+    if (!snappy::Uncompress(io_stored.data() + 1, io_stored.size() - 1, &uncompressed))
+        BOOST_THROW_EXCEPTION(FailedToUncompressChainData());
+    io_stored.swap(uncompressed);
+}
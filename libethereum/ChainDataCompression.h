@@ -0,0 +1,37 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Optional compression of the block bodies and receipts kept in the chain databases.
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/Exceptions.h>
+
+#include <string>
+
+namespace dev
+{
+namespace eth
+{
+DEV_SIMPLE_EXCEPTION(FailedToUncompressChainData);
+
+/// Sets whether block bodies and receipts are compressed with snappy when they are written.
+/// Values are read in either form whatever the setting, so it can be changed at any time; see
+/// BlockChain::recompressChainData() to convert what is already stored.
+void setChainDataCompression(bool _compress);
+bool chainDataCompression();
+
+/// @returns whether @a _stored, a stored block body or receipts value, is compressed.
+bool isCompressedChainData(std::string const& _stored);
+
+/// @returns the value to store for @a _rlp compressed. It starts with a byte that no RLP list
+/// starts with, so that it can't be mistaken for an uncompressed value.
+std::string compressChainData(bytesConstRef _rlp);
+
+/// Replaces @a io_stored, a stored block body or receipts value, with its RLP if it is compressed.
+void uncompressChainData(std::string& io_stored);
+
+}  // namespace eth
+}  // namespace dev
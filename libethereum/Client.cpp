@@ -110,6 +110,9 @@ void Client::init(p2p::Host& _extNet, fs::path const& _dbPath,
         if (auto h = m_host.lock())
             h->onBlockImported(_info);
     });
+    bc().setOnImportStages([=](VerifiedBlockRef const& _block, ImportStageDurations const& _stages) {
+        m_importMetrics.record(_block, _stages);
+    });
 
     if (_forceAction == WithExisting::Rescue)
         bc().rescue(m_stateDB);
@@ -216,12 +219,26 @@ bool Client::isMajorSyncing() const
     return false;
 }
 
+bool Client::haveHeadState() const
+{
+    h256 const stateRoot = bc().info().stateRoot();
+    return stateRoot == EmptyTrie || m_stateDB.exists(stateRoot);
+}
+
+void Client::enableFastSync()
+{
+    if (auto h = m_host.lock())
+        h->enableFastSync(createBlockChainImporter());
+}
+
 void Client::startedWorking()
 {
     // Synchronise the state according to the head of the block chain.
     // TODO: currently it contains keys for *all* blocks. Make it remove old ones.
     LOG(m_loggerDetail) << "startedWorking()";
 
+    if (!haveHeadState())
+        return;
     DEV_WRITE_GUARDED(x_preSeal)
         m_preSeal.sync(bc());
     DEV_READ_GUARDED(x_preSeal)
@@ -237,6 +254,8 @@ void Client::doneWorking()
 {
     // Synchronise the state according to the head of the block chain.
     // TODO: currently it contains keys for *all* blocks. Make it remove old ones.
+    if (!haveHeadState())
+        return;
     DEV_WRITE_GUARDED(x_preSeal)
         m_preSeal.sync(bc());
     DEV_READ_GUARDED(x_preSeal)
@@ -323,44 +342,48 @@ void Client::appendFromNewPending(TransactionReceipt const& _receipt, h256Hash&
     Guard l(x_filtersWatches);
     io_changed.insert(PendingChangedFilter);
     m_specialFilters.at(PendingChangedFilter).push_back(_sha3);
-    for (pair<h256 const, InstalledFilter>& i: m_filters)
-    {
-        // acceptable number.
-        auto m = i.second.filter.matches(_receipt);
-        if (m.size())
-        {
-            // filter catches them
-            for (LogEntry const& l: m)
-                i.second.changes.push_back(LocalisedLogEntry(l));
-            io_changed.insert(i.first);
-        }
-    }
+    if (!m_filterIndex.mayMatch(_receipt.bloom()))
+        return;
+    for (LogEntry const& log: _receipt.log())
+        m_filterIndex.forEachCandidate(log, [&](h256 const& _id) {
+            auto f = m_filters.find(_id);
+            if (f == m_filters.end() || !f->second.filter.matches(log))
+                return;
+            // filter catches it
+            f->second.changes.push_back(LocalisedLogEntry(log));
+            io_changed.insert(_id);
+        });
 }
 
 void Client::appendFromBlock(h256 const& _block, BlockPolarity _polarity, h256Hash& io_changed)
 {
-    // TODO: more precise check on whether the txs match.
-    auto receipts = bc().receipts(_block).receipts;
+    // Most blocks can be ruled out for all filters by their bloom, without reading the receipts.
+    LogBloom const bloom = bc().info(_block).logBloom();
+    bool mayMatch = false;
+    DEV_GUARDED(x_filtersWatches)
+        mayMatch = m_filterIndex.mayMatch(bloom);
+    TransactionReceipts const receipts =
+        mayMatch ? bc().receipts(_block).receipts : TransactionReceipts();
+    BlockNumber const number = mayMatch ? static_cast<BlockNumber>(bc().number(_block)) : 0;
 
     Guard l(x_filtersWatches);
     io_changed.insert(ChainChangedFilter);
     m_specialFilters.at(ChainChangedFilter).push_back(_block);
-    for (pair<h256 const, InstalledFilter>& i: m_filters)
+    for (unsigned j = 0; j < receipts.size(); j++)
     {
-        // acceptable number & looks like block may contain a matching log entry.
-        for (size_t j = 0; j < receipts.size(); j++)
-        {
-            auto tr = receipts[j];
-            auto m = i.second.filter.matches(tr);
-            if (m.size())
-            {
-                auto transactionHash = transaction(_block, j).sha3();
-                // filter catches them
-                for (LogEntry const& l: m)
-                    i.second.changes.push_back(LocalisedLogEntry(l, _block, (BlockNumber)bc().number(_block), transactionHash, j, 0, _polarity));
-                io_changed.insert(i.first);
-            }
-        }
+        h256 transactionHash;
+        for (LogEntry const& log: receipts[j].log())
+            m_filterIndex.forEachCandidate(log, [&](h256 const& _id) {
+                auto f = m_filters.find(_id);
+                if (f == m_filters.end() || !f->second.filter.matches(log))
+                    return;
+                // filter catches it
+                if (!transactionHash)
+                    transactionHash = transaction(_block, j).sha3();
+                f->second.changes.push_back(LocalisedLogEntry(
+                    log, _block, number, transactionHash, j, 0, _polarity));
+                io_changed.insert(_id);
+            });
     }
 }
 
@@ -435,15 +458,21 @@ void Client::syncTransactionQueue()
         DEV_WRITE_GUARDED(x_postSeal)
             m_postSeal = m_working;
 
+    h256s newPending;
+    newPending.reserve(newPendingReceipts.size());
     DEV_READ_GUARDED(x_postSeal)
         for (size_t i = 0; i < newPendingReceipts.size(); i++)
-            appendFromNewPending(newPendingReceipts[i], changeds, m_postSeal.pending()[i].sha3());
+        {
+            newPending.push_back(m_postSeal.pending()[i].sha3());
+            appendFromNewPending(newPendingReceipts[i], changeds, newPending.back());
+        }
 
     // Tell farm about new transaction (i.e. restart mining).
     onPostStateChanged();
 
-    // Tell watches about the new transactions.
+    // Tell watches and subscribers about the new transactions.
     noteChanged(changeds);
+    m_onPendingTransactions(newPending);
 
     // Tell network about the new transactions.
     if (auto h = m_host.lock())
@@ -495,6 +524,10 @@ void Client::resyncStateFromChain()
 
 void Client::restartMining()
 {
+    // Until the state download has finished, there is no state to build on.
+    if (!haveHeadState())
+        return;
+
     bool preChanged = false;
     Block newPreMine(chainParams().accountStartNonce);
     DEV_READ_GUARDED(x_preSeal)
@@ -10,6 +10,7 @@
 #include "BlockChainImporter.h"
 #include "ClientBase.h"
 #include "CommonNet.h"
+#include "ImportMetrics.h"
 #include "StateImporter.h"
 #include "WarpCapability.h"
 #include <libdevcore/Common.h>
@@ -117,6 +118,8 @@ public:
     /// Get some information on the transaction queue.
     TransactionQueue::Status transactionQueueStatus() const { return m_tq.status(); }
     TransactionQueue::Limits transactionQueueLimits() const { return m_tq.limits(); }
+    /// Get the statistics of the blocks imported so far.
+    ImportMetrics const& importMetrics() const { return m_importMetrics; }
 
     /// Freeze worker thread and sync some of the block queue.
     std::tuple<ImportRoute, bool, unsigned> syncQueue(unsigned _max = 1);
@@ -187,6 +190,10 @@ public:
     std::unique_ptr<StateImporterFace> createStateImporter() { return dev::eth::createStateImporter(m_stateDB); }
     std::unique_ptr<BlockChainImporterFace> createBlockChainImporter() { return dev::eth::createBlockChainImporter(m_bc); }
 
+    /// Sync far behind the network by downloading the state of a recent block instead of
+    /// executing all blocks before it. Should be called before the network is started.
+    void enableFastSync();
+
     /// Queues a function to be executed in the main thread (that owns the blockchain, etc).
     void executeInMainThread(std::function<void()> const& _function);
 
@@ -207,6 +214,11 @@ public:
     {
         return m_onChainChanged.add(_handler);
     }
+    /// Change the function that is called with the hashes of transactions that became pending
+    Handler<h256s const&> setOnPendingTransactions(std::function<void(h256s const&)> _handler)
+    {
+        return m_onPendingTransactions.add(_handler);
+    }
 
     ///< Get POW depending on sealengine it's using
     std::tuple<h256, h256, h256> getWork() override;
@@ -264,6 +276,8 @@ protected:
 
     /// Called after processing blocks by onChainChanged(_ir)
     void resyncStateFromChain();
+    /// @returns false while fast sync is downloading the state of the chain head.
+    bool haveHeadState() const;
     /// Update m_preSeal, m_working, m_postSeal blocks from the latest state of the chain
     void restartMining();
 
@@ -315,6 +329,7 @@ protected:
     BlockChain m_bc;                        ///< Maintains block database and owns the seal engine.
     BlockQueue m_bq;                        ///< Maintains a list of incoming blocks not yet on the blockchain (to be imported).
     TransactionQueue m_tq;                  ///< Maintains a list of incoming transactions not yet in a block on the blockchain.
+    ImportMetrics m_importMetrics;          ///< Stage durations and rates of the block imports.
 
     std::shared_ptr<GasPricer> m_gp;        ///< The gas pricer.
 
@@ -365,6 +380,9 @@ protected:
     /// Called when blockchain was changed
     Signal<h256s const&, h256s const&> m_onChainChanged;
 
+    /// Called when transactions were added to the pending block
+    Signal<h256s const&> m_onPendingTransactions;
+
     Logger m_logger{createLogger(VerbosityInfo, "client")};
     Logger m_loggerDetail{createLogger(VerbosityDebug, "client")};
 };
@@ -173,9 +173,8 @@ LocalisedLogEntries ClientBase::logs(LogFilter const& _f) const
     // Handle blocks from main chain
     set<unsigned> matchingBlocks;
     if (!_f.isRangeFilter())
-        for (auto const& i: _f.bloomPossibilities())
-            for (auto u: bc().withBlockBloom(i, end, begin))
-                matchingBlocks.insert(u);
+        for (auto u: bc().withBlockBloom(_f.bloomPossibilities(), end, begin))
+            matchingBlocks.insert(u);
     else
         // if it is a range filter, we want to get all logs from all blocks in given range
         for (unsigned i = end; i <= begin; i++)
@@ -210,6 +209,7 @@ unsigned ClientBase::installWatch(LogFilter const& _f, Reaping _r)
         {
             LOG(m_loggerWatch) << "FFF" << _f << h;
             m_filters.insert(make_pair(h, _f));
+            m_filterIndex.insert(h, _f);
         }
     }
     return installWatch(h, _r);
@@ -253,6 +253,7 @@ bool ClientBase::uninstallWatch(unsigned _i)
         if (!--fit->second.refCount)
         {
             LOG(m_loggerWatch) << "*X*" << fit->first << ":" << fit->second.filter;
+            m_filterIndex.erase(fit->first, fit->second.filter);
             m_filters.erase(fit);
         }
     return true;
@@ -8,6 +8,7 @@
 #include <chrono>
 #include "Interface.h"
 #include "LogFilter.h"
+#include "LogFilterIndex.h"
 #include "TransactionQueue.h"
 #include "Block.h"
 #include "CommonNet.h"
@@ -166,6 +167,7 @@ protected:
     // filters
     mutable Mutex x_filtersWatches;							///< Our lock.
     std::unordered_map<h256, InstalledFilter> m_filters;	///< The dictionary of filters that are active.
+    LogFilterIndex m_filterIndex;							///< The filters of m_filters by address and topic.
     std::unordered_map<h256, h256s> m_specialFilters = std::unordered_map<h256, std::vector<h256>>{{PendingChangedFilter, {}}, {ChainChangedFilter, {}}};
                                                             ///< The dictionary of special filters and their additional data
     std::map<unsigned, ClientWatch> m_watches;				///< Each and every watch - these reference a filter.
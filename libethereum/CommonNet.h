@@ -11,6 +11,7 @@
 #include <libp2p/Common.h>
 #include <chrono>
 #include <string>
+#include <vector>
 
 namespace dev
 {
@@ -77,6 +78,18 @@ enum class SyncState
     Size        /// Must be kept last
 };
 
+/// Block download statistics of a peer we sync from.
+struct PeerSyncStatus
+{
+    p2p::NodeID id;
+    unsigned responses = 0;       ///< Header and body requests answered.
+    unsigned itemsReceived = 0;   ///< Headers and bodies received.
+    unsigned reassigned = 0;      ///< Body requests handed to faster peers after lagging behind.
+    double rtt = 0;               ///< Smoothed request round-trip time in seconds.
+    double throughput = 0;        ///< Smoothed bodies received per second.
+    unsigned requestSize = 0;     ///< Number of bodies the next request will ask for.
+};
+
 struct SyncStatus
 {
     SyncState state = SyncState::Idle;
@@ -85,6 +98,7 @@ struct SyncStatus
     unsigned currentBlockNumber;
     unsigned highestBlockNumber;
     bool majorSyncing = false;
+    std::vector<PeerSyncStatus> peers;
 };
 
 using NodeID = p2p::NodeID;
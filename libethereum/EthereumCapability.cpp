@@ -4,6 +4,7 @@
 
 #include "EthereumCapability.h"
 #include "BlockChain.h"
+#include "BlockChainImporter.h"
 #include "BlockChainSync.h"
 #include "BlockQueue.h"
 #include "TransactionQueue.h"
@@ -154,16 +155,32 @@ public:
         }
     }
 
-    void onPeerNodeData(NodeID const& /* _peerID */, RLP const& _r) override
+    void onPeerNodeData(NodeID const& _peerID, RLP const& _r) override
     {
-        unsigned itemCount = _r.itemCount();
-        LOG(m_logger) << "Node Data (" << dec << itemCount << " entries)";
+        try
+        {
+            m_sync->onPeerNodeData(_peerID, _r);
+        }
+        catch (FailedInvariant const&)
+        {
+            // "fix" for https://github.com/ethereum/webthree-umbrella/issues/300
+            cwarn << "Failed invariant during sync, restarting sync";
+            m_sync->restartSync();
+        }
     }
 
-    void onPeerReceipts(NodeID const& /* _peerID */, RLP const& _r) override
+    void onPeerReceipts(NodeID const& _peerID, RLP const& _r) override
     {
-        unsigned itemCount = _r.itemCount();
-        LOG(m_logger) << "Receipts (" << dec << itemCount << " entries)";
+        try
+        {
+            m_sync->onPeerReceipts(_peerID, _r);
+        }
+        catch (FailedInvariant const&)
+        {
+            // "fix" for https://github.com/ethereum/webthree-umbrella/issues/300
+            cwarn << "Failed invariant during sync, restarting sync";
+            m_sync->restartSync();
+        }
     }
 
 private:
@@ -386,6 +403,17 @@ private:
     BlockChain const& m_chain;
     OverlayDB const& m_db;
 };
+
+/// @returns the RLP list of the transactions of @a _ts at @a _indices.
+shared_ptr<bytes const> encodeTransactions(Transactions const& _ts, vector<size_t> const& _indices)
+{
+    RLPStream s(_indices.size());
+    for (auto const& i : _indices)
+        s.appendRaw(_ts[i].rlp());
+    bytes data;
+    s.swapOut(data);
+    return make_shared<bytes const>(move(data));
+}
 }  // namespace
 
 EthereumCapability::EthereumCapability(shared_ptr<p2p::CapabilityHostFace> _host,
@@ -450,6 +478,11 @@ void EthereumCapability::completeSync()
     m_sync->completeSync();
 }
 
+void EthereumCapability::enableFastSync(std::unique_ptr<BlockChainImporterFace> _importer)
+{
+    m_sync->enableFastSync(move(_importer));
+}
+
 void EthereumCapability::maintainTransactions()
 {
     // Send any new transactions.
@@ -473,24 +506,21 @@ void EthereumCapability::maintainTransactions()
             m_transactionsSent.insert(t.sha3());
     }
 
-    // Send transactions to peers
+    // Send transactions to peers, encoding each distinct batch only once
+    map<vector<size_t>, shared_ptr<bytes const>> batches;
     for (auto& peer : m_peers)
     {
-        bytes b;
-        unsigned n = 0;
-        for (auto const& i : peerTransactions[peer.first])
-        {
+        auto const& batch = peerTransactions[peer.first];
+        for (auto const& i : batch)
             peer.second.markTransactionAsKnown(ts[i].sha3());
-            b += ts[i].rlp();
-            ++n;
-        }
 
-        if (n || peer.second.isWaitingForTransactions())
+        if (!batch.empty() || peer.second.isWaitingForTransactions())
         {
-            RLPStream ts;
-            m_host->prep(peer.first, name(), ts, TransactionsPacket, n).appendRaw(b, n);
-            m_host->sealAndSend(peer.first, ts);
-            LOG(m_logger) << "Sent " << n << " transactions to " << peer.first;
+            auto& data = batches[batch];
+            if (!data)
+                data = encodeTransactions(ts, batch);
+            m_host->sealAndSend(peer.first, name(), TransactionsPacket, data);
+            LOG(m_logger) << "Sent " << batch.size() << " transactions to " << peer.first;
         }
         peer.second.setWaitingForTransactions(false);
     }
@@ -544,21 +574,24 @@ void EthereumCapability::maintainBlockHashes(h256 const& _currentHash)
 
     auto const peersWithoutBlock = selectPeers(
         [&](EthereumPeer const& _peer) { return !_peer.isBlockKnown(_currentHash); });
-    for (NodeID const& peerID : peersWithoutBlock)
+
+    RLPStream ts(blockHashes.size());
+    for (auto const& bh : blockHashes)
     {
-        RLPStream ts;
-        m_host->prep(peerID, name(), ts, NewBlockHashesPacket, blockHashes.size());
-        for (auto const& bh : blockHashes)
-        {
-            ts.appendList(2);
-            ts.append(bh);
-            ts.append(m_chain.number(bh));
-        }
+        ts.appendList(2);
+        ts.append(bh);
+        ts.append(m_chain.number(bh));
+    }
+    bytes data;
+    ts.swapOut(data);
+    auto const sharedData = make_shared<bytes const>(move(data));
 
+    for (NodeID const& peerID : peersWithoutBlock)
+    {
         auto itPeer = m_peers.find(peerID);
         if (itPeer != m_peers.end())
         {
-            m_host->sealAndSend(peerID, ts);
+            m_host->sealAndSend(peerID, name(), NewBlockHashesPacket, sharedData);
             itPeer->second.clearKnownBlocks();
         }
     }
@@ -971,28 +1004,34 @@ void EthereumCapability::propagateNewBlocks(std::shared_ptr<VerifiedBlocks const
             std::max<std::size_t>(c_minBlockBroadcastPeers, std::sqrt(m_peers.size()));
 
         std::vector<NodeID> const peersToSend = randomPeers(peersWithoutBlock, peersToSendNumber);
+        if (peersToSend.empty())
+            return;
+
+        // Encode each block once, all the peers share the encoded data.
+        std::vector<std::shared_ptr<bytes const>> blocksData;
+        for (auto const& b : *_newBlocks)
+        {
+            RLPStream ts(2);
+            ts.appendRaw(b.blockData, 1).append(b.verified.info.difficulty());
+            bytes data;
+            ts.swapOut(data);
+            blocksData.push_back(std::make_shared<bytes const>(std::move(data)));
+        }
+
         for (NodeID const& peerID : peersToSend)
-            for (auto const& b : *_newBlocks)
+            for (size_t i = 0; i < _newBlocks->size(); ++i)
             {
-                RLPStream ts;
-                m_host->prep(peerID, name(), ts, NewBlockPacket, 2)
-                    .appendRaw(b.blockData, 1)
-                    .append(b.verified.info.difficulty());
-
                 auto itPeer = m_peers.find(peerID);
                 if (itPeer != m_peers.end())
                 {
-                    m_host->sealAndSend(peerID, ts);
+                    m_host->sealAndSend(peerID, name(), NewBlockPacket, blocksData[i]);
                     // We don't want to send new block hashes to these same peers
-                    itPeer->second.markBlockAsKnown(b.verified.info.hash());
+                    itPeer->second.markBlockAsKnown((*_newBlocks)[i].verified.info.hash());
                 }
             }
-        if (!peersToSend.empty())
-        {
-            m_latestBlockSent = latestHash;
-            LOG(m_logger) << "Sent " << _newBlocks->size() << " block(s) to " << peersToSend.size()
-                          << " peers";
-        }
+        m_latestBlockSent = latestHash;
+        LOG(m_logger) << "Sent " << _newBlocks->size() << " block(s) to " << peersToSend.size()
+                      << " peers";
     });
 }
 
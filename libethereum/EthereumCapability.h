@@ -106,6 +106,10 @@ public:
     /// Don't sync further - used only in test mode
     void completeSync();
 
+    /// Sync far behind the network by downloading the state of a recent block instead of
+    /// executing all blocks before it.
+    void enableFastSync(std::unique_ptr<BlockChainImporterFace> _importer);
+
     bool isSyncing() const;
 
     void noteNewTransactions() { m_newTransactions = true; }
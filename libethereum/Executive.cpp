@@ -13,6 +13,7 @@
 #include <libethcore/CommonJS.h>
 #include <libevm/LegacyVM.h>
 #include <libevm/VMFactory.h>
+#include <libevm/VMProfiler.h>
 
 using namespace std;
 using namespace dev;
@@ -329,6 +330,13 @@ OnOpFunc Executive::simpleTrace()
 
 bool Executive::go(OnOpFunc const& _onOp)
 {
+    // Nested calls get the same callback, so the session covers the whole execution.
+    if (!_onOp && m_ext && VMProfiler::isEnabled())
+    {
+        VMProfiler::Session session;
+        return go(session.onOp());
+    }
+
     if (m_ext)
     {
 #if ETH_TIMED_EXECUTIONS
@@ -0,0 +1,68 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "ImportMetrics.h"
+#include "VerifiedBlock.h"
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+// From 1 us to over an hour.
+double const c_minSeconds = 1e-6;
+unsigned const c_secondsOctaves = 32;
+
+// From 1000 gas/s to over 1 Tgas/s.
+double const c_minGasPerSecond = 1e3;
+unsigned const c_gasPerSecondOctaves = 30;
+
+// From 1 tx/s to over 1M tx/s.
+double const c_minTransactionsPerSecond = 1;
+unsigned const c_transactionsPerSecondOctaves = 20;
+}  // namespace
+
+array<char const*, 9> const ImportMetrics::c_stages = {{"verification", "preliminaryChecks",
+    "enactment", "stateCommit", "collation", "writing", "checkBest", "databaseCommit", "total"}};
+
+ImportMetrics::ImportMetrics()
+  : m_gasPerSecond(c_minGasPerSecond, c_gasPerSecondOctaves),
+    m_transactionsPerSecond(c_minTransactionsPerSecond, c_transactionsPerSecondOctaves)
+{
+    for (size_t i = 0; i < c_stages.size(); ++i)
+        m_stages.push_back(make_unique<Histogram>(c_minSeconds, c_secondsOctaves));
+}
+
+void ImportMetrics::record(VerifiedBlockRef const& _block, ImportStageDurations const& _stages)
+{
+    for (auto const& stage : _stages)
+        for (size_t i = 0; i < c_stages.size(); ++i)
+            if (stage.first == c_stages[i])
+                m_stages[i]->record(stage.second);
+
+    uint64_t const gasUsed = _block.info.gasUsed().convert_to<uint64_t>();
+    size_t const transactions = _block.transactions.size();
+    m_blocks.fetch_add(1, memory_order_relaxed);
+    m_transactions.fetch_add(transactions, memory_order_relaxed);
+    m_gasUsed.fetch_add(gasUsed, memory_order_relaxed);
+
+    // Blocks inserted without execution and empty blocks would only skew the rates.
+    if (!transactions)
+        return;
+    auto const enactment = _stages.find("enactment");
+    if (enactment != _stages.end() && enactment->second > 0)
+        m_gasPerSecond.record(gasUsed / enactment->second);
+    auto const total = _stages.find("total");
+    if (total != _stages.end() && total->second > 0)
+        m_transactionsPerSecond.record(transactions / total->second);
+}
+
+Histogram const* ImportMetrics::stage(string const& _stage) const
+{
+    for (size_t i = 0; i < c_stages.size(); ++i)
+        if (_stage == c_stages[i])
+            return m_stages[i].get();
+    return nullptr;
+}
@@ -0,0 +1,53 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Always-on statistics of the blocks imported into the BlockChain.
+#pragma once
+
+#include "BlockChain.h"
+
+#include <libdevcore/Histogram.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+
+namespace dev
+{
+namespace eth
+{
+/// Aggregates the stage durations reported by BlockChain::setOnImportStages(). Recording is
+/// lock-free, so it can be read from RPC and metrics threads while blocks are imported.
+class ImportMetrics
+{
+public:
+    /// Stages reported by BlockChain, in import order; other stages are ignored.
+    static std::array<char const*, 9> const c_stages;
+
+    ImportMetrics();
+
+    void record(VerifiedBlockRef const& _block, ImportStageDurations const& _stages);
+
+    /// @returns the durations in seconds of the stage named @a _stage, nullptr for other names.
+    Histogram const* stage(std::string const& _stage) const;
+    /// Gas per second of execution, for blocks with transactions.
+    Histogram const& gasPerSecond() const { return m_gasPerSecond; }
+    /// Transactions per second of the whole import, for blocks with transactions.
+    Histogram const& transactionsPerSecond() const { return m_transactionsPerSecond; }
+
+    uint64_t blocks() const { return m_blocks.load(std::memory_order_relaxed); }
+    uint64_t transactions() const { return m_transactions.load(std::memory_order_relaxed); }
+    uint64_t gasUsed() const { return m_gasUsed.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<std::unique_ptr<Histogram>> m_stages;  ///< Indexed like c_stages
+    Histogram m_gasPerSecond;
+    Histogram m_transactionsPerSecond;
+    std::atomic<uint64_t> m_blocks{0};
+    std::atomic<uint64_t> m_transactions{0};
+    std::atomic<uint64_t> m_gasUsed{0};
+};
+}  // namespace eth
+}  // namespace dev
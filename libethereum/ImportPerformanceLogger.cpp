@@ -20,7 +20,7 @@ static std::string pairToString(std::pair<std::string const, ValueType> const& _
 
 }
 
-std::string ImportPerformanceLogger::constructReport(double _totalElapsed, std::unordered_map<std::string, std::string> const& _additionalValues)
+std::string ImportPerformanceLogger::constructReport(std::unordered_map<std::string, std::string> const& _additionalValues)
 {
 	static std::string const Separator = ", ";
 
@@ -32,7 +32,6 @@ std::string ImportPerformanceLogger::constructReport(double _totalElapsed, std::
 		result += Separator;
 	}
 
-	m_stages.emplace("total", _totalElapsed);
 	auto const keyValuesStages = m_stages | boost::adaptors::transformed(pairToString<double>);
 	result += boost::algorithm::join(keyValuesStages, Separator);
 
@@ -33,17 +33,21 @@ public:
 		return it != m_stages.end() ? it->second : 0;
 	}
 
+	/// Durations of the finished stages, and of the whole import as "total" once finished.
+	std::unordered_map<std::string, double> const& stages() const { return m_stages; }
+
 	void onFinished(std::unordered_map<std::string, std::string> const& _additionalValues)
 	{
 		double const totalElapsed = m_totalTimer.elapsed();
+		m_stages["total"] = totalElapsed;
 		if (totalElapsed > 0.5)
 		{
-            cdebug << "SLOW IMPORT: { " << constructReport(totalElapsed, _additionalValues) << " }";
+            cdebug << "SLOW IMPORT: { " << constructReport(_additionalValues) << " }";
         }
 	}
 
 private:
-	std::string constructReport(double _totalElapsed, std::unordered_map<std::string, std::string> const& _additionalValues);
+	std::string constructReport(std::unordered_map<std::string, std::string> const& _additionalValues);
 
 	Timer m_totalTimer;
 	Timer m_stageTimer;
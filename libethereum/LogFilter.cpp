@@ -137,14 +137,17 @@ LogEntries LogFilter::matches(TransactionReceipt const& _m) const
 	LogEntries ret;
 	if (matches(_m.bloom()))
 		for (LogEntry const& e: _m.log())
-		{
-			if (!m_addresses.empty() && !m_addresses.count(e.address))
-				goto continue2;
-			for (unsigned i = 0; i < 4; ++i)
-				if (!m_topics[i].empty() && (e.topics.size() < i || !m_topics[i].count(e.topics[i])))
-					goto continue2;
-			ret.push_back(e);
-			continue2:;
-		}
+			if (matches(e))
+				ret.push_back(e);
 	return ret;
 }
+
+bool LogFilter::matches(LogEntry const& _e) const
+{
+	if (!m_addresses.empty() && !m_addresses.count(_e.address))
+		return false;
+	for (unsigned i = 0; i < 4; ++i)
+		if (!m_topics[i].empty() && (_e.topics.size() <= i || !m_topics[i].count(_e.topics[i])))
+			return false;
+	return true;
+}
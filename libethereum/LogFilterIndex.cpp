@@ -0,0 +1,86 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "LogFilterIndex.h"
+
+#include <libdevcore/SHA3.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+template <class Key>
+void updateEntry(
+    unordered_map<Key, h256Hash>& io_index, Key const& _key, h256 const& _id, bool _insert)
+{
+    if (_insert)
+        io_index[_key].insert(_id);
+    else
+    {
+        auto const entry = io_index.find(_key);
+        if (entry != io_index.end() && entry->second.erase(_id) && entry->second.empty())
+            io_index.erase(entry);
+    }
+}
+}  // namespace
+
+void LogFilterIndex::insert(h256 const& _id, LogFilter const& _filter)
+{
+    update(_id, _filter, true);
+}
+
+void LogFilterIndex::erase(h256 const& _id, LogFilter const& _filter)
+{
+    update(_id, _filter, false);
+}
+
+bool LogFilterIndex::mayMatch(LogBloom const& _bloom) const
+{
+    if (!m_unindexed.empty())
+        return true;
+    for (auto const& key : m_bloomKeys)
+        if (_bloom.containsBloom<3>(key.first))
+            return true;
+    return false;
+}
+
+void LogFilterIndex::update(h256 const& _id, LogFilter const& _filter, bool _insert)
+{
+    auto const updateBloomKey = [&](h256 const& _key) {
+        if (_insert)
+            ++m_bloomKeys[_key];
+        else
+        {
+            auto const key = m_bloomKeys.find(_key);
+            if (key != m_bloomKeys.end() && !--key->second)
+                m_bloomKeys.erase(key);
+        }
+    };
+
+    if (!_filter.addresses().empty())
+    {
+        for (Address const& address : _filter.addresses())
+        {
+            updateEntry(m_byAddress, address, _id, _insert);
+            updateBloomKey(sha3(address));
+        }
+        return;
+    }
+    for (size_t i = 0; i < m_byTopic.size(); ++i)
+        if (!_filter.topics()[i].empty())
+        {
+            for (h256 const& topic : _filter.topics()[i])
+            {
+                updateEntry(m_byTopic[i], topic, _id, _insert);
+                updateBloomKey(sha3(topic));
+            }
+            return;
+        }
+    if (_insert)
+        m_unindexed.insert(_id);
+    else
+        m_unindexed.erase(_id);
+}
@@ -0,0 +1,72 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Lookup of the installed log filters that a log entry can match.
+#pragma once
+
+#include "LogFilter.h"
+
+#include <libethcore/LogEntry.h>
+
+#include <array>
+#include <unordered_map>
+
+namespace dev
+{
+namespace eth
+{
+/**
+ * @brief Index of log filters by the addresses and topics they require.
+ *
+ * A filter with addresses is indexed by each of them, since a log must come from one; a filter
+ * without addresses is indexed by the topics of its first constrained position. Filters without
+ * either match every log. The candidates of a log are therefore found with at most five lookups,
+ * whatever the number of filters, and only they need to be checked with LogFilter::matches().
+ */
+class LogFilterIndex
+{
+public:
+    /// Adds @a _filter, identified by @a _id.
+    void insert(h256 const& _id, LogFilter const& _filter);
+    /// Removes @a _filter, which must have been inserted as @a _id.
+    void erase(h256 const& _id, LogFilter const& _filter);
+
+    bool empty() const { return m_unindexed.empty() && m_bloomKeys.empty(); }
+
+    /// @returns false if no log in a block with @a _bloom can match any of the filters.
+    bool mayMatch(LogBloom const& _bloom) const;
+
+    /// Calls @a _f with the id of every filter that may match @a _entry, at most once each.
+    template <class F>
+    void forEachCandidate(LogEntry const& _entry, F const& _f) const
+    {
+        for (h256 const& id : m_unindexed)
+            _f(id);
+        auto const byAddress = m_byAddress.find(_entry.address);
+        if (byAddress != m_byAddress.end())
+            for (h256 const& id : byAddress->second)
+                _f(id);
+        for (size_t i = 0; i < _entry.topics.size() && i < m_byTopic.size(); ++i)
+        {
+            auto const byTopic = m_byTopic[i].find(_entry.topics[i]);
+            if (byTopic != m_byTopic[i].end())
+                for (h256 const& id : byTopic->second)
+                    _f(id);
+        }
+    }
+
+private:
+    /// Adds @a _id to, or removes it from, the entries of the keys of @a _filter.
+    void update(h256 const& _id, LogFilter const& _filter, bool _insert);
+
+    std::unordered_map<Address, h256Hash> m_byAddress;
+    std::array<std::unordered_map<h256, h256Hash>, 4> m_byTopic;
+    h256Hash m_unindexed;
+    /// Hash of each address and topic indexed, with the number of filters indexed by it.
+    std::unordered_map<h256, unsigned> m_bloomKeys;
+};
+
+}  // namespace eth
+}  // namespace dev
@@ -27,17 +27,6 @@ void StandardTrace::operator()(uint64_t _steps, uint64_t PC, Instruction inst, b
     ExtVM const& ext = dynamic_cast<ExtVM const&>(*voidExt);
     auto vm = dynamic_cast<LegacyVM const*>(_vm);
 
-    Json::Value r(Json::objectValue);
-
-    Json::Value stack(Json::arrayValue);
-    if (vm && !m_options.disableStack)
-    {
-        // Try extracting information about the stack from the VM is supported.
-        for (auto const& i : vm->stack())
-            stack.append(toCompactHexPrefixed(i, 1));
-        r["stack"] = stack;
-    }
-
     bool newContext = false;
     Instruction lastInst = Instruction::STOP;
 
@@ -66,13 +55,36 @@ void StandardTrace::operator()(uint64_t _steps, uint64_t PC, Instruction inst, b
         m_lastInst.resize(ext.depth + 1);
     }
 
-    if (vm)
+    bool const withStorage = !m_options.disableStorage &&
+                             (m_options.fullStorage || changesStorage(lastInst) || newContext);
+    Step const step{PC, inst, newMemSize, gasCost, gas, vm, ext, withStorage};
+
+    if (m_outValue)
+        m_outValue->append(toJson(step));
+    else
+        write(step, *m_outStream);
+}
+
+Json::Value StandardTrace::toJson(Step const& _step) const
+{
+    Json::Value r(Json::objectValue);
+
+    if (_step.vm && !m_options.disableStack)
     {
-        bytes const& memory = vm->memory();
+        // Try extracting information about the stack from the VM is supported.
+        Json::Value stack(Json::arrayValue);
+        for (auto const& i : _step.vm->stack())
+            stack.append(toCompactHexPrefixed(i, 1));
+        r["stack"] = stack;
+    }
+
+    if (_step.vm)
+    {
+        bytes const& memory = _step.vm->memory();
 
-        Json::Value memJson(Json::arrayValue);
         if (!m_options.disableMemory)
         {
+            Json::Value memJson(Json::arrayValue);
             for (unsigned i = 0; i < memory.size(); i += 32)
             {
                 bytesConstRef memRef(memory.data() + i, 32);
@@ -83,30 +95,73 @@ void StandardTrace::operator()(uint64_t _steps, uint64_t PC, Instruction inst, b
         r["memSize"] = static_cast<uint64_t>(memory.size());
     }
 
-    if (!m_options.disableStorage &&
-        (m_options.fullStorage || changesStorage(lastInst) || newContext))
+    if (_step.withStorage)
     {
         Json::Value storage(Json::objectValue);
-        for (auto const& i : ext.state().storage(ext.myAddress))
+        for (auto const& i : _step.ext.state().storage(_step.ext.myAddress))
             storage[toCompactHexPrefixed(i.second.first, 1)] =
                 toCompactHexPrefixed(i.second.second, 1);
         r["storage"] = storage;
     }
 
-    r["op"] = static_cast<uint8_t>(inst);
+    r["op"] = static_cast<uint8_t>(_step.inst);
     if (m_showMnemonics)
-        r["opName"] = instructionInfo(inst).name;
-    r["pc"] = PC;
-    r["gas"] = toString(gas);
-    r["gasCost"] = toString(gasCost);
-    r["depth"] = ext.depth + 1;  // depth in standard trace is 1-based
-    if (!!newMemSize)
-        r["memexpand"] = toString(newMemSize);
+        r["opName"] = instructionInfo(_step.inst).name;
+    r["pc"] = _step.pc;
+    r["gas"] = toString(_step.gas);
+    r["gasCost"] = toString(_step.gasCost);
+    r["depth"] = _step.ext.depth + 1;  // depth in standard trace is 1-based
+    if (!!_step.newMemSize)
+        r["memexpand"] = toString(_step.newMemSize);
+    return r;
+}
 
-    if (m_outValue)
-        m_outValue->append(r);
-    else
-        *m_outStream << m_fastWriter.write(r) << std::flush;
+void StandardTrace::write(Step const& _step, std::ostream& _out) const
+{
+    // Keys in the alphabetical order of Json::Value objects; all strings are hex, decimal or
+    // mnemonics, none needs escaping.
+    _out << "{\"depth\":" << _step.ext.depth + 1 << ",\"gas\":\"" << _step.gas
+         << "\",\"gasCost\":\"" << _step.gasCost << '"';
+    if (_step.vm)
+        _out << ",\"memSize\":" << _step.vm->memory().size();
+    if (!!_step.newMemSize)
+        _out << ",\"memexpand\":\"" << _step.newMemSize << '"';
+    if (_step.vm && !m_options.disableMemory)
+    {
+        bytes const& memory = _step.vm->memory();
+        _out << ",\"memory\":[";
+        for (unsigned i = 0; i < memory.size(); i += 32)
+            _out << (i ? ",\"" : "\"") << toHex(bytesConstRef(memory.data() + i, 32)) << '"';
+        _out << ']';
+    }
+    _out << ",\"op\":" << static_cast<unsigned>(_step.inst);
+    if (m_showMnemonics)
+        _out << ",\"opName\":\"" << instructionInfo(_step.inst).name << '"';
+    _out << ",\"pc\":" << _step.pc;
+    if (_step.vm && !m_options.disableStack)
+    {
+        _out << ",\"stack\":[";
+        bool first = true;
+        for (auto const& i : _step.vm->stack())
+        {
+            _out << (first ? "\"" : ",\"") << toCompactHexPrefixed(i, 1) << '"';
+            first = false;
+        }
+        _out << ']';
+    }
+    if (_step.withStorage)
+    {
+        _out << ",\"storage\":{";
+        bool first = true;
+        for (auto const& i : _step.ext.state().storage(_step.ext.myAddress))
+        {
+            _out << (first ? "\"" : ",\"") << toCompactHexPrefixed(i.second.first, 1) << "\":\""
+                 << toCompactHexPrefixed(i.second.second, 1) << '"';
+            first = false;
+        }
+        _out << '}';
+    }
+    _out << "}\n";
 }
 }  // namespace eth
 }  // namespace dev
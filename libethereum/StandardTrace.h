@@ -19,6 +19,9 @@ namespace dev
 {
 namespace eth
 {
+class ExtVM;
+class LegacyVM;
+
 class StandardTrace
 {
 public:
@@ -30,7 +33,8 @@ public:
         bool fullStorage = false;
     };
 
-    // Output json trace to stream, one line per op
+    // Output json trace to stream, one line per op. Each step is written as it executes, so the
+    // memory used does not depend on the length of the trace.
     explicit StandardTrace(std::ostream& _outStream) noexcept : m_outStream{&_outStream} {}
     // Append json trace to given (array) value
     explicit StandardTrace(Json::Value& _outValue) noexcept : m_outValue{&_outValue} {}
@@ -50,11 +54,26 @@ public:
     }
 
 private:
+    struct Step
+    {
+        uint64_t pc;
+        Instruction inst;
+        bigint newMemSize;
+        bigint gasCost;
+        bigint gas;
+        LegacyVM const* vm;  ///< Null for VMs that do not expose their stack and memory
+        ExtVM const& ext;
+        bool withStorage;
+    };
+
+    Json::Value toJson(Step const& _step) const;
+    /// Writes the same as toJson() with Json::FastWriter, without building the value.
+    void write(Step const& _step, std::ostream& _out) const;
+
     bool m_showMnemonics = false;
     std::vector<Instruction> m_lastInst;
     std::ostream* m_outStream = nullptr;
     Json::Value* m_outValue = nullptr;
-    Json::FastWriter m_fastWriter;
     DebugOptions m_options;
 };
 }  // namespace eth
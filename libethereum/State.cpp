@@ -33,7 +33,7 @@ State::State(u256 const& _accountStartNonce, OverlayDB const& _db, BaseState _bs
 State::State(State const& _s):
     m_db(_s.m_db),
     m_state(&m_db, _s.m_state.root(), Verification::Skip),
-    m_cache(_s.m_cache),
+    m_cache(_s.m_cache, cacheAllocator()),
     m_unchangedCacheEntries(_s.m_unchangedCacheEntries),
     m_nonExistingAccountsCache(_s.m_nonExistingAccountsCache),
     m_touched(_s.m_touched),
@@ -211,14 +211,21 @@ void State::clearCacheIfTooLarge() const
     }
 }
 
+void State::clearCache() const
+{
+    // Dropping the buckets as well leaves nothing of the cache in the arena.
+    m_cache = AccountCache{cacheAllocator()};
+    m_unchangedCacheEntries.clear();
+    m_arena->release();
+}
+
 void State::commit(CommitBehaviour _commitBehaviour)
 {
     if (_commitBehaviour == CommitBehaviour::RemoveEmptyAccounts)
         removeEmptyAccounts();
     m_touched += dev::eth::commit(m_cache, m_state);
     m_changeLog.clear();
-    m_cache.clear();
-    m_unchangedCacheEntries.clear();
+    clearCache();
 }
 
 unordered_map<Address, u256> State::addresses() const
@@ -295,8 +302,7 @@ std::pair<State::AddressMap, h256> State::addresses(
 
 void State::setRoot(h256 const& _r)
 {
-    m_cache.clear();
-    m_unchangedCacheEntries.clear();
+    clearCache();
     m_nonExistingAccountsCache.clear();
 //  m_touched.clear();
     m_state.setRoot(_r);
@@ -642,7 +648,7 @@ std::pair<ExecutionResult, TransactionReceipt> State::execute(EnvInfo const& _en
     switch (_p)
     {
         case Permanence::Reverted:
-            m_cache.clear();
+            clearCache();
             break;
         case Permanence::Committed:
             removeEmptyAccounts = _envInfo.number() >= _sealEngine.chainParams().EIP158ForkBlock;
@@ -783,8 +789,32 @@ State& dev::eth::createIntermediateState(State& o_s, Block const& _block, unsign
     return o_s;
 }
 
-template <class DB>
-AddressHash dev::eth::commit(AccountMap const& _cache, SecureTrieDB<Address, DB>& _state)
+h256s dev::eth::intermediateStateRoots(State& o_s, Block const& _block, BlockChain const& _bc)
+{
+    o_s = _block.state();
+    unsigned const txCount = _block.pending().size();
+    h256s ret;
+    for (unsigned i = 0; i < txCount; ++i)
+        ret.push_back(_block.stateRootBeforeTx(i));
+    if (find(ret.begin(), ret.end(), h256()) == ret.end())
+        return ret;
+
+    // Receipts since Byzantium hold a status code instead of the state root, so the roots are
+    // recomputed by executing the block once, committing each transaction to the memory overlay.
+    o_s.setRoot(_block.stateRootBeforeTx(0));
+    u256 gasUsed;
+    for (unsigned i = 0; i < txCount; ++i)
+    {
+        ret[i] = o_s.rootHash();
+        EnvInfo const envInfo{_block.info(), _bc.lastBlockHashes(), gasUsed, _bc.chainID()};
+        gasUsed = o_s.execute(envInfo, *_bc.sealEngine(), _block.pending()[i], Permanence::Committed)
+                      .second.cumulativeGasUsed();
+    }
+    return ret;
+}
+
+template <class DB, class Accounts>
+AddressHash dev::eth::commit(Accounts const& _cache, SecureTrieDB<Address, DB>& _state)
 {
     AddressHash ret;
     for (auto const& i: _cache)
@@ -842,3 +872,4 @@ AddressHash dev::eth::commit(AccountMap const& _cache, SecureTrieDB<Address, DB>
 
 template AddressHash dev::eth::commit<OverlayDB>(AccountMap const& _cache, SecureTrieDB<Address, OverlayDB>& _state);
 template AddressHash dev::eth::commit<StateCacheDB>(AccountMap const& _cache, SecureTrieDB<Address, StateCacheDB>& _state);
+template AddressHash dev::eth::commit<OverlayDB>(State::AccountCache const& _cache, SecureTrieDB<Address, OverlayDB>& _state);
@@ -17,6 +17,8 @@
 #include <libethereum/CodeSizeCache.h>
 #include <libevm/ExtVMFace.h>
 #include <array>
+#include <memory>
+#include <scoped_allocator>
 #include <unordered_map>
 
 namespace dev
@@ -144,6 +146,11 @@ class State
     friend class BlockChain;
 
 public:
+    /// Accounts cached by a state, with their storage caches, all kept in the state's arena.
+    using AccountCache = std::unordered_map<Address, Account, std::hash<Address>,
+        std::equal_to<Address>,
+        std::scoped_allocator_adaptor<ArenaAllocator<std::pair<Address const, Account>>>>;
+
     enum class CommitBehaviour
     {
         KeepEmptyAccounts,
@@ -332,6 +339,15 @@ private:
     /// Purges non-modified entries in m_cache if it grows too large.
     void clearCacheIfTooLarge() const;
 
+    /// Empties m_cache, and m_arena with it.
+    void clearCache() const;
+
+    /// @returns the allocator putting m_cache in m_arena.
+    AccountCache::allocator_type cacheAllocator() const
+    {
+        return AccountCache::allocator_type{ArenaAllocator<AccountCache::value_type>{m_arena.get()}};
+    }
+
     void createAccount(Address const& _address, Account const&& _account);
 
     /// @returns true when normally halted; false when exceptionally halted; throws when internal VM
@@ -342,9 +358,12 @@ private:
     OverlayDB m_db;
     /// Our state tree, as an OverlayDB DB.
     SecureTrieDB<Address, OverlayDB> m_state;
+    /// Memory of m_cache, released in one go when the cache is emptied after a commit, instead of
+    /// freeing each account and storage entry on its own.
+    std::unique_ptr<Arena> m_arena = std::make_unique<Arena>();
     /// Our address cache. This stores the states of each address that has (or at least might have)
     /// been changed.
-    mutable std::unordered_map<Address, Account> m_cache;
+    mutable AccountCache m_cache{cacheAllocator()};
     /// Tracks entries in m_cache that can potentially be purged if it grows too large.
     mutable std::vector<Address> m_unchangedCacheEntries;
     /// Tracks addresses that are known to not exist.
@@ -364,8 +383,13 @@ std::ostream& operator<<(std::ostream& _out, State const& _s);
 
 State& createIntermediateState(State& o_s, Block const& _block, unsigned _txIndex, BlockChain const& _bc);
 
-template <class DB>
-AddressHash commit(AccountMap const& _cache, SecureTrieDB<Address, DB>& _state);
+/// @returns the state root before each transaction of @a _block and sets @a o_s to a state whose
+/// database holds all of them, so that any transaction can be run from its root independently.
+h256s intermediateStateRoots(State& o_s, Block const& _block, BlockChain const& _bc);
+
+/// Writes the changed accounts of @a _cache, an AccountMap or a State::AccountCache, to @a _state.
+template <class DB, class Accounts>
+AddressHash commit(Accounts const& _cache, SecureTrieDB<Address, DB>& _state);
 
 }
 }
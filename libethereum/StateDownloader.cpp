@@ -0,0 +1,238 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "StateDownloader.h"
+
+#include <libdevcore/RLP.h>
+#include <libdevcore/SHA3.h>
+#include <libdevcore/TrieCommon.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+StateDownloader::StateDownloader(OverlayDB const& _db) : m_db(_db) {}
+
+void StateDownloader::setRoot(h256 const& _root)
+{
+    if (_root == m_root)
+        return;
+
+    m_root = _root;
+    // Received nodes can't be written before their subtrees are complete; keep them in case the
+    // new root refers to them too, as it mostly does when the chain has moved on a few blocks.
+    for (auto& request : m_requests)
+        if (request.second.received)
+            m_received[request.first] = move(request.second.data);
+    m_requests.clear();
+    m_queue.clear();
+    // Late answers to these are ignored.
+    m_inFlight.clear();
+
+    uint64_t const downloadedBefore = m_downloadedNodes;
+    if (m_root == EmptyTrie && !m_db.exists(m_root))
+    {
+        m_db.insert(EmptyTrie, &RLPNull);
+        ++m_downloadedNodes;
+    }
+    h256s queued;
+    schedule(m_root, NodeKind::Account, h256(), queued);
+    m_queue.insert(m_queue.begin(), queued.begin(), queued.end());
+    processReceived();
+
+    if (m_downloadedNodes != downloadedBefore)
+        m_db.commit();
+}
+
+h256s StateDownloader::requestNodes(p2p::NodeID const& _peerID, size_t _max)
+{
+    h256s& inFlight = m_inFlight[_peerID];
+    while (inFlight.size() < _max && !m_queue.empty())
+    {
+        h256 const hash = m_queue.front();
+        m_queue.pop_front();
+        // The node may have been dropped by setRoot() since it was queued.
+        auto const request = m_requests.find(hash);
+        if (request != m_requests.end() && !request->second.received)
+            inFlight.push_back(hash);
+    }
+
+    h256s ret = inFlight;
+    if (inFlight.empty())
+        m_inFlight.erase(_peerID);
+    return ret;
+}
+
+void StateDownloader::onNodeData(p2p::NodeID const& _peerID, RLP const& _data)
+{
+    auto const inFlight = m_inFlight.find(_peerID);
+    if (inFlight == m_inFlight.end())
+        return;
+    h256s const requested = move(inFlight->second);
+    m_inFlight.erase(inFlight);
+
+    h256Hash undelivered(requested.begin(), requested.end());
+    uint64_t const downloadedBefore = m_downloadedNodes;
+    for (auto const& item : _data)
+    {
+        bytes data = item.toBytes();
+        h256 const hash = sha3(data);
+        // Anything we didn't ask this peer for is ignored.
+        if (!undelivered.erase(hash))
+            continue;
+
+        auto const request = m_requests.find(hash);
+        if (request != m_requests.end() && !request->second.received)
+            process(hash, move(data));
+    }
+    processReceived();
+
+    for (auto it = requested.rbegin(); it != requested.rend(); ++it)
+        if (undelivered.count(*it) && m_requests.count(*it))
+            m_queue.push_front(*it);
+
+    if (m_downloadedNodes != downloadedBefore)
+        m_db.commit();
+}
+
+void StateDownloader::releasePeer(p2p::NodeID const& _peerID)
+{
+    auto const inFlight = m_inFlight.find(_peerID);
+    if (inFlight == m_inFlight.end())
+        return;
+
+    for (auto it = inFlight->second.rbegin(); it != inFlight->second.rend(); ++it)
+        if (m_requests.count(*it))
+            m_queue.push_front(*it);
+    m_inFlight.erase(inFlight);
+}
+
+vector<p2p::NodeID> StateDownloader::requestingPeers() const
+{
+    vector<p2p::NodeID> ret;
+    for (auto const& inFlight : m_inFlight)
+        ret.push_back(inFlight.first);
+    return ret;
+}
+
+void StateDownloader::collectChildren(RLP const& _node, NodeKind _kind, Children& o_children)
+{
+    auto const addReference = [&](RLP const& _ref) {
+        if (_ref.isList())
+            collectChildren(_ref, _kind, o_children);
+        else if (_ref.isData() && _ref.size() == h256::size)
+            o_children.emplace_back(_ref.toHash<h256>(), _kind);
+    };
+
+    if (_node.itemCount() == 17)
+    {
+        for (unsigned i = 0; i < 16; ++i)
+            addReference(_node[i]);
+    }
+    else if (_node.itemCount() == 2)
+    {
+        bytesConstRef const path = _node[0].payload();
+        bool const isLeaf = !path.empty() && (path[0] & 0x20);
+        if (!isLeaf)
+            addReference(_node[1]);
+        else if (_kind == NodeKind::Account)
+        {
+            RLP const account(_node[1].payload());
+            if (account.itemCount() < 4)
+                return;
+            h256 const storageRoot = account[2].toHash<h256>();
+            if (storageRoot != EmptyTrie)
+                o_children.emplace_back(storageRoot, NodeKind::Storage);
+            h256 const codeHash = account[3].toHash<h256>();
+            if (codeHash != EmptySHA3)
+                o_children.emplace_back(codeHash, NodeKind::Code);
+        }
+    }
+}
+
+bool StateDownloader::schedule(
+    h256 const& _hash, NodeKind _kind, h256 const& _parent, h256s& o_queued)
+{
+    auto const request = m_requests.find(_hash);
+    if (request != m_requests.end())
+    {
+        if (_parent)
+            request->second.parents.push_back(_parent);
+        return true;
+    }
+    if (m_db.exists(_hash))
+        return false;
+
+    Request& newRequest = m_requests[_hash];
+    newRequest.kind = _kind;
+    if (_parent)
+        newRequest.parents.push_back(_parent);
+    if (m_received.count(_hash))
+        m_reprocess.push_back(_hash);
+    else
+        o_queued.push_back(_hash);
+    return true;
+}
+
+void StateDownloader::process(h256 const& _hash, bytes&& _data)
+{
+    Request& request = m_requests.at(_hash);
+    request.data = move(_data);
+    request.received = true;
+
+    Children children;
+    if (request.kind != NodeKind::Code)
+        collectChildren(RLP(request.data), request.kind, children);
+
+    unsigned missing = 0;
+    h256s queued;
+    for (auto const& child : children)
+        if (schedule(child.first, child.second, _hash, queued))
+            ++missing;
+    // Children go ahead of the queue, so that the download goes depth-first: subtrees are
+    // completed and written one by one instead of all nodes of a level waiting in memory.
+    m_queue.insert(m_queue.begin(), queued.begin(), queued.end());
+
+    // schedule() may have rehashed the map.
+    m_requests.at(_hash).missingChildren = missing;
+    if (missing == 0)
+        store(_hash);
+}
+
+void StateDownloader::processReceived()
+{
+    while (!m_reprocess.empty())
+    {
+        h256 const hash = m_reprocess.back();
+        m_reprocess.pop_back();
+        auto const received = m_received.find(hash);
+        bytes data = move(received->second);
+        m_received.erase(received);
+        process(hash, move(data));
+    }
+    // Whatever is left is not part of the current state.
+    if (m_requests.empty())
+        m_received.clear();
+}
+
+void StateDownloader::store(h256 const& _hash)
+{
+    h256s complete{_hash};
+    while (!complete.empty())
+    {
+        h256 const hash = complete.back();
+        complete.pop_back();
+
+        auto const request = m_requests.find(hash);
+        m_db.insert(hash, &request->second.data);
+        ++m_downloadedNodes;
+        for (auto const& parent : request->second.parents)
+        {
+            auto const parentRequest = m_requests.find(parent);
+            if (parentRequest != m_requests.end() && --parentRequest->second.missingChildren == 0)
+                complete.push_back(parent);
+        }
+        m_requests.erase(request);
+    }
+}
@@ -0,0 +1,120 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Download of a state trie node by node from the network.
+#pragma once
+
+#include <libdevcore/Common.h>
+#include <libdevcore/FixedHash.h>
+#include <libdevcore/OverlayDB.h>
+#include <libp2p/Common.h>
+
+#include <deque>
+#include <map>
+#include <unordered_map>
+
+namespace dev
+{
+
+class RLP;
+
+namespace eth
+{
+
+/**
+ * @brief Fetches the state trie of a block, together with the storage tries and code of its
+ * accounts, into the state database.
+ *
+ * Missing nodes are queued and handed out in batches to be requested from peers with
+ * GetNodeData. A received node is written to the database only once all of its children are
+ * there, so a node found in the database always has its complete subtree present. This lets the
+ * download skip everything already stored, and lets it continue from another root (as the chain
+ * moves on and peers drop old states) or after a restart without fetching the same nodes again.
+ * The children of a received node are queued ahead of everything else, so the download goes
+ * depth-first and few received nodes wait in memory for their subtrees. Hashes a peer did not
+ * deliver are put back into the queue.
+ */
+class StateDownloader
+{
+public:
+    /// @param _db database to fill; the downloader writes through its own copy of it.
+    explicit StateDownloader(OverlayDB const& _db);
+
+    /// Start downloading the state with root @a _root. Requests for the previous root are
+    /// dropped; the nodes already received for it are kept and used if the new root refers to
+    /// them.
+    void setRoot(h256 const& _root);
+    h256 const& root() const { return m_root; }
+
+    /// @returns true if the whole state of root() is in the database.
+    bool isComplete() const { return m_requests.empty(); }
+
+    /// @returns up to @a _max hashes to request from the peer and marks them as in flight.
+    h256s requestNodes(p2p::NodeID const& _peerID, size_t _max);
+
+    /// Process a NodeData response of the peer. The requested hashes it doesn't contain are
+    /// queued again.
+    void onNodeData(p2p::NodeID const& _peerID, RLP const& _data);
+
+    /// Queue again the hashes requested from the peer.
+    void releasePeer(p2p::NodeID const& _peerID);
+
+    /// @returns the peers having requests in flight.
+    std::vector<p2p::NodeID> requestingPeers() const;
+
+    /// Number of nodes written to the database.
+    uint64_t downloadedNodes() const { return m_downloadedNodes; }
+    /// Number of nodes known to be missing, including the ones being downloaded.
+    size_t pendingNodes() const { return m_requests.size(); }
+
+private:
+    enum class NodeKind
+    {
+        Account,  ///< Node of the account trie
+        Storage,  ///< Node of an account's storage trie
+        Code
+    };
+
+    struct Request
+    {
+        NodeKind kind;
+        h256s parents;                 ///< Received nodes waiting for this one
+        bytes data;                    ///< Node, once received
+        bool received = false;
+        unsigned missingChildren = 0;  ///< Children not yet in the database
+    };
+
+    using Children = std::vector<std::pair<h256, NodeKind>>;
+
+    /// Adds the hashes referenced by the trie node @a _node to @a o_children. Embedded nodes are
+    /// searched recursively and leaves of the account trie add the storage root and the code.
+    static void collectChildren(RLP const& _node, NodeKind _kind, Children& o_children);
+
+    /// Request the node unless it's in the database or already requested. Nodes to download are
+    /// added to @a o_queued, nodes kept from a previous root to m_reprocess.
+    /// @returns true if the node is missing.
+    bool schedule(h256 const& _hash, NodeKind _kind, h256 const& _parent, h256s& o_queued);
+
+    /// Store the data of a requested node and schedule its children.
+    void process(h256 const& _hash, bytes&& _data);
+
+    /// Process the nodes of m_reprocess with their data kept in m_received.
+    void processReceived();
+
+    /// Write the node to the database, followed by the parents it completes.
+    void store(h256 const& _hash);
+
+    OverlayDB m_db;
+    h256 m_root;
+    std::unordered_map<h256, Request> m_requests;   ///< Missing nodes
+    std::deque<h256> m_queue;                       ///< Missing nodes not yet requested
+    std::map<p2p::NodeID, h256s> m_inFlight;        ///< Nodes requested from each peer
+    std::unordered_map<h256, bytes> m_received;     ///< Nodes received for previous roots
+    h256s m_reprocess;                              ///< Requests to fill from m_received
+    uint64_t m_downloadedNodes = 0;
+};
+
+}
+}
@@ -8,19 +8,9 @@ using namespace std;
 using namespace dev;
 using namespace dev::eth;
 
-uint64_t LegacyVM::memNeed(u256 const& _offset, u256 const& _size)
+uint64_t LegacyVM::memNeed(intx::uint256 const& _offset, intx::uint256 const& _size)
 {
-    return toInt63(_size ? u512(_offset) + _size : u512(0));
-}
-
-template <class S> S divWorkaround(S const& _a, S const& _b)
-{
-    return (S)(s512(_a) / s512(_b));
-}
-
-template <class S> S modWorkaround(S const& _a, S const& _b)
-{
-    return (S)(s512(_a) % s512(_b));
+    return toInt63(_size ? intx::uint512(_offset) + _size : intx::uint512(0));
 }
 
 
@@ -87,8 +77,8 @@ void LegacyVM::updateSSGas()
     if (m_schedule->sstoreThrowsIfGasBelowCallStipend() && m_io_gas <= m_schedule->callStipend)
         throwOutOfGas();
 
-    u256 const currentValue = m_ext->store(m_SP[0]);
-    u256 const newValue = m_SP[1];
+    u256 const currentValue = m_ext->store(fromWord(m_SP[0]));
+    u256 const newValue = fromWord(m_SP[1]);
 
     if (m_schedule->sstoreNetGasMetering())
         updateSSGasEIP1283(currentValue, newValue);
@@ -115,7 +105,7 @@ void LegacyVM::updateSSGasEIP1283(u256 const& _currentValue, u256 const& _newVal
         m_runGas = m_schedule->sstoreUnchangedGas;
     else
     {
-        u256 const originalValue = m_ext->originalStorageValue(m_SP[0]);
+        u256 const originalValue = m_ext->originalStorageValue(fromWord(m_SP[0]));
         if (originalValue == _currentValue)
         {
             if (originalValue == 0)
@@ -150,10 +140,10 @@ void LegacyVM::updateSSGasEIP1283(u256 const& _currentValue, u256 const& _newVal
 }
 
 
-uint64_t LegacyVM::gasForMem(u512 const& _size)
+uint64_t LegacyVM::gasForMem(intx::uint512 const& _size)
 {
-    u512 s = _size / 32;
-    return toInt63((u512)m_schedule->memoryGas * s + s * s / m_schedule->quadCoeffDiv);
+    intx::uint512 s = _size / 32;
+    return toInt63(intx::uint512{m_schedule->memoryGas} * s + s * s / m_schedule->quadCoeffDiv);
 }
 
 void LegacyVM::updateIOGas()
@@ -183,7 +173,8 @@ void LegacyVM::updateMem(uint64_t _newMem)
 void LegacyVM::logGasMem()
 {
     unsigned n = (unsigned)m_OP - (unsigned)Instruction::LOG0;
-    m_runGas = toInt63(m_schedule->logGas + m_schedule->logTopicGas * n + u512(m_schedule->logDataGas) * m_SP[1]);
+    m_runGas = toInt63(m_schedule->logGas + m_schedule->logTopicGas * n +
+                       intx::uint512{m_schedule->logDataGas} * intx::uint512{m_SP[1]});
     updateMem(memNeed(m_SP[0], m_SP[1]));
 }
 
@@ -214,6 +205,19 @@ owning_bytes_ref LegacyVM::exec(u256& _io_gas, ExtVMFace& _ext, OnOpFunc const&
     m_onFail = &LegacyVM::onOperation; // this results in operations that fail being logged twice in the trace
     m_PC = 0;
 
+    // The VM may have run another frame before, whose buffers are reused without their contents.
+    m_nSteps = 0;
+    m_mem.clear();
+    m_returnData.clear();
+    m_pool.clear();
+    m_jumpDests.clear();
+    m_beginSubs.clear();
+    m_SP = m_SPP = m_stackEnd;
+#if EIP_615
+    m_frameSize.clear();
+    m_RP = m_return - 1;
+#endif
+
     try
     {
         // trampoline to minimize depth of call stack when calling out
@@ -233,6 +237,25 @@ owning_bytes_ref LegacyVM::exec(u256& _io_gas, ExtVMFace& _ext, OnOpFunc const&
     return std::move(m_output);
 }
 
+void LegacyVM::recycle(size_t _maxBufferSize)
+{
+    m_ext = nullptr;
+    m_io_gas_p = nullptr;
+    m_onOp = {};
+    m_output = {};
+
+    if (m_mem.capacity() > _maxBufferSize)
+        bytes().swap(m_mem);
+    if (m_code.capacity() > _maxBufferSize)
+        bytes().swap(m_code);
+    if (m_returnData.capacity() > _maxBufferSize)
+        bytes().swap(m_returnData);
+    if (m_pool.capacity() * sizeof(intx::uint256) > _maxBufferSize)
+        std::vector<intx::uint256>().swap(m_pool);
+    if (m_jumpDests.capacity() * sizeof(uint64_t) > _maxBufferSize)
+        std::vector<uint64_t>().swap(m_jumpDests);
+}
+
 //
 // main interpreter loop and switch
 //
@@ -292,7 +315,7 @@ void LegacyVM::interpretCases()
 
             uint64_t b = (uint64_t)m_SP[0];
             uint64_t s = (uint64_t)m_SP[1];
-            m_output = owning_bytes_ref{std::move(m_mem), b, s};
+            m_output = copyMemory(m_mem, b, s);
             m_bounce = 0;
         }
         BREAK
@@ -310,8 +333,7 @@ void LegacyVM::interpretCases()
 
             uint64_t b = (uint64_t)m_SP[0];
             uint64_t s = (uint64_t)m_SP[1];
-            owning_bytes_ref output{move(m_mem), b, s};
-            throwRevertInstruction(move(output));
+            throwRevertInstruction(copyMemory(m_mem, b, s));
         }
         BREAK;
 
@@ -325,7 +347,7 @@ void LegacyVM::interpretCases()
             m_runGas = toInt63(m_schedule->selfdestructGas);
             updateIOGas();
 
-            Address const dest = asAddress(m_SP[0]);
+            Address const dest = toAddress(m_SP[0]);
             // Starting with EIP150, self-destructs need to pay both gas cost and account creation
             // gas cost. Starting with EIP158, 0-value self-destructs don't need to pay this account
             // creation cost.
@@ -363,7 +385,7 @@ void LegacyVM::interpretCases()
             updateMem(toInt63(m_SP[0]) + 32);
             updateIOGas();
 
-            m_SPP[0] = (u256)*(h256 const*)(m_mem.data() + (unsigned)m_SP[0]);
+            m_SPP[0] = intx::be::unsafe::load<intx::uint256>(m_mem.data() + (unsigned)m_SP[0]);
         }
         NEXT
 
@@ -373,7 +395,7 @@ void LegacyVM::interpretCases()
             updateMem(toInt63(m_SP[0]) + 32);
             updateIOGas();
 
-            *(h256*)&m_mem[(unsigned)m_SP[0]] = (h256)m_SP[1];
+            intx::be::unsafe::store(&m_mem[(unsigned)m_SP[0]], m_SP[1]);
         }
         NEXT
 
@@ -390,13 +412,14 @@ void LegacyVM::interpretCases()
         CASE(SHA3)
         {
             ON_OP();
-            m_runGas = toInt63(m_schedule->sha3Gas + (u512(m_SP[1]) + 31) / 32 * m_schedule->sha3WordGas);
+            m_runGas = toInt63(
+                m_schedule->sha3Gas + (intx::uint512(m_SP[1]) + 31) / 32 * m_schedule->sha3WordGas);
             updateMem(memNeed(m_SP[0], m_SP[1]));
             updateIOGas();
 
             uint64_t inOff = (uint64_t)m_SP[0];
             uint64_t inSize = (uint64_t)m_SP[1];
-            m_SPP[0] = (u256)sha3(bytesConstRef(m_mem.data() + inOff, inSize));
+            m_SPP[0] = toWord(sha3(bytesConstRef(m_mem.data() + inOff, inSize)));
         }
         NEXT
 
@@ -422,7 +445,7 @@ void LegacyVM::interpretCases()
             logGasMem();
             updateIOGas();
 
-            m_ext->log({m_SP[2]}, bytesConstRef(m_mem.data() + (uint64_t)m_SP[0], (uint64_t)m_SP[1]));
+            m_ext->log({toHash(m_SP[2])}, bytesConstRef(m_mem.data() + (uint64_t)m_SP[0], (uint64_t)m_SP[1]));
         }
         NEXT
 
@@ -435,7 +458,8 @@ void LegacyVM::interpretCases()
             logGasMem();
             updateIOGas();
 
-            m_ext->log({m_SP[2], m_SP[3]}, bytesConstRef(m_mem.data() + (uint64_t)m_SP[0], (uint64_t)m_SP[1]));
+            m_ext->log({toHash(m_SP[2]), toHash(m_SP[3])},
+                bytesConstRef(m_mem.data() + (uint64_t)m_SP[0], (uint64_t)m_SP[1]));
         }
         NEXT
 
@@ -448,7 +472,8 @@ void LegacyVM::interpretCases()
             logGasMem();
             updateIOGas();
 
-            m_ext->log({m_SP[2], m_SP[3], m_SP[4]}, bytesConstRef(m_mem.data() + (uint64_t)m_SP[0], (uint64_t)m_SP[1]));
+            m_ext->log({toHash(m_SP[2]), toHash(m_SP[3]), toHash(m_SP[4])},
+                bytesConstRef(m_mem.data() + (uint64_t)m_SP[0], (uint64_t)m_SP[1]));
         }
         NEXT
 
@@ -461,19 +486,21 @@ void LegacyVM::interpretCases()
             logGasMem();
             updateIOGas();
 
-            m_ext->log({m_SP[2], m_SP[3], m_SP[4], m_SP[5]}, bytesConstRef(m_mem.data() + (uint64_t)m_SP[0], (uint64_t)m_SP[1]));
+            m_ext->log({toHash(m_SP[2]), toHash(m_SP[3]), toHash(m_SP[4]), toHash(m_SP[5])},
+                bytesConstRef(m_mem.data() + (uint64_t)m_SP[0], (uint64_t)m_SP[1]));
         }
         NEXT
 
         CASE(EXP)
         {
-            u256 expon = m_SP[1];
-            m_runGas = toInt63(m_schedule->expGas + m_schedule->expByteGas * (32 - (h256(expon).firstBitSet() / 8)));
+            intx::uint256 expon = m_SP[1];
+            m_runGas = toInt63(m_schedule->expGas +
+                               m_schedule->expByteGas * intx::count_significant_words<uint8_t>(expon));
             ON_OP();
             updateIOGas();
 
-            u256 base = m_SP[0];
-            m_SPP[0] = exp256(base, expon);
+            intx::uint256 base = m_SP[0];
+            m_SPP[0] = intx::exp(base, expon);
         }
         NEXT
 
@@ -515,7 +542,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_SP[1] ? divWorkaround(m_SP[0], m_SP[1]) : 0;
+            m_SPP[0] = m_SP[1] ? m_SP[0] / m_SP[1] : 0;
         }
         NEXT
 
@@ -524,7 +551,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_SP[1] ? s2u(divWorkaround(u2s(m_SP[0]), u2s(m_SP[1]))) : 0;
+            m_SPP[0] = m_SP[1] ? intx::sdivrem(m_SP[0], m_SP[1]).quot : 0;
             --m_SP;
         }
         NEXT
@@ -534,7 +561,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_SP[1] ? modWorkaround(m_SP[0], m_SP[1]) : 0;
+            m_SPP[0] = m_SP[1] ? m_SP[0] % m_SP[1] : 0;
         }
         NEXT
 
@@ -543,7 +570,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_SP[1] ? s2u(modWorkaround(u2s(m_SP[0]), u2s(m_SP[1]))) : 0;
+            m_SPP[0] = m_SP[1] ? intx::sdivrem(m_SP[0], m_SP[1]).rem : 0;
         }
         NEXT
 
@@ -579,7 +606,9 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = u2s(m_SP[0]) < u2s(m_SP[1]) ? 1 : 0;
+            bool const lhsNeg = static_cast<bool>(m_SP[0] >> 255);
+            bool const rhsNeg = static_cast<bool>(m_SP[1] >> 255);
+            m_SPP[0] = (lhsNeg != rhsNeg) ? lhsNeg : m_SP[0] < m_SP[1];
         }
         NEXT
 
@@ -588,7 +617,9 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = u2s(m_SP[0]) > u2s(m_SP[1]) ? 1 : 0;
+            bool const lhsNeg = static_cast<bool>(m_SP[0] >> 255);
+            bool const rhsNeg = static_cast<bool>(m_SP[1] >> 255);
+            m_SPP[0] = (lhsNeg != rhsNeg) ? rhsNeg : m_SP[0] > m_SP[1];
         }
         NEXT
 
@@ -687,11 +718,11 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            static u256 const hibit = u256(1) << 255;
-            static u256 const allbits =
-                u256("0xffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+            using namespace intx;
+            static constexpr uint256 hibit = 1_u256 << 255;
+            static constexpr uint256 allbits = ~0_u256;
 
-            u256 shiftee = m_SP[1];
+            uint256 shiftee = m_SP[1];
             if (m_SP[0] >= 256)
             {
                 if (shiftee & hibit)
@@ -714,7 +745,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_SP[2] ? u256((u512(m_SP[0]) + u512(m_SP[1])) % m_SP[2]) : 0;
+            m_SPP[0] = m_SP[2] ? intx::addmod(m_SP[0], m_SP[1], m_SP[2]) : 0;
         }
         NEXT
 
@@ -723,7 +754,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_SP[2] ? u256((u512(m_SP[0]) * u512(m_SP[1])) % m_SP[2]) : 0;
+            m_SPP[0] = m_SP[2] ? intx::mulmod(m_SP[0], m_SP[1], m_SP[2]) : 0;
         }
         NEXT
 
@@ -734,10 +765,12 @@ void LegacyVM::interpretCases()
 
             if (m_SP[0] < 31)
             {
+                using namespace intx;
+
                 unsigned testBit = static_cast<unsigned>(m_SP[0]) * 8 + 7;
-                u256& number = m_SP[1];
-                u256 mask = ((u256(1) << testBit) - 1);
-                if (boost::multiprecision::bit_test(number, testBit))
+                uint256& number = m_SP[1];
+                uint256 mask = ((1_u256 << testBit) - 1);
+                if (number & (1_u256 << testBit))
                     number |= ~mask;
                 else
                     number &= mask;
@@ -1204,7 +1237,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = fromAddress(m_ext->myAddress);
+            m_SPP[0] = toWord(m_ext->myAddress);
         }
         NEXT
 
@@ -1213,7 +1246,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = fromAddress(m_ext->origin);
+            m_SPP[0] = toWord(m_ext->origin);
         }
         NEXT
 
@@ -1223,7 +1256,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_ext->balance(asAddress(m_SP[0]));
+            m_SPP[0] = toWord(m_ext->balance(toAddress(m_SP[0])));
         }
         NEXT
 
@@ -1233,7 +1266,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = fromAddress(m_ext->caller);
+            m_SPP[0] = toWord(m_ext->caller);
         }
         NEXT
 
@@ -1242,7 +1275,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_ext->value;
+            m_SPP[0] = toWord(m_ext->value);
         }
         NEXT
 
@@ -1252,15 +1285,15 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            if (u512(m_SP[0]) + 31 < m_ext->data.size())
-                m_SP[0] = (u256)*(h256 const*)(m_ext->data.data() + (size_t)m_SP[0]);
+            if (intx::uint512(m_SP[0]) + 31 < m_ext->data.size())
+                m_SP[0] = intx::be::unsafe::load<intx::uint256>(m_ext->data.data() + (size_t)m_SP[0]);
             else if (m_SP[0] >= m_ext->data.size())
-                m_SP[0] = u256(0);
+                m_SP[0] = 0;
             else
             { 	h256 r;
                 for (uint64_t i = (uint64_t)m_SP[0], e = (uint64_t)m_SP[0] + (uint64_t)32, j = 0; i < e; ++i, ++j)
                     r[j] = i < m_ext->data.size() ? m_ext->data[i] : 0;
-                m_SP[0] = (u256)r;
+                m_SP[0] = toWord(r);
             };
         }
         NEXT
@@ -1302,7 +1335,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_ext->codeSizeAt(asAddress(m_SP[0]));
+            m_SPP[0] = m_ext->codeSizeAt(toAddress(m_SP[0]));
         }
         NEXT
 
@@ -1322,7 +1355,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             if (!m_schedule->haveReturnData)
                 throwBadInstruction();
-            bigint const endOfAccess = bigint(m_SP[1]) + bigint(m_SP[2]);
+            intx::uint512 const endOfAccess = intx::uint512(m_SP[1]) + intx::uint512(m_SP[2]);
             if (m_returnData.size() < endOfAccess)
                 throwBufferOverrun(endOfAccess);
 
@@ -1343,7 +1376,7 @@ void LegacyVM::interpretCases()
             m_runGas = toInt63(m_schedule->extcodehashGas);
             updateIOGas();
 
-            m_SPP[0] = u256{m_ext->codeHashAt(asAddress(m_SP[0]))};
+            m_SPP[0] = toWord(m_ext->codeHashAt(toAddress(m_SP[0])));
         }
         NEXT
 
@@ -1366,7 +1399,7 @@ void LegacyVM::interpretCases()
             updateMem(memNeed(m_SP[1], m_SP[3]));
             updateIOGas();
 
-            Address a = asAddress(m_SP[0]);
+            Address a = toAddress(m_SP[0]);
             copyDataToMemory(&m_ext->codeAt(a), m_SP + 1);
         }
         NEXT
@@ -1377,7 +1410,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_ext->gasPrice;
+            m_SPP[0] = toWord(m_ext->gasPrice);
         }
         NEXT
 
@@ -1387,7 +1420,7 @@ void LegacyVM::interpretCases()
             m_runGas = toInt63(m_schedule->blockhashGas);
             updateIOGas();
 
-            m_SPP[0] = (u256)m_ext->blockHash(m_SP[0]);
+            m_SPP[0] = toWord(m_ext->blockHash(fromWord(m_SP[0])));
         }
         NEXT
 
@@ -1396,7 +1429,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = (u160)m_ext->envInfo().author();
+            m_SPP[0] = toWord(m_ext->envInfo().author());
         }
         NEXT
 
@@ -1423,7 +1456,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_ext->envInfo().difficulty();
+            m_SPP[0] = toWord(m_ext->envInfo().difficulty());
         }
         NEXT
 
@@ -1432,7 +1465,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_ext->envInfo().gasLimit();
+            m_SPP[0] = toWord(m_ext->envInfo().gasLimit());
         }
         NEXT
 
@@ -1445,7 +1478,7 @@ void LegacyVM::interpretCases()
 
             updateIOGas();
 
-            m_SPP[0] = m_ext->envInfo().chainID();
+            m_SPP[0] = toWord(m_ext->envInfo().chainID());
         }
         NEXT
 
@@ -1458,7 +1491,7 @@ void LegacyVM::interpretCases()
 
             updateIOGas();
 
-            m_SPP[0] = m_ext->balance(m_ext->myAddress);
+            m_SPP[0] = toWord(m_ext->balance(m_ext->myAddress));
         }
         NEXT
 
@@ -1619,9 +1652,9 @@ void LegacyVM::interpretCases()
             unsigned n = (unsigned)m_OP - (unsigned)Instruction::DUP1;
             *(uint64_t*)m_SPP = *(uint64_t*)(m_SP + n);
 
-            // the stack slot being copied into may no longer hold a u256
+            // the stack slot being copied into may no longer hold a uint256
             // so we construct a new one in the memory, rather than assign
-            new(m_SPP) u256(m_SP[n]);
+            new(m_SPP) intx::uint256(m_SP[n]);
         }
         NEXT
 
@@ -1658,7 +1691,7 @@ void LegacyVM::interpretCases()
             ON_OP();
             updateIOGas();
 
-            m_SPP[0] = m_ext->store(m_SP[0]);
+            m_SPP[0] = toWord(m_ext->store(fromWord(m_SP[0])));
         }
         NEXT
 
@@ -1671,7 +1704,7 @@ void LegacyVM::interpretCases()
             updateSSGas();
             updateIOGas();
 
-            m_ext->setStore(m_SP[0], m_SP[1]);
+            m_ext->setStore(fromWord(m_SP[0]), fromWord(m_SP[1]));
         }
         NEXT
 
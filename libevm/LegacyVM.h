@@ -8,6 +8,8 @@
 #include "LegacyVMConfig.h"
 #include "VMFace.h"
 
+#include <intx/intx.hpp>
+
 namespace dev
 {
 namespace eth
@@ -21,13 +23,19 @@ public:
 #if EIP_615
     // invalid code will throw an exeption
     void validate(ExtVMFace& _ext);
-    void validateSubroutine(uint64_t _PC, uint64_t* _rp, u256* _sp);
+    void validateSubroutine(uint64_t _PC, uint64_t* _rp, intx::uint256* _sp);
 #endif
 
+    /// Drops what the last frame left behind and frees the buffers that grew beyond
+    /// @a _maxBufferSize bytes, so that the VM can be kept for another frame.
+    void recycle(size_t _maxBufferSize);
+
     bytes const& memory() const { return m_mem; }
     u256s stack() const {
-        u256s stack(m_SP, m_stackEnd);
-        reverse(stack.begin(), stack.end());
+        u256s stack;
+        stack.reserve(m_stackEnd - m_SP);
+        for (auto item = m_stackEnd; item != m_SP; --item)
+            stack.push_back(fromWord(item[-1]));
         return stack;
     };
 
@@ -40,7 +48,26 @@ private:
 
     static std::array<InstructionMetric, 256> c_metrics;
     static void initMetrics();
-    static u256 exp256(u256 _base, u256 _exponent);
+
+    /// Conversions between stack words and the numbers, hashes and addresses of ExtVMFace.
+    static intx::uint256 toWord(h256 const& _hash)
+    {
+        return intx::be::unsafe::load<intx::uint256>(_hash.data());
+    }
+    static intx::uint256 toWord(u256 const& _number) { return toWord(h256{_number}); }
+    static intx::uint256 toWord(Address const& _address)
+    {
+        return toWord(h256{_address, h256::AlignRight});
+    }
+    static h256 toHash(intx::uint256 const& _word)
+    {
+        h256 ret;
+        intx::be::unsafe::store(ret.data(), _word);
+        return ret;
+    }
+    static u256 fromWord(intx::uint256 const& _word) { return u256{toHash(_word)}; }
+    static Address toAddress(intx::uint256 const& _word) { return right160(toHash(_word)); }
+
     void copyCode(int);
     typedef void (LegacyVM::*MemFnPtr)();
     MemFnPtr m_bounce = 0;
@@ -61,8 +88,8 @@ private:
     bytes m_returnData;
 
     // space for data stack, grows towards smaller addresses from the end
-    u256 m_stack[1024];
-    u256 *m_stackEnd = &m_stack[1024];
+    intx::uint256 m_stack[1024];
+    intx::uint256 *m_stackEnd = &m_stack[1024];
     size_t stackSize() { return m_stackEnd - m_SP; }
     
 #if EIP_615
@@ -74,13 +101,13 @@ private:
 #endif
 
     // constant pool
-    std::vector<u256> m_pool;
+    std::vector<intx::uint256> m_pool;
 
     // interpreter state
     Instruction m_OP;                   // current operation
     uint64_t    m_PC    = 0;            // program counter
-    u256*       m_SP    = m_stackEnd;   // stack pointer
-    u256*       m_SPP   = m_SP;         // stack pointer prime (next SP)
+    intx::uint256* m_SP = m_stackEnd;   // stack pointer
+    intx::uint256* m_SPP = m_SP;        // stack pointer prime (next SP)
 #if EIP_615
     uint64_t*   m_RP    = m_return - 1; // return pointer
 #endif
@@ -102,8 +129,8 @@ private:
     bool caseCallSetup(CallParameters*, bytesRef& o_output);
     void caseCall();
 
-    void copyDataToMemory(bytesConstRef _data, u256*_sp);
-    uint64_t memNeed(u256 const& _offset, u256 const& _size);
+    void copyDataToMemory(bytesConstRef _data, intx::uint256*_sp);
+    uint64_t memNeed(intx::uint256 const& _offset, intx::uint256 const& _size);
 
     void throwOutOfGas();
     void throwBadInstruction();
@@ -111,16 +138,16 @@ private:
     void throwBadStack(unsigned _removed, unsigned _added);
     void throwRevertInstruction(owning_bytes_ref&& _output);
     void throwDisallowedStateChange();
-    void throwBufferOverrun(bigint const& _enfOfAccess);
+    void throwBufferOverrun(intx::uint512 const& _enfOfAccess);
 
     std::vector<uint64_t> m_beginSubs;
     std::vector<uint64_t> m_jumpDests;
-    int64_t verifyJumpDest(u256 const& _dest, bool _throw = true);
+    int64_t verifyJumpDest(intx::uint256 const& _dest, bool _throw = true);
 
     void onOperation() { onOperation(m_OP); }
     void onOperation(Instruction _instr);
     void adjustStack(unsigned _removed, unsigned _added);
-    uint64_t gasForMem(u512 const& _size);
+    uint64_t gasForMem(intx::uint512 const& _size);
     void updateSSGas();
     void updateSSGasPreEIP1283(u256 const& _currentValue, u256 const& _newValue);
     void updateSSGasEIP1283(u256 const& _currentValue, u256 const& _newValue);
@@ -192,8 +219,8 @@ private:
     void xswizzle(uint8_t);
     void xshuffle(uint8_t);
     
-    u256 vtow(uint8_t _b, const u256& _in);
-    void wtov(uint8_t _b, u256 _in, u256& _o_out);
+    intx::uint256 vtow(uint8_t _b, const intx::uint256& _in);
+    void wtov(uint8_t _b, intx::uint256 _in, intx::uint256& _o_out);
 
     uint8_t simdType()
     {
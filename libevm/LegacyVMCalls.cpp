@@ -8,10 +8,10 @@ using namespace dev;
 using namespace dev::eth;
 
 
-void LegacyVM::copyDataToMemory(bytesConstRef _data, u256*_sp)
+void LegacyVM::copyDataToMemory(bytesConstRef _data, intx::uint256*_sp)
 {
     auto offset = static_cast<size_t>(_sp[0]);
-    s512 bigIndex = _sp[1];
+    intx::uint512 bigIndex = _sp[1];
     auto index = static_cast<size_t>(bigIndex);
     auto size = static_cast<size_t>(_sp[2]);
 
@@ -72,15 +72,17 @@ void LegacyVM::throwRevertInstruction(owning_bytes_ref&& _output)
     throw RevertInstruction(move(_output));
 }
 
-void LegacyVM::throwBufferOverrun(bigint const& _endOfAccess)
+void LegacyVM::throwBufferOverrun(intx::uint512 const& _endOfAccess)
 {
     // todo: disable this m_onFail, may result in duplicate log step in the trace
     if (m_onFail)
         (this->*m_onFail)();
-    BOOST_THROW_EXCEPTION(BufferOverrun() << RequirementError(_endOfAccess, bigint(m_returnData.size())));
+    BOOST_THROW_EXCEPTION(
+        BufferOverrun() << RequirementError(
+            bigint(std::string("0x") + intx::hex(_endOfAccess)), bigint(m_returnData.size())));
 }
 
-int64_t LegacyVM::verifyJumpDest(u256 const& _dest, bool _throw)
+int64_t LegacyVM::verifyJumpDest(intx::uint256 const& _dest, bool _throw)
 {
     // check for overflow
     if (_dest <= 0x7FFFFFFFFFFFFFFF) {
@@ -107,16 +109,16 @@ void LegacyVM::caseCreate()
     m_runGas = toInt63(m_schedule->createGas);
 
     // Collect arguments.
-    u256 const endowment = m_SP[0];
-    u256 const initOff = m_SP[1];
-    u256 const initSize = m_SP[2];
+    u256 const endowment = fromWord(m_SP[0]);
+    intx::uint256 const initOff = m_SP[1];
+    intx::uint256 const initSize = m_SP[2];
 
     u256 salt;
     if (m_OP == Instruction::CREATE2)
     {
-        salt = m_SP[3];
+        salt = fromWord(m_SP[3]);
         // charge for hashing initCode = GSHA3WORD * ceil(len(init_code) / 32)
-        m_runGas += toInt63((u512{initSize} + 31) / 32 * m_schedule->sha3WordGas);
+        m_runGas += toInt63((intx::uint512{initSize} + 31) / 32 * m_schedule->sha3WordGas);
     }
 
     updateMem(memNeed(initOff, initSize));
@@ -140,8 +142,8 @@ void LegacyVM::caseCreate()
 
 
         CreateResult result = m_ext->create(endowment, gas, initCode, m_OP, salt, m_onOp);
-        m_SPP[0] = (u160)result.address;  // Convert address to integer.
-        m_returnData = result.output.toBytes();
+        m_SPP[0] = toWord(result.address);
+        m_returnData.assign(result.output.begin(), result.output.end());
 
         *m_io_gas_p -= (createGas - gas);
         m_io_gas = uint64_t(*m_io_gas_p);
@@ -173,8 +175,8 @@ void LegacyVM::caseCall()
         //    higher memory footprint, no memory copy.
         // 2. Copy only the return data from the returned memory buffer:
         //    minimal memory footprint, additional memory copy.
-        // Option 2 used:
-        m_returnData = result.output.toBytes();
+        // Option 2 used, into the capacity the buffer already has:
+        m_returnData.assign(result.output.begin(), result.output.end());
 
         m_SPP[0] = result.status == EVMC_SUCCESS ? 1 : 0;
     }
@@ -191,7 +193,7 @@ bool LegacyVM::caseCallSetup(CallParameters *callParams, bytesRef& o_output)
     assert(callParams->apparentValue == 0);
 
     callParams->staticCall = (m_OP == Instruction::STATICCALL || m_ext->staticCall);
-    auto const destinationAddr = asAddress(m_SP[1]);
+    auto const destinationAddr = toAddress(m_SP[1]);
     if (callParams->staticCall && isPrecompiledContract(destinationAddr))
         m_runGas += toInt63(m_schedule->precompileStaticCallGas);
     else
@@ -209,10 +211,10 @@ bool LegacyVM::caseCallSetup(CallParameters *callParams, bytesRef& o_output)
         m_runGas += toInt63(m_schedule->callValueTransferGas);
 
     size_t const sizesOffset = haveValueArg ? 3 : 2;
-    u256 inputOffset  = m_SP[sizesOffset];
-    u256 inputSize    = m_SP[sizesOffset + 1];
-    u256 outputOffset = m_SP[sizesOffset + 2];
-    u256 outputSize   = m_SP[sizesOffset + 3];
+    intx::uint256 inputOffset  = m_SP[sizesOffset];
+    intx::uint256 inputSize    = m_SP[sizesOffset + 1];
+    intx::uint256 outputOffset = m_SP[sizesOffset + 2];
+    intx::uint256 outputSize   = m_SP[sizesOffset + 3];
     uint64_t inputMemNeed = memNeed(inputOffset, inputSize);
     uint64_t outputMemNeed = memNeed(outputOffset, outputSize);
 
@@ -224,13 +226,13 @@ bool LegacyVM::caseCallSetup(CallParameters *callParams, bytesRef& o_output)
     if (m_schedule->staticCallDepthLimit())
     {
         // With static call depth limit we just charge the provided gas amount.
-        callParams->gas = m_SP[0];
+        callParams->gas = fromWord(m_SP[0]);
     }
     else
     {
         // Apply "all but one 64th" rule.
         u256 maxAllowedCallGas = m_io_gas - m_io_gas / 64;
-        callParams->gas = std::min(m_SP[0], maxAllowedCallGas);
+        callParams->gas = std::min(fromWord(m_SP[0]), maxAllowedCallGas);
     }
 
     m_runGas = toInt63(callParams->gas);
@@ -243,8 +245,8 @@ bool LegacyVM::caseCallSetup(CallParameters *callParams, bytesRef& o_output)
 
     if (haveValueArg)
     {
-        callParams->valueTransfer = m_SP[2];
-        callParams->apparentValue = m_SP[2];
+        callParams->valueTransfer = fromWord(m_SP[2]);
+        callParams->apparentValue = callParams->valueTransfer;
     }
     else if (m_OP == Instruction::DELEGATECALL)
         // Forward VALUE.
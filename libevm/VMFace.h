@@ -62,6 +62,17 @@ public:
 
 /// Helpers:
 
+/// @returns a copy of @a _size bytes of the VM memory @a _memory from @a _begin, which the memory
+/// cost paid makes sure are within it. Copied rather than moved out, so that the memory buffer
+/// keeps its capacity for the next frame run by the VM.
+inline owning_bytes_ref copyMemory(bytes const& _memory, uint64_t _begin, uint64_t _size)
+{
+    if (_size == 0)
+        return {};
+    auto const begin = _memory.begin() + static_cast<size_t>(_begin);
+    return owning_bytes_ref{bytes(begin, begin + static_cast<size_t>(_size)), 0, _size};
+}
+
 // Convert from a 256-bit integer stack/memory entry into a 160-bit Address hash.
 // Currently we just pull out the right (low-order in BE) 160-bits.
 inline Address asAddress(u256 _item)
@@ -7,9 +7,12 @@
 #include "LegacyVM.h"
 
 #include <libaleth-interpreter/interpreter.h>
+#include <libdevcore/ObjectPool.h>
 
 #include <evmc/loader.h>
 
+#include <atomic>
+
 namespace po = boost::program_options;
 
 namespace dev
@@ -29,6 +32,33 @@ std::unique_ptr<EVMC> g_evmcDll;
 /// The list of EVMC options stored as pairs of (name, value).
 std::vector<std::pair<std::string, std::string>> s_evmcOptions;
 
+std::atomic<bool> g_pooling{true};
+
+/// The most LegacyVM instances kept by a thread, enough for the call depths seen in practice.
+/// Deeper frames get VMs that are freed when they return.
+size_t const c_maxPooledVMs = 64;
+
+/// Buffers of a pooled VM larger than this are freed, so that the pool does not keep the memory
+/// of the rare frame that expanded its memory a lot.
+size_t const c_maxPooledBufferSize = 1024 * 1024;
+
+/// LegacyVM instances freed by finished frames, kept for the next ones on the same thread.
+///
+/// A frame creates its VM when it starts and frees it when it returns, so a frame at some call
+/// depth gets the VM the previous frame at that depth ran in, with buffers already sized for
+/// similar code.
+thread_local ObjectPool<LegacyVM> t_legacyVMs{c_maxPooledVMs, c_maxPooledBufferSize};
+
+void recycleLegacyVM(VMFace* _vm) noexcept
+{
+    t_legacyVMs.recycle(static_cast<LegacyVM*>(_vm));
+}
+
+VMPtr createLegacyVM()
+{
+    return {t_legacyVMs.take(), recycleLegacyVM};
+}
+
 /// A helper type to build the tabled of VM implementations.
 ///
 /// More readable than std::tuple.
@@ -155,6 +185,15 @@ po::options_description vmProgramOptions(unsigned _lineLength)
     return opts;
 }
 
+void VMFactory::setKind(std::string const& _name)
+{
+    setVMKind(_name);
+}
+
+void VMFactory::setPooling(bool _pooling)
+{
+    g_pooling = _pooling;
+}
 
 VMPtr VMFactory::create()
 {
@@ -176,6 +215,8 @@ VMPtr VMFactory::create(VMKind _kind)
         return {g_evmcDll.get(), null_delete};
     case VMKind::Legacy:
     default:
+        if (g_pooling)
+            return createLegacyVM();
         return {new LegacyVM, default_delete};
     }
 }
@@ -37,7 +37,19 @@ public:
     static VMPtr create();
 
     /// Creates a VM instance of the kind provided.
+    ///
+    /// Legacy VMs are taken from a pool of the calling thread when it has one, and go back to it
+    /// when the pointer is released, so that nested call frames reuse the VMs and buffers of
+    /// earlier frames instead of allocating their own.
     static VMPtr create(VMKind _kind);
+
+    /// Sets the global kind as the --vm option does: @a _name is the name of a built-in VM or the
+    /// path of an EVMC VM to load, which replaces the one loaded before.
+    static void setKind(std::string const& _name);
+
+    /// Sets whether Legacy VMs are pooled, which they are by default. Turning it off is meant for
+    /// comparing the two in benchmarks.
+    static void setPooling(bool _pooling);
 };
 }  // namespace eth
 }  // namespace dev
@@ -0,0 +1,124 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "VMProfiler.h"
+
+#include <libdevcore/Guards.h>
+
+#include <atomic>
+
+namespace dev
+{
+namespace eth
+{
+namespace
+{
+std::atomic<bool> g_enabled{false};
+
+Mutex x_profile;
+VMProfile g_profile;
+}  // namespace
+
+void OperationProfile::add(OperationProfile const& _other)
+{
+    count += _other.count;
+    nanoseconds += _other.nanoseconds;
+    gas += _other.gas;
+}
+
+void VMProfile::add(VMProfile const& _other)
+{
+    executions += _other.executions;
+    for (size_t i = 0; i < opcodes.size(); ++i)
+        opcodes[i].add(_other.opcodes[i]);
+    for (auto const& contract : _other.contracts)
+        contracts[contract.first].add(contract.second);
+    if (depths.size() < _other.depths.size())
+        depths.resize(_other.depths.size());
+    for (size_t i = 0; i < _other.depths.size(); ++i)
+        depths[i].add(_other.depths[i]);
+}
+
+void VMProfiler::setEnabled(bool _enabled)
+{
+    g_enabled = _enabled;
+}
+
+bool VMProfiler::isEnabled()
+{
+    return g_enabled;
+}
+
+VMProfile VMProfiler::profile(bool _reset)
+{
+    Guard l(x_profile);
+    VMProfile ret = g_profile;
+    if (_reset)
+        g_profile = VMProfile{};
+    return ret;
+}
+
+VMProfiler::Session::~Session()
+{
+    if (!m_hasPending)
+        return;
+
+    finishPending(std::chrono::steady_clock::now(), 0, nullptr);
+    m_profile.executions = 1;
+    Guard l(x_profile);
+    g_profile.add(m_profile);
+}
+
+OnOpFunc VMProfiler::Session::onOp()
+{
+    return [this](uint64_t, uint64_t _pc, Instruction _instruction, bigint const&,
+               bigint const& _gasCost, bigint const& _gas, VMFace const*, ExtVMFace const* _ext) {
+        record(_pc, _instruction, static_cast<uint64_t>(_gasCost), static_cast<uint64_t>(_gas),
+            _ext);
+    };
+}
+
+void VMProfiler::Session::record(uint64_t _pc, Instruction _instruction, uint64_t _gasCost,
+    uint64_t _gasLeft, ExtVMFace const* _ext)
+{
+    // The legacy VM reports an operation again when it fails after reporting it (m_onFail). A
+    // frame can't run the same pc twice in a row, so this is that second report.
+    if (m_hasPending && _ext == m_pending.ext && _pc == m_pending.pc)
+        return;
+
+    auto const now = std::chrono::steady_clock::now();
+    if (m_hasPending)
+        finishPending(now, _gasLeft, _ext);
+    m_pending = {_ext, _pc, _ext->codeHash, _ext->depth, _instruction, _gasLeft, _gasCost, now};
+    m_hasPending = true;
+}
+
+void VMProfiler::Session::finishPending(
+    std::chrono::steady_clock::time_point _now, uint64_t _gasLeft, ExtVMFace const* _ext)
+{
+    OperationProfile operation;
+    operation.count = 1;
+    operation.nanoseconds =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(_now - m_pending.start).count();
+    // The gas left before the next operation of the same frame includes the dynamic costs. The
+    // next operation of another frame only tells the static cost.
+    operation.gas = _ext == m_pending.ext && _gasLeft <= m_pending.gasLeft ?
+                        m_pending.gasLeft - _gasLeft :
+                        m_pending.gasCost;
+
+    m_profile.opcodes[static_cast<uint8_t>(m_pending.instruction)].add(operation);
+
+    if (!m_contract || m_contractHash != m_pending.codeHash)
+    {
+        m_contractHash = m_pending.codeHash;
+        m_contract = &m_profile.contracts[m_contractHash];
+    }
+    m_contract->add(operation);
+
+    if (m_profile.depths.size() <= m_pending.depth)
+        m_profile.depths.resize(m_pending.depth + 1);
+    m_profile.depths[m_pending.depth].add(operation);
+}
+}  // namespace eth
+}  // namespace dev
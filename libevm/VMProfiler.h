@@ -0,0 +1,93 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Opt-in profile of the operations executed by the VM, aggregated over all executions.
+#pragma once
+
+#include "ExtVMFace.h"
+
+#include <array>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+struct OperationProfile
+{
+    uint64_t count = 0;        ///< Operations executed
+    uint64_t nanoseconds = 0;  ///< Time until the next operation or the end of the execution
+    uint64_t gas = 0;
+
+    void add(OperationProfile const& _other);
+};
+
+struct VMProfile
+{
+    uint64_t executions = 0;  ///< Top-level message calls and creations that ran code
+    std::array<OperationProfile, 256> opcodes;
+    std::unordered_map<h256, OperationProfile> contracts;  ///< Keyed by code hash
+    std::vector<OperationProfile> depths;                  ///< Indexed by call depth
+
+    void add(VMProfile const& _other);
+};
+
+/// Records the operations through the OnOpFunc hook, so it costs nothing while disabled and
+/// only profiles the VMs reporting their operations, which is the legacy VM.
+class VMProfiler
+{
+public:
+    VMProfiler() = delete;
+    ~VMProfiler() = delete;
+
+    static void setEnabled(bool _enabled);
+    static bool isEnabled();
+
+    /// @returns everything recorded since the start or the last reset, and starts over if
+    /// @a _reset is true.
+    static VMProfile profile(bool _reset = false);
+
+    /// Profile of one top-level execution, merged into the global profile when destroyed.
+    class Session
+    {
+    public:
+        Session() = default;
+        ~Session();
+        Session(Session const&) = delete;
+        Session& operator=(Session const&) = delete;
+
+        /// @returns the function to execute with; it must not outlive the session.
+        OnOpFunc onOp();
+
+    private:
+        struct Operation
+        {
+            ExtVMFace const* ext;  ///< Only compared, the frame may have returned since
+            uint64_t pc;
+            h256 codeHash;
+            unsigned depth;
+            Instruction instruction;
+            uint64_t gasLeft;
+            uint64_t gasCost;
+            std::chrono::steady_clock::time_point start;
+        };
+
+        void record(uint64_t _pc, Instruction _instruction, uint64_t _gasCost, uint64_t _gasLeft,
+            ExtVMFace const* _ext);
+        /// Attribute the time until @a _now and the gas used to the pending operation.
+        void finishPending(std::chrono::steady_clock::time_point _now, uint64_t _gasLeft,
+            ExtVMFace const* _ext);
+
+        VMProfile m_profile;
+        bool m_hasPending = false;
+        Operation m_pending;
+        h256 m_contractHash;  ///< Code hash of m_contract
+        OperationProfile* m_contract = nullptr;
+    };
+};
+}  // namespace eth
+}  // namespace dev
@@ -66,6 +66,18 @@ public:
             session->sealAndSend(_s);
     }
 
+    void sealAndSend(NodeID const& _nodeID, std::string const& _capabilityName, unsigned _id,
+        std::shared_ptr<bytes const> const& _data) override
+    {
+        auto session = m_host.peerSession(_nodeID);
+        if (!session)
+            return;
+
+        auto const offset = session->capabilityOffset(_capabilityName);
+        if (offset)
+            session->sealAndSend(static_cast<byte>(_id + *offset), _data);
+    }
+
     void addNote(NodeID const& _nodeID, std::string const& _k, std::string const& _v) override
     {
         auto session = m_host.peerSession(_nodeID);
@@ -51,6 +51,12 @@ public:
     /// Has no effect if the peer is not connected.
     virtual void sealAndSend(NodeID const& _nodeID, RLPStream& _s) = 0;
 
+    /// Sends the message with ID @a _id and data @a _data to the peer. The data is the RLP list
+    /// that would otherwise follow prep(), encoded once and shared by all peers it is sent to.
+    /// Has no effect if the peer is not connected.
+    virtual void sealAndSend(NodeID const& _nodeID, std::string const& _capabilityName,
+        unsigned _id, std::shared_ptr<bytes const> const& _data) = 0;
+
     /// Associate arbritrary key/value metadata with the peer.
     /// This saved data will be returned from peerSessionInfo().
     /// Has no effect if the peer is not connected.
@@ -192,6 +192,40 @@ void RLPXFrameCoder::writeSingleFramePacket(bytesConstRef _packet, bytes& o_byte
 	writeFrame(header, _packet, o_bytes);
 }
 
+void RLPXFrameCoder::writeSingleFramePacket(bytesConstRef _packetType, bytesConstRef _packetData, bytes& o_bytes)
+{
+	size_t const len = _packetType.size() + _packetData.size();
+	size_t const padding = (16 - (len % 16)) % 16;
+	o_bytes.resize(h256::size + len + padding + h128::size);
+
+	// Header is frame-size || legacy protocol-type and sequence-id, zero-filled to 16 bytes.
+	bytesRef headerRef(o_bytes.data(), h128::size);
+	std::fill(headerRef.begin(), headerRef.end(), 0);
+	headerRef[0] = byte((len >> 16) & 0xff);
+	headerRef[1] = byte((len >> 8) & 0xff);
+	headerRef[2] = byte(len & 0xff);
+	headerRef[3] = 0xc2;
+	headerRef[4] = 0x80;
+	headerRef[5] = 0x80;
+	m_impl->frameEnc.ProcessData(headerRef.data(), headerRef.data(), h128::size);
+	updateEgressMACWithHeader(headerRef);
+	egressDigest().ref().copyTo(bytesRef(o_bytes.data() + h128::size, h128::size));
+
+	byte* frame = o_bytes.data() + h256::size;
+	if (!_packetType.empty())
+		m_impl->frameEnc.ProcessData(frame, _packetType.data(), _packetType.size());
+	if (!_packetData.empty())
+		m_impl->frameEnc.ProcessData(frame + _packetType.size(), _packetData.data(), _packetData.size());
+	if (padding)
+	{
+		bytesRef paddingRef(frame + len, padding);
+		std::fill(paddingRef.begin(), paddingRef.end(), 0);
+		m_impl->frameEnc.ProcessData(paddingRef.data(), paddingRef.data(), padding);
+	}
+	updateEgressMACWithFrame(bytesRef(frame, len + padding));
+	egressDigest().ref().copyTo(bytesRef(frame + len + padding, h128::size));
+}
+
 bool RLPXFrameCoder::authAndDecryptHeader(bytesRef io)
 {
 	asserts(io.size() == h256::size);
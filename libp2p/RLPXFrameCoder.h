@@ -82,6 +82,11 @@ public:
     /// Legacy. Encrypt _packet as ill-defined legacy RLPx frame.
     void writeSingleFramePacket(bytesConstRef _packet, bytes& o_bytes);
 
+    /// Legacy. Encrypt the packet made of @a _packetType followed by @a _packetData as ill-defined
+    /// legacy RLPx frame, directly into @a o_bytes. The capacity of @a o_bytes is reused, so it can
+    /// be a recycled buffer; neither input may point into it.
+    void writeSingleFramePacket(bytesConstRef _packetType, bytesConstRef _packetData, bytes& o_bytes);
+
     /// Authenticate and decrypt header in-place.
     bool authAndDecryptHeader(bytesRef io_cipherWithMac);
 
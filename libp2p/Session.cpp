@@ -15,6 +15,18 @@ using namespace std;
 using namespace dev;
 using namespace dev::p2p;
 
+namespace
+{
+/// Maximum number of frames coalesced into a single socket write.
+size_t const c_maxFramesPerWrite = 64;
+
+/// Maximum number of frame buffers kept for reuse by a session.
+size_t const c_maxPooledFrames = 16;
+
+/// Frame buffers larger than this are released rather than kept for reuse.
+size_t const c_maxPooledFrameCapacity = 1024 * 1024;
+}
+
 Session::Session(Host* _h, unique_ptr<RLPXFrameCoder>&& _io, std::shared_ptr<RLPXSocket> const& _s,
     std::shared_ptr<Peer> const& _n, PeerSessionInfo _info)
   : m_server(_h),
@@ -190,9 +202,14 @@ RLPStream& Session::prep(RLPStream& _s, P2pPacketType _id, unsigned _args)
 
 void Session::sealAndSend(RLPStream& _s)
 {
-    bytes b;
-    _s.swapOut(b);
-    send(move(b));
+    EgressPacket p;
+    _s.swapOut(p.packet);
+    send(move(p));
+}
+
+void Session::sealAndSend(byte _packetType, std::shared_ptr<bytes const> const& _data)
+{
+    send(EgressPacket{bytes(1, _packetType), _data});
 }
 
 bool Session::checkPacket(bytesConstRef _msg)
@@ -204,13 +221,18 @@ bool Session::checkPacket(bytesConstRef _msg)
     return true;
 }
 
-void Session::send(bytes&& _msg)
+void Session::send(EgressPacket&& _packet)
 {
-    bytesConstRef msg(&_msg);
-    LOG(m_netLoggerDetail) << capabilityPacketTypeToString(_msg[0]) << " to";
-    if (!checkPacket(msg))
-        clog(VerbosityError, "net") << "Invalid packet constructed. Size: " << msg.size()
-                                    << " bytes, message: " << toHex(msg);
+    LOG(m_netLoggerDetail) << capabilityPacketTypeToString(_packet.packet[0]) << " to";
+    bool const valid = _packet.sharedData ?
+                           _packet.packet[0] <= 0x7f && !_packet.sharedData->empty() &&
+                               RLP(*_packet.sharedData).actualSize() == _packet.sharedData->size() :
+                           checkPacket(&_packet.packet);
+    if (!valid)
+        clog(VerbosityError, "net")
+            << "Invalid packet constructed. Size: "
+            << _packet.packet.size() + (_packet.sharedData ? _packet.sharedData->size() : 0)
+            << " bytes, type: " << unsigned(_packet.packet[0]);
 
     if (!m_socket->ref().is_open())
         return;
@@ -218,8 +240,9 @@ void Session::send(bytes&& _msg)
     bool doWrite = false;
     DEV_GUARDED(x_framing)
     {
-        m_writeQueue.push_back(std::move(_msg));
-        doWrite = (m_writeQueue.size() == 1);
+        m_writeQueue.push_back(std::move(_packet));
+        doWrite = !m_writing;
+        m_writing = true;
     }
 
     if (doWrite)
@@ -228,14 +251,35 @@ void Session::send(bytes&& _msg)
 
 void Session::write()
 {
-    bytes const* out = nullptr;
+    vector<ba::const_buffer> buffers;
     DEV_GUARDED(x_framing)
     {
-        m_io->writeSingleFramePacket(&m_writeQueue[0], m_writeQueue[0]);
-        out = &m_writeQueue[0];
+        // Frames must be encrypted in queue order, as they share the egress cipher and MAC state.
+        size_t const count = min(m_writeQueue.size(), c_maxFramesPerWrite);
+        for (size_t i = 0; i < count; ++i)
+        {
+            bytes frame;
+            if (!m_framePool.empty())
+            {
+                frame = move(m_framePool.back());
+                m_framePool.pop_back();
+            }
+
+            EgressPacket const& p = m_writeQueue[i];
+            bytesConstRef const packet(&p.packet);
+            if (p.sharedData)
+                m_io->writeSingleFramePacket(packet, bytesConstRef(p.sharedData.get()), frame);
+            else
+                m_io->writeSingleFramePacket(packet.cropped(0, 1), packet.cropped(1), frame);
+            m_framesInFlight.push_back(move(frame));
+        }
+        m_writeQueue.erase(m_writeQueue.begin(), m_writeQueue.begin() + count);
+
+        for (auto const& frame : m_framesInFlight)
+            buffers.push_back(ba::buffer(frame));
     }
     auto self(shared_from_this());
-    ba::async_write(m_socket->ref(), ba::buffer(*out),
+    ba::async_write(m_socket->ref(), buffers,
         [this, self](boost::system::error_code ec, std::size_t /*length*/) {
             // must check queue, as write callback can occur following dropped()
             if (ec)
@@ -247,9 +291,17 @@ void Session::write()
 
             DEV_GUARDED(x_framing)
             {
-                m_writeQueue.pop_front();
+                for (auto& frame : m_framesInFlight)
+                    if (m_framePool.size() < c_maxPooledFrames &&
+                        frame.capacity() <= c_maxPooledFrameCapacity)
+                        m_framePool.push_back(move(frame));
+                m_framesInFlight.clear();
+
                 if (m_writeQueue.empty())
+                {
+                    m_writing = false;
                     return;
+                }
             }
             write();
         });
@@ -43,6 +43,10 @@ public:
 
     virtual void sealAndSend(RLPStream& _s) = 0;
 
+    /// Send the packet of type @a _packetType with RLP data @a _data, which can be shared with
+    /// other sessions sending the same data.
+    virtual void sealAndSend(byte _packetType, std::shared_ptr<bytes const> const& _data) = 0;
+
     virtual int rating() const = 0;
     virtual void addRating(int _r) = 0;
 
@@ -89,6 +93,7 @@ public:
     NodeID id() const override;
 
     void sealAndSend(RLPStream& _s) override;
+    void sealAndSend(byte _packetType, std::shared_ptr<bytes const> const& _data) override;
 
     int rating() const override;
     void addRating(int _r) override;
@@ -115,9 +120,17 @@ public:
     boost::optional<unsigned> capabilityOffset(std::string const& _capabilityName) const override;
 
 private:
+    /// Packet waiting to be framed. Unless the data is shared, @a packet holds the whole packet;
+    /// otherwise it holds only the packet type.
+    struct EgressPacket
+    {
+        bytes packet;
+        std::shared_ptr<bytes const> sharedData;
+    };
+
     static RLPStream& prep(RLPStream& _s, P2pPacketType _t, unsigned _args = 0);
 
-    void send(bytes&& _msg);
+    void send(EgressPacket&& _packet);
 
     /// Drop the connection for the reason @a _r.
     void drop(DisconnectReason _r);
@@ -128,7 +141,8 @@ private:
     /// Check error code after reading and drop peer if error code.
     bool checkRead(std::size_t _expected, boost::system::error_code _ec, std::size_t _length);
 
-    /// Perform a single round of the write operation. This could end up calling itself asynchronously.
+    /// Perform a single round of the write operation, framing all queued packets into a single
+    /// write. This could end up calling itself asynchronously.
     void write();
 
     /// Deliver RLPX packet to Session or PeerCapability for interpretation.
@@ -155,7 +169,10 @@ private:
     std::unique_ptr<RLPXFrameCoder> m_io;	///< Transport over which packets are sent.
     std::shared_ptr<RLPXSocket> m_socket;		///< Socket of peer's connection.
     Mutex x_framing;						///< Mutex for the write queue.
-    std::deque<bytes> m_writeQueue;			///< The write queue.
+    std::deque<EgressPacket> m_writeQueue;	///< Packets not yet framed.
+    bool m_writing = false;					///< Whether a write is in progress.
+    std::vector<bytes> m_framesInFlight;	///< Frames of the write in progress.
+    std::vector<bytes> m_framePool;			///< Frame buffers to reuse.
     std::vector<byte> m_data;			    ///< Buffer for ingress packet data.
     bytes m_incoming;						///< Read buffer for ingress bytes.
 
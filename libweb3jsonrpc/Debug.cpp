@@ -1,5 +1,6 @@
 #include "Debug.h"
 #include "JsonHelper.h"
+#include "Metrics.h"
 #include <jsonrpccpp/common/exception.h>
 #include <libdevcore/CommonIO.h>
 #include <libdevcore/CommonJS.h>
@@ -7,10 +8,35 @@
 #include <libethereum/Client.h>
 #include <libethereum/Executive.h>
 #include <libethereum/StandardTrace.h>
+#include <libevm/VMProfiler.h>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <atomic>
+#include <thread>
 using namespace std;
 using namespace dev;
 using namespace dev::rpc;
 using namespace dev::eth;
+namespace fs = boost::filesystem;
+
+namespace
+{
+unsigned const c_defaultProfiledContracts = 20;
+
+Json::Value toJson(OperationProfile const& _profile)
+{
+    Json::Value ret{Json::objectValue};
+    ret["count"] = Json::UInt64(_profile.count);
+    ret["nanoseconds"] = Json::UInt64(_profile.nanoseconds);
+    ret["gas"] = Json::UInt64(_profile.gas);
+    return ret;
+}
+
+bool moreTime(pair<string, OperationProfile> const& _a, pair<string, OperationProfile> const& _b)
+{
+    return _a.second.nanoseconds > _b.second.nanoseconds;
+}
+}  // namespace
 
 Debug::Debug(eth::Client const& _eth):
     m_eth(_eth)
@@ -79,26 +105,62 @@ Json::Value Debug::traceTransaction(Executive& _e, Transaction const& _t, Json::
     return traceJson;
 }
 
-Json::Value Debug::traceBlock(Block const& _block, Json::Value const& _json)
+void Debug::forEachTransaction(Block const& _block,
+    std::function<void(unsigned, Transaction const&, Executive&)> const& _execute) const
 {
-    State s(_block.state());
-    s.setRoot(_block.stateRootBeforeTx(0));
-
-    Json::Value traces(Json::arrayValue);
-    for (unsigned k = 0; k < _block.pending().size(); k++)
-    {
-        Transaction t = _block.pending()[k];
-
-        u256 const gasUsed = k ? _block.receipt(k - 1).cumulativeGasUsed() : 0;
-        auto const& bc = m_eth.blockChain();
-        EnvInfo envInfo(_block.info(), bc.lastBlockHashes(), gasUsed, bc.chainID());
-        Executive e(s, envInfo, *bc.sealEngine());
+    auto const& bc = m_eth.blockChain();
+    State blockState(State::Null);
+    h256s const roots = intermediateStateRoots(blockState, _block, bc);
+
+    // Every transaction starts from its own root, so they are spread over the threads.
+    atomic<unsigned> next{0};
+    exception_ptr error;
+    Mutex x_error;
+    auto const executeTransactions = [&]() {
+        State s(blockState);
+        for (unsigned k = next++; k < roots.size(); k = next++)
+        {
+            try
+            {
+                s.setRoot(roots[k]);
+                u256 const gasUsed = k ? _block.receipt(k - 1).cumulativeGasUsed() : 0;
+                EnvInfo envInfo(_block.info(), bc.lastBlockHashes(), gasUsed, bc.chainID());
+                Executive e(s, envInfo, *bc.sealEngine());
+                _execute(k, _block.pending()[k], e);
+            }
+            catch (...)
+            {
+                DEV_GUARDED(x_error)
+                    if (!error)
+                        error = current_exception();
+                next = roots.size();
+            }
+        }
+    };
+
+    unsigned const threadCount = min<size_t>(max(thread::hardware_concurrency(), 1U), roots.size());
+    vector<thread> workers;
+    for (unsigned t = 1; t < threadCount; ++t)
+        workers.emplace_back(executeTransactions);
+    executeTransactions();
+    for (auto& w : workers)
+        w.join();
+    if (error)
+        rethrow_exception(error);
+}
 
+Json::Value Debug::traceBlock(Block const& _block, Json::Value const& _json)
+{
+    vector<Json::Value> traces(_block.pending().size());
+    forEachTransaction(_block, [&](unsigned _index, Transaction const& _t, Executive& _e) {
         eth::ExecutionResult er;
-        e.setResultRecipient(er);
-        traces.append(traceTransaction(e, t, _json));
-    }
-    return traces;
+        _e.setResultRecipient(er);
+        traces[_index] = traceTransaction(_e, _t, _json);
+    });
+    Json::Value ret(Json::arrayValue);
+    for (auto const& trace : traces)
+        ret.append(trace);
+    return ret;
 }
 
 Json::Value Debug::debug_traceTransaction(string const& _txHash, Json::Value const& _json)
@@ -147,6 +209,63 @@ Json::Value Debug::debug_traceBlockByNumber(int _blockNumber, Json::Value const&
     return ret;
 }
 
+Json::Value Debug::debug_standardTraceBlockToFile(string const& _blockHash, Json::Value const& _json)
+{
+    h256 const hash{_blockHash};
+    Block const block = m_eth.block(hash);
+    h256 const onlyTransaction = _json.isObject() && _json.isMember("txHash") ?
+                                     h256{_json["txHash"].asString()} :
+                                     h256{};
+    StandardTrace::DebugOptions const options = debugOptions(_json);
+
+    vector<string> files(block.pending().size());
+    auto const traceToFile = [&](unsigned _index, Transaction const& _t, Executive& _e) {
+        fs::path const file =
+            fs::temp_directory_path() /
+            fs::unique_path("block_" + toHex(hash.ref().cropped(0, 4)) + "-" + toString(_index) +
+                            "-" + toHex(_t.sha3().ref().cropped(0, 4)) + "-%%%%%%%%.jsonl");
+        fs::ofstream out{file, ios::binary};
+        eth::ExecutionResult er;
+        _e.setResultRecipient(er);
+        StandardTrace st{out};
+        st.setShowMnemonics();
+        st.setOptions(options);
+        _e.initialize(_t);
+        if (!_e.execute())
+            _e.go(st.onOp());
+        _e.finalize();
+
+        out << "{\"gasUsed\":\"" << toJS(er.gasUsed) << "\",\"output\":\""
+            << toHexPrefixed(er.output) << "\"}\n";
+        if (!out.flush())
+            throw jsonrpc::JsonRpcException("Could not write the trace to " + file.string());
+        files[_index] = file.string();
+    };
+
+    if (onlyTransaction)
+    {
+        // Only the transactions before it are replayed, on this thread.
+        Transactions const& transactions = block.pending();
+        auto const transaction = find_if(transactions.begin(), transactions.end(),
+            [&](Transaction const& _t) { return _t.sha3() == onlyTransaction; });
+        if (transaction == transactions.end())
+            throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_RPC_INVALID_PARAMS);
+
+        unsigned const index = transaction - transactions.begin();
+        State s(State::Null);
+        Executive e(s, block, index, m_eth.blockChain());
+        traceToFile(index, *transaction, e);
+    }
+    else
+        forEachTransaction(block, traceToFile);
+
+    Json::Value ret(Json::arrayValue);
+    for (auto const& file : files)
+        if (!file.empty())
+            ret.append(file);
+    return ret;
+}
+
 Json::Value Debug::debug_accountRange(
     string const& _blockHashOrNumber, int _txIndex, string const& _addressHash, int _maxResults)
 {
@@ -257,3 +376,58 @@ Json::Value Debug::debug_traceCall(Json::Value const& _call, std::string const&
     }
     return ret;
 }
+
+Json::Value Debug::debug_metrics()
+{
+    return metricsJson(m_eth);
+}
+
+Json::Value Debug::debug_vmProfile(Json::Value const& _options)
+{
+    bool const reset = _options.isObject() && _options["reset"].asBool();
+    VMProfile const profile = VMProfiler::profile(reset);
+    if (_options.isObject() && _options.isMember("enable"))
+        VMProfiler::setEnabled(_options["enable"].asBool());
+    unsigned const maxContracts = _options.isObject() && _options.isMember("contracts") ?
+                                      _options["contracts"].asUInt() :
+                                      c_defaultProfiledContracts;
+
+    // Opcodes and contracts are sorted by time, the most expensive first.
+    vector<pair<string, OperationProfile>> opcodes;
+    for (size_t i = 0; i < profile.opcodes.size(); ++i)
+        if (profile.opcodes[i].count)
+        {
+            string name = instructionInfo(static_cast<Instruction>(i)).name;
+            opcodes.emplace_back(name.empty() ? toHexPrefixed(bytes{byte(i)}) : name, profile.opcodes[i]);
+        }
+    sort(opcodes.begin(), opcodes.end(), moreTime);
+
+    vector<pair<string, OperationProfile>> contracts;
+    for (auto const& contract : profile.contracts)
+        contracts.emplace_back(toJS(contract.first), contract.second);
+    sort(contracts.begin(), contracts.end(), moreTime);
+    if (contracts.size() > maxContracts)
+        contracts.resize(maxContracts);
+
+    Json::Value ret{Json::objectValue};
+    ret["enabled"] = VMProfiler::isEnabled();
+    ret["executions"] = Json::UInt64(profile.executions);
+    Json::Value& opcodesJson = ret["opcodes"] = Json::Value{Json::arrayValue};
+    for (auto const& opcode : opcodes)
+    {
+        Json::Value entry = ::toJson(opcode.second);
+        entry["op"] = opcode.first;
+        opcodesJson.append(entry);
+    }
+    Json::Value& contractsJson = ret["contracts"] = Json::Value{Json::arrayValue};
+    for (auto const& contract : contracts)
+    {
+        Json::Value entry = ::toJson(contract.second);
+        entry["codeHash"] = contract.first;
+        contractsJson.append(entry);
+    }
+    Json::Value& depthsJson = ret["depths"] = Json::Value{Json::arrayValue};
+    for (auto const& depth : profile.depths)
+        depthsJson.append(::toJson(depth));
+    return ret;
+}
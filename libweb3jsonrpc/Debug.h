@@ -1,5 +1,6 @@
 #pragma once
 #include "DebugFace.h"
+#include <functional>
 #include <libethereum/StandardTrace.h>
 
 namespace dev
@@ -36,8 +37,11 @@ public:
 	virtual Json::Value debug_traceCall(Json::Value const& _call, std::string const& _blockNumber, Json::Value const& _options) override;
 	virtual Json::Value debug_traceBlockByNumber(int _blockNumber, Json::Value const& _json) override;
 	virtual Json::Value debug_traceBlockByHash(std::string const& _blockHash, Json::Value const& _json) override;
+	virtual Json::Value debug_standardTraceBlockToFile(std::string const& _blockHash, Json::Value const& _json) override;
 	virtual Json::Value debug_storageRangeAt(std::string const& _blockHashOrNumber, int _txIndex, std::string const& _address, std::string const& _begin, int _maxResults) override;
 	virtual std::string debug_preimage(std::string const& _hashedKey) override;
+	virtual Json::Value debug_metrics() override;
+	virtual Json::Value debug_vmProfile(Json::Value const& _options) override;
 	virtual Json::Value debug_traceBlock(std::string const& _blockRlp, Json::Value const& _json);
 
 private:
@@ -46,6 +50,10 @@ private:
 	h256 blockHash(std::string const& _blockHashOrNumber) const;
     eth::State stateAt(std::string const& _blockHashOrNumber, int _txIndex) const;
     Json::Value traceTransaction(dev::eth::Executive& _e, dev::eth::Transaction const& _t, Json::Value const& _json);
+	/// Execute each transaction of @a _block from the state root before it, with @a _execute
+	/// running it with the Executive given. Transactions run in parallel, in no particular order.
+	void forEachTransaction(dev::eth::Block const& _block,
+		std::function<void(unsigned, dev::eth::Transaction const&, dev::eth::Executive&)> const& _execute) const;
 	Json::Value traceBlock(dev::eth::Block const& _block, Json::Value const& _json);
 };
 
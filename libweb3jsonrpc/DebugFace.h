@@ -20,7 +20,10 @@ namespace dev {
                     this->bindAndAddMethod(jsonrpc::Procedure("debug_preimage", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",jsonrpc::JSON_STRING, NULL), &dev::rpc::DebugFace::debug_preimageI);
                     this->bindAndAddMethod(jsonrpc::Procedure("debug_traceBlockByNumber", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",jsonrpc::JSON_INTEGER,"param2",jsonrpc::JSON_OBJECT, NULL), &dev::rpc::DebugFace::debug_traceBlockByNumberI);
                     this->bindAndAddMethod(jsonrpc::Procedure("debug_traceBlockByHash", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",jsonrpc::JSON_STRING,"param2",jsonrpc::JSON_OBJECT, NULL), &dev::rpc::DebugFace::debug_traceBlockByHashI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("debug_standardTraceBlockToFile", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_ARRAY, "param1",jsonrpc::JSON_STRING,"param2",jsonrpc::JSON_OBJECT, NULL), &dev::rpc::DebugFace::debug_standardTraceBlockToFileI);
                     this->bindAndAddMethod(jsonrpc::Procedure("debug_traceCall", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",jsonrpc::JSON_OBJECT,"param2",jsonrpc::JSON_STRING,"param3",jsonrpc::JSON_OBJECT, NULL), &dev::rpc::DebugFace::debug_traceCallI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("debug_metrics", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT,  NULL), &dev::rpc::DebugFace::debug_metricsI);
+                    this->bindAndAddMethod(jsonrpc::Procedure("debug_vmProfile", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, "param1",jsonrpc::JSON_OBJECT, NULL), &dev::rpc::DebugFace::debug_vmProfileI);
                 }
                 inline virtual void debug_accountRangeI(const Json::Value &request, Json::Value &response)
                 {
@@ -46,17 +49,33 @@ namespace dev {
                 {
                     response = this->debug_traceBlockByHash(request[0u].asString(), request[1u]);
                 }
+                inline virtual void debug_standardTraceBlockToFileI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->debug_standardTraceBlockToFile(request[0u].asString(), request[1u]);
+                }
                 inline virtual void debug_traceCallI(const Json::Value &request, Json::Value &response)
                 {
                     response = this->debug_traceCall(request[0u], request[1u].asString(), request[2u]);
                 }
+                inline virtual void debug_metricsI(const Json::Value &request, Json::Value &response)
+                {
+                    (void)request;
+                    response = this->debug_metrics();
+                }
+                inline virtual void debug_vmProfileI(const Json::Value &request, Json::Value &response)
+                {
+                    response = this->debug_vmProfile(request[0u]);
+                }
                 virtual Json::Value debug_accountRange(const std::string& param1, int param2, const std::string& param3, int param4) = 0;
                 virtual Json::Value debug_traceTransaction(const std::string& param1, const Json::Value& param2) = 0;
                 virtual Json::Value debug_storageRangeAt(const std::string& param1, int param2, const std::string& param3, const std::string& param4, int param5) = 0;
                 virtual std::string debug_preimage(const std::string& param1) = 0;
                 virtual Json::Value debug_traceBlockByNumber(int param1, const Json::Value& param2) = 0;
                 virtual Json::Value debug_traceBlockByHash(const std::string& param1, const Json::Value& param2) = 0;
+                virtual Json::Value debug_standardTraceBlockToFile(const std::string& param1, const Json::Value& param2) = 0;
                 virtual Json::Value debug_traceCall(const Json::Value& param1, const std::string& param2, const Json::Value& param3) = 0;
+                virtual Json::Value debug_metrics() = 0;
+                virtual Json::Value debug_vmProfile(const Json::Value& param1) = 0;
         };
 
     }
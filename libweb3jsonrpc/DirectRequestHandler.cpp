@@ -0,0 +1,74 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "DirectRequestHandler.h"
+#include "JsonWriter.h"
+
+#include <jsonrpccpp/common/exception.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::rpc;
+
+namespace
+{
+/// @returns the error response of libjson-rpc-cpp to the call with @a _id.
+string errorResponse(Json::Value const& _id, jsonrpc::JsonRpcException const& _e)
+{
+    Json::Value response;
+    response["jsonrpc"] = "2.0";
+    response["id"] = _id;
+    response["error"]["code"] = _e.GetCode();
+    response["error"]["message"] = _e.GetMessage();
+    response["error"]["data"] = _e.GetData();
+    return Json::FastWriter().write(response);
+}
+}  // namespace
+
+void DirectRequestHandler::HandleRequest(string const& _request, string& o_response)
+{
+    // Other requests are only parsed once, by the wrapped handler.
+    bool mentionsMethod = false;
+    for (auto const& method: m_methods)
+        mentionsMethod = mentionsMethod || _request.find(method.first) != string::npos;
+
+    Json::Value parsed;
+    if (mentionsMethod && Json::Reader().parse(_request, parsed, false) && parsed.isObject() &&
+        parsed["method"].isString())
+    {
+        Json::Value const& request = parsed;
+        Json::Value const& id = request["id"];
+        auto const method = m_methods.find(request["method"].asString());
+        if (method != m_methods.end() && request["jsonrpc"] == "2.0" && request.isMember("id") &&
+            (id.isIntegral() || id.isString() || id.isNull()) && request["params"].isArray())
+        {
+            // Same members and order as the response of libjson-rpc-cpp.
+            o_response.clear();
+            JsonWriter writer{o_response};
+            writer.beginObject().key("id").value(id).key("jsonrpc").value("2.0").key("result");
+            try
+            {
+                if (method->second(request["params"], writer))
+                {
+                    writer.endObject();
+                    o_response += '\n';
+                    return;
+                }
+            }
+            catch (jsonrpc::JsonRpcException const& _e)
+            {
+                o_response = errorResponse(id, _e);
+                return;
+            }
+            catch (...)
+            {
+                o_response = errorResponse(
+                    id, jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_RPC_INVALID_PARAMS));
+                return;
+            }
+        }
+    }
+    o_response.clear();
+    m_handler->HandleRequest(_request, o_response);
+}
@@ -0,0 +1,53 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// JSON-RPC calls answered without building their result as a Json::Value.
+#pragma once
+
+#include <jsonrpccpp/server/requesthandlerfactory.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace dev
+{
+namespace rpc
+{
+class JsonWriter;
+
+/**
+ * @brief Protocol handler that writes the result of some methods straight into the response.
+ *
+ * Single JSON-RPC 2.0 calls to a method added with addMethod() are answered by it, bypassing the
+ * Json::Value result that libjson-rpc-cpp serialises. Everything else goes to the wrapped handler,
+ * including the calls that a direct method declines. A direct method that throws is not run again
+ * by the wrapped handler: the call is answered with the error of the jsonrpc::JsonRpcException, or
+ * with invalid params for other exceptions, as the Json::Value versions of the methods do.
+ */
+class DirectRequestHandler: public jsonrpc::IProtocolHandler
+{
+public:
+    /// Writes the result of a call with the parameters given.
+    /// @returns false, without writing anything, to leave the call to the wrapped handler.
+    using Method = std::function<bool(Json::Value const& _params, JsonWriter& o_result)>;
+
+    /// Takes ownership of @a _handler.
+    explicit DirectRequestHandler(jsonrpc::IProtocolHandler* _handler): m_handler(_handler) {}
+
+    /// Not thread-safe: all methods must be added before requests are handled.
+    void addMethod(std::string const& _name, Method const& _method) { m_methods[_name] = _method; }
+
+    void AddProcedure(jsonrpc::Procedure const& _procedure) override { m_handler->AddProcedure(_procedure); }
+    void HandleRequest(std::string const& _request, std::string& o_response) override;
+
+private:
+    std::unique_ptr<jsonrpc::IProtocolHandler> m_handler;
+    std::unordered_map<std::string, Method> m_methods;
+};
+
+}  // namespace rpc
+}  // namespace dev
@@ -5,6 +5,7 @@
 
 #include "Eth.h"
 #include "AccountHolder.h"
+#include "JsonWriter.h"
 #include <jsonrpccpp/common/exception.h>
 #include <libdevcore/CommonData.h>
 #include <libethashseal/Ethash.h>
@@ -21,10 +22,50 @@ using namespace eth;
 using namespace shh;
 using namespace dev::rpc;
 
+namespace
+{
+/// @returns whether @a _params are positional and of the types given, as libjson-rpc-cpp checks
+/// before calling a method.
+bool hasParams(Json::Value const& _params, std::initializer_list<Json::ValueType> _types)
+{
+	if (_params.size() != _types.size())
+		return false;
+	Json::ArrayIndex i = 0;
+	for (auto type: _types)
+		if (_params[i++].type() != type)
+			return false;
+	return true;
+}
+
+template <class BlockId>
+void writeBlock(eth::Interface& _client, BlockId const& _id, bool _includeTransactions, JsonWriter& o_result)
+{
+	if (!_client.isKnown(_id))
+	{
+		o_result.null();
+		return;
+	}
+	auto const blockDetails = _client.blockDetails(_id);
+	auto const blockHeader = _client.blockInfo(_id);
+	auto const uncleHashes = _client.uncleHashes(_id);
+	auto* sealEngine = _client.sealEngine();
+	if (_includeTransactions)
+		writeJson(o_result, blockHeader, blockDetails, uncleHashes, _client.transactions(_id), sealEngine);
+	else
+		writeJson(o_result, blockHeader, blockDetails, uncleHashes, _client.transactionHashes(_id), sealEngine);
+}
+}  // namespace
+
 Eth::Eth(eth::Interface& _eth, eth::AccountHolder& _ethAccounts):
 	m_eth(_eth),
 	m_ethAccounts(_ethAccounts)
 {
+	bindDirectMethod("eth_getBlockByHash", static_cast<DirectMethodPointer>(&Eth::writeBlockByHash));
+	bindDirectMethod("eth_getBlockByNumber", static_cast<DirectMethodPointer>(&Eth::writeBlockByNumber));
+	bindDirectMethod("eth_getTransactionByHash", static_cast<DirectMethodPointer>(&Eth::writeTransactionByHash));
+	bindDirectMethod("eth_getTransactionReceipt", static_cast<DirectMethodPointer>(&Eth::writeTransactionReceipt));
+	bindDirectMethod("eth_getFilterLogs", static_cast<DirectMethodPointer>(&Eth::writeFilterLogs));
+	bindDirectMethod("eth_getLogs", static_cast<DirectMethodPointer>(&Eth::writeLogs));
 }
 
 string Eth::eth_protocolVersion()
@@ -614,6 +655,62 @@ Json::Value Eth::eth_getLogsEx(Json::Value const& _json)
 	}
 }
 
+bool Eth::writeBlockByHash(Json::Value const& _params, JsonWriter& o_result)
+{
+	if (!hasParams(_params, {Json::stringValue, Json::booleanValue}))
+		return false;
+	writeBlock(*client(), jsToFixed<32>(_params[0u].asString()), _params[1u].asBool(), o_result);
+	return true;
+}
+
+bool Eth::writeBlockByNumber(Json::Value const& _params, JsonWriter& o_result)
+{
+	if (!hasParams(_params, {Json::stringValue, Json::booleanValue}))
+		return false;
+	writeBlock(*client(), jsToBlockNumber(_params[0u].asString()), _params[1u].asBool(), o_result);
+	return true;
+}
+
+bool Eth::writeTransactionByHash(Json::Value const& _params, JsonWriter& o_result)
+{
+	if (!hasParams(_params, {Json::stringValue}))
+		return false;
+	h256 const h = jsToFixed<32>(_params[0u].asString());
+	if (client()->isKnownTransaction(h))
+		writeJson(o_result, client()->localisedTransaction(h));
+	else
+		o_result.null();
+	return true;
+}
+
+bool Eth::writeTransactionReceipt(Json::Value const& _params, JsonWriter& o_result)
+{
+	if (!hasParams(_params, {Json::stringValue}))
+		return false;
+	h256 const h = jsToFixed<32>(_params[0u].asString());
+	if (client()->isKnownTransaction(h))
+		writeJson(o_result, client()->localisedTransactionReceipt(h));
+	else
+		o_result.null();
+	return true;
+}
+
+bool Eth::writeFilterLogs(Json::Value const& _params, JsonWriter& o_result)
+{
+	if (!hasParams(_params, {Json::stringValue}))
+		return false;
+	writeJson(o_result, client()->logs(jsToInt(_params[0u].asString())));
+	return true;
+}
+
+bool Eth::writeLogs(Json::Value const& _params, JsonWriter& o_result)
+{
+	if (!hasParams(_params, {Json::objectValue}))
+		return false;
+	writeJson(o_result, client()->logs(toLogFilter(_params[0u], *client())));
+	return true;
+}
+
 Json::Value Eth::eth_getWork()
 {
 	try
@@ -641,6 +738,21 @@ Json::Value Eth::eth_syncing()
 	info["startingBlock"] = sync.startBlockNumber;
 	info["highestBlock"] = sync.highestBlockNumber;
 	info["currentBlock"] = sync.currentBlockNumber;
+
+	Json::Value peers(Json::arrayValue);
+	for (auto const& p: sync.peers)
+	{
+		Json::Value peer(Json::objectValue);
+		peer["id"] = p.id.hex();
+		peer["rtt"] = static_cast<unsigned>(p.rtt * 1000);
+		peer["throughput"] = static_cast<unsigned>(p.throughput);
+		peer["requestSize"] = p.requestSize;
+		peer["responses"] = p.responses;
+		peer["itemsReceived"] = p.itemsReceived;
+		peer["reassigned"] = p.reassigned;
+		peers.append(peer);
+	}
+	info["peers"] = peers;
 	return info;
 }
 
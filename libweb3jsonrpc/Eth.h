@@ -108,6 +108,13 @@ public:
 	
 	void setTransactionDefaults(eth::TransactionSkeleton& _t);
 protected:
+	/// Direct serialisation of the methods with the largest results, see DirectRequestHandler.
+	bool writeBlockByHash(Json::Value const& _params, JsonWriter& o_result);
+	bool writeBlockByNumber(Json::Value const& _params, JsonWriter& o_result);
+	bool writeTransactionByHash(Json::Value const& _params, JsonWriter& o_result);
+	bool writeTransactionReceipt(Json::Value const& _params, JsonWriter& o_result);
+	bool writeFilterLogs(Json::Value const& _params, JsonWriter& o_result);
+	bool writeLogs(Json::Value const& _params, JsonWriter& o_result);
 
 	eth::Interface* client() { return &m_eth; }
     eth::Ethash& getEthash();
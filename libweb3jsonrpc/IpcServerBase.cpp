@@ -3,6 +3,7 @@
 // Licensed under the GNU General Public License, Version 3.
 
 #include "IpcServerBase.h"
+#include "Subscriptions.h"
 #include <cstdlib>
 #include <cstdio>
 #include <string>
@@ -53,18 +54,16 @@ template <class S> bool IpcServerBase<S>::SendResponse(string const& _response,
 {
     bool fullyWritten = false;
     bool errorOccured = false;
-    S socket = (S)(reinterpret_cast<intptr_t>(_addInfo));
+    Connection& connection = *static_cast<Connection*>(_addInfo);
     string toSend = _response;
+    Guard l(connection.x_write);
     do
     {
-        size_t bytesWritten = Write(socket, toSend);
+        size_t bytesWritten = Write(connection.socket, toSend);
         if (bytesWritten == 0)
             errorOccured = true;
         else if (bytesWritten < toSend.size())
-        {
-            int len = toSend.size() - bytesWritten;
-            toSend = toSend.substr(bytesWritten + sizeof(char), len);
-        }
+            toSend.erase(0, bytesWritten);
         else
             fullyWritten = true;
     } while (!fullyWritten && !errorOccured);
@@ -74,6 +73,13 @@ template <class S> bool IpcServerBase<S>::SendResponse(string const& _response,
 
 template <class S> void IpcServerBase<S>::GenerateResponse(S _connection)
 {
+    Connection connection{_connection};
+    rpc::Subscriptions::Send const send = [this, &connection](string const& _message) {
+        return SendResponse(_message, &connection);
+    };
+    rpc::Subscriptions::Disconnect const disconnect = [this, _connection]() {
+        ShutdownConnection(_connection);
+    };
     char buffer[c_bufferSize];
     string request;
     bool escape = false;
@@ -120,7 +126,9 @@ template <class S> void IpcServerBase<S>::GenerateResponse(S _connection)
                     std::string r = request.substr(0, i + 1);
                     request.erase(0, i + 1);
                     clog(VerbosityTrace, "rpc") << r;
-                    OnRequest(r, reinterpret_cast<void*>((intptr_t)_connection));
+                    if (!m_subscriptions ||
+                        !m_subscriptions->handleRequest(r, &connection, send, disconnect))
+                        OnRequest(r, &connection);
                     i = 0;
                     continue;
                 }
@@ -128,6 +136,12 @@ template <class S> void IpcServerBase<S>::GenerateResponse(S _connection)
             i++;
         }
     } while (true);
+    if (m_subscriptions)
+    {
+        // Fail any write that is still blocked, before waiting for the subscription writer.
+        ShutdownConnection(_connection);
+        m_subscriptions->closeConnection(&connection);
+    }
     DEV_GUARDED(x_sockets)
         m_sockets.erase(_connection);
 }
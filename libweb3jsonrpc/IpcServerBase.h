@@ -14,6 +14,11 @@
 
 namespace dev
 {
+namespace rpc
+{
+class Subscriptions;
+}
+
 template <class S> class IpcServerBase: public jsonrpc::AbstractServerConnector
 {
 public:
@@ -22,9 +27,24 @@ public:
 	virtual bool StopListening();
 	virtual bool SendResponse(std::string const& _response, void* _addInfo = nullptr);
 
+	/// Answers eth_subscribe and eth_unsubscribe with @a _subscriptions, which must outlive the
+	/// connections. Must be set before listening starts.
+	void setSubscriptions(rpc::Subscriptions* _subscriptions) { m_subscriptions = _subscriptions; }
+
 protected:
+	/// Connection passed to OnRequest() as additional info.
+	struct Connection
+	{
+		explicit Connection(S _socket): socket(_socket) {}
+
+		S socket;
+		std::mutex x_write;	///< Keeps responses and subscription notifications from interleaving.
+	};
+
 	virtual void Listen() = 0;
 	virtual void CloseConnection(S _socket) = 0;
+	/// Ends reading from and writing to @a _socket, without releasing it.
+	virtual void ShutdownConnection(S _socket) = 0;
 	virtual size_t Write(S _connection, std::string const& _data) = 0;
 	virtual size_t Read(S _connection, void* _data, size_t _size) = 0;
 	void GenerateResponse(S _connection);
@@ -34,6 +54,7 @@ protected:
 	std::string m_path;
 	std::unordered_set<S> m_sockets;
 	std::mutex x_sockets;
+	rpc::Subscriptions* m_subscriptions = nullptr;
 	std::thread m_listeningThread; //TODO use asio for parallel request processing
 };
 } // namespace dev
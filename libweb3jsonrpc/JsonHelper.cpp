@@ -3,6 +3,7 @@
 // Licensed under the GNU General Public License, Version 3.
 
 #include "JsonHelper.h"
+#include "JsonWriter.h"
 
 #include <libethcore/SealEngine.h>
 #include <libethereum/Client.h>
@@ -355,6 +356,196 @@ Json::Value toJsonByBlock(LocalisedLogEntries const& _entries)
     return toJson(entriesByBlock, order);
 }
 
+namespace
+{
+/// Writes the members of a block header object, as toJson(BlockHeader const&) does.
+void writeHeaderMembers(rpc::JsonWriter& o_writer, BlockHeader const& _bi, SealEngineFace* _sealer)
+{
+    h256 hash;
+    DEV_IGNORE_EXCEPTIONS(hash = _bi.hash());
+    if (hash)
+        o_writer.key("hash").hex(hash.ref());
+    o_writer.key("parentHash").hex(_bi.parentHash().ref());
+    o_writer.key("sha3Uncles").hex(_bi.sha3Uncles().ref());
+    o_writer.key("author").hex(_bi.author().ref());
+    o_writer.key("stateRoot").hex(_bi.stateRoot().ref());
+    o_writer.key("transactionsRoot").hex(_bi.transactionsRoot().ref());
+    o_writer.key("receiptsRoot").hex(_bi.receiptsRoot().ref());
+    o_writer.key("number").quantity(static_cast<uint64_t>(_bi.number()));
+    o_writer.key("gasUsed").quantity(_bi.gasUsed());
+    o_writer.key("gasLimit").quantity(_bi.gasLimit());
+    o_writer.key("extraData").data(&_bi.extraData());
+    o_writer.key("logsBloom").hex(_bi.logBloom().ref());
+    o_writer.key("timestamp").quantity(static_cast<uint64_t>(_bi.timestamp()));
+    o_writer.key("miner").hex(_bi.author().ref());
+    if (_sealer)
+        for (auto const& i: _sealer->jsInfo(_bi))
+            o_writer.key(i.first.c_str()).value(i.second);
+}
+
+void writeBlockMembers(rpc::JsonWriter& o_writer, BlockDetails const& _bd, UncleHashes const& _us)
+{
+    o_writer.key("totalDifficulty").quantity(_bd.totalDifficulty);
+    o_writer.key("size").quantity(uint64_t{_bd.blockSizeBytes});
+    o_writer.key("uncles").beginArray();
+    for (h256 const& h: _us)
+        o_writer.hex(h.ref());
+    o_writer.endArray();
+}
+
+void writeTransactionMembers(rpc::JsonWriter& o_writer, Transaction const& _t)
+{
+    o_writer.key("hash").hex(_t.sha3().ref());
+    o_writer.key("input").data(&_t.data());
+    o_writer.key("to");
+    if (_t.isCreation())
+        o_writer.null();
+    else
+        o_writer.hex(_t.receiveAddress().ref());
+    o_writer.key("from").hex(_t.safeSender().ref());
+    o_writer.key("gas").quantity(_t.gas());
+    o_writer.key("gasPrice").quantity(_t.gasPrice());
+    o_writer.key("nonce").quantity(_t.nonce());
+    o_writer.key("value").quantity(_t.value());
+}
+
+void writeSignatureMembers(rpc::JsonWriter& o_writer, Transaction const& _t)
+{
+    o_writer.key("v").quantity(_t.rawV());
+    o_writer.key("r").hex(_t.signature().r.ref());
+    o_writer.key("s").hex(_t.signature().s.ref());
+}
+}  // namespace
+
+void writeJson(rpc::JsonWriter& o_writer, BlockHeader const& _bi, BlockDetails const& _bd,
+    UncleHashes const& _us, Transactions const& _ts, SealEngineFace* _face)
+{
+    if (!_bi)
+    {
+        o_writer.null();
+        return;
+    }
+    o_writer.beginObject();
+    writeHeaderMembers(o_writer, _bi, _face);
+    writeBlockMembers(o_writer, _bd, _us);
+    h256 const hash = _bi.hash();
+    o_writer.key("transactions").beginArray();
+    for (unsigned i = 0; i < _ts.size(); i++)
+    {
+        if (!_ts[i])
+        {
+            o_writer.null();
+            continue;
+        }
+        o_writer.beginObject();
+        writeTransactionMembers(o_writer, _ts[i]);
+        o_writer.key("blockHash").hex(hash.ref());
+        o_writer.key("transactionIndex").quantity(uint64_t{i});
+        o_writer.key("blockNumber").quantity(static_cast<uint64_t>(_bi.number()));
+        writeSignatureMembers(o_writer, _ts[i]);
+        o_writer.endObject();
+    }
+    o_writer.endArray();
+    o_writer.endObject();
+}
+
+void writeJson(rpc::JsonWriter& o_writer, BlockHeader const& _bi, BlockDetails const& _bd,
+    UncleHashes const& _us, TransactionHashes const& _ts, SealEngineFace* _face)
+{
+    if (!_bi)
+    {
+        o_writer.null();
+        return;
+    }
+    o_writer.beginObject();
+    writeHeaderMembers(o_writer, _bi, _face);
+    writeBlockMembers(o_writer, _bd, _us);
+    o_writer.key("transactions").beginArray();
+    for (h256 const& t: _ts)
+        o_writer.hex(t.ref());
+    o_writer.endArray();
+    o_writer.endObject();
+}
+
+void writeJson(rpc::JsonWriter& o_writer, LocalisedTransaction const& _t)
+{
+    if (!_t)
+    {
+        o_writer.null();
+        return;
+    }
+    o_writer.beginObject();
+    writeTransactionMembers(o_writer, _t);
+    o_writer.key("blockHash").hex(_t.blockHash().ref());
+    o_writer.key("transactionIndex").quantity(uint64_t{_t.transactionIndex()});
+    o_writer.key("blockNumber").quantity(uint64_t{_t.blockNumber()});
+    writeSignatureMembers(o_writer, _t);
+    o_writer.endObject();
+}
+
+void writeJson(rpc::JsonWriter& o_writer, LocalisedTransactionReceipt const& _t)
+{
+    o_writer.beginObject();
+    o_writer.key("transactionHash").hex(_t.hash().ref());
+    o_writer.key("transactionIndex").value(_t.transactionIndex());
+    o_writer.key("blockHash").hex(_t.blockHash().ref());
+    o_writer.key("blockNumber").value(_t.blockNumber());
+    o_writer.key("from").hex(_t.from().ref());
+    o_writer.key("to").hex(_t.to().ref());
+    o_writer.key("cumulativeGasUsed").quantity(_t.cumulativeGasUsed());
+    o_writer.key("gasUsed").quantity(_t.gasUsed());
+    o_writer.key("contractAddress").hex(_t.contractAddress().ref());
+    o_writer.key("logs");
+    writeJson(o_writer, _t.localisedLogs());
+    o_writer.key("logsBloom").hex(_t.bloom().ref());
+    if (_t.hasStatusCode())
+        o_writer.key("status").value(toString(_t.statusCode()));
+    else
+        o_writer.key("stateRoot").hex(_t.stateRoot().ref());
+    o_writer.endObject();
+}
+
+void writeJson(rpc::JsonWriter& o_writer, LocalisedLogEntry const& _e)
+{
+    if (_e.isSpecial)
+    {
+        o_writer.hex(_e.special.ref());
+        return;
+    }
+    o_writer.beginObject();
+    o_writer.key("data").data(&_e.data);
+    o_writer.key("address").hex(_e.address.ref());
+    o_writer.key("topics").beginArray();
+    for (auto const& t: _e.topics)
+        o_writer.hex(t.ref());
+    o_writer.endArray();
+    o_writer.key("polarity").value(_e.polarity == BlockPolarity::Live);
+    if (_e.mined)
+    {
+        o_writer.key("type").value("mined");
+        o_writer.key("blockNumber").value(_e.blockNumber);
+        o_writer.key("blockHash").hex(_e.blockHash.ref());
+        o_writer.key("logIndex").value(_e.logIndex);
+        o_writer.key("transactionHash").hex(_e.transactionHash.ref());
+        o_writer.key("transactionIndex").value(_e.transactionIndex);
+    }
+    else
+    {
+        o_writer.key("type").value("pending");
+        for (char const* key: {"blockNumber", "blockHash", "logIndex", "transactionHash", "transactionIndex"})
+            o_writer.key(key).null();
+    }
+    o_writer.endObject();
+}
+
+void writeJson(rpc::JsonWriter& o_writer, LocalisedLogEntries const& _es)
+{
+    o_writer.beginArray();
+    for (auto const& e: _es)
+        writeJson(o_writer, e);
+    o_writer.endArray();
+}
+
 TransactionSkeleton toTransactionSkeleton(Json::Value const& _json)
 {
     TransactionSkeleton ret;
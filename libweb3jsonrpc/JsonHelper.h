@@ -12,6 +12,10 @@
 
 namespace dev
 {
+namespace rpc
+{
+class JsonWriter;
+}
 
 Json::Value toJson(std::map<h256, std::pair<u256, u256>> const& _storage);
 Json::Value toJson(std::unordered_map<u256, u256> const& _storage);
@@ -51,6 +55,14 @@ Json::Value toJson(LocalisedLogEntry const& _e);
 Json::Value toJson(LogEntry const& _e);
 Json::Value toJson(std::unordered_map<h256, LocalisedLogEntries> const& _entriesByBlock);
 Json::Value toJsonByBlock(LocalisedLogEntries const& _entries);
+
+/// Write the same JSON as the corresponding toJson() straight into @a o_writer.
+void writeJson(rpc::JsonWriter& o_writer, BlockHeader const& _bi, BlockDetails const& _bd, UncleHashes const& _us, Transactions const& _ts, SealEngineFace* _face = nullptr);
+void writeJson(rpc::JsonWriter& o_writer, BlockHeader const& _bi, BlockDetails const& _bd, UncleHashes const& _us, TransactionHashes const& _ts, SealEngineFace* _face = nullptr);
+void writeJson(rpc::JsonWriter& o_writer, LocalisedTransaction const& _t);
+void writeJson(rpc::JsonWriter& o_writer, LocalisedTransactionReceipt const& _t);
+void writeJson(rpc::JsonWriter& o_writer, LocalisedLogEntry const& _e);
+void writeJson(rpc::JsonWriter& o_writer, LocalisedLogEntries const& _es);
 TransactionSkeleton toTransactionSkeleton(Json::Value const& _json);
 LogFilter toLogFilter(Json::Value const& _json);
 LogFilter toLogFilter(Json::Value const& _json, Interface const& _client);	// commented to avoid warning. Uncomment once in use @ PoC-7.
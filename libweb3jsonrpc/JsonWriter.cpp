@@ -0,0 +1,210 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "JsonWriter.h"
+
+#include <libdevcore/CommonData.h>
+
+#include <array>
+#include <limits>
+
+using namespace std;
+using namespace dev;
+using namespace dev::rpc;
+
+namespace
+{
+char const c_hexDigits[] = "0123456789abcdef";
+}
+
+JsonWriter& JsonWriter::beginObject()
+{
+    separate();
+    m_out += '{';
+    m_needsComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject()
+{
+    m_out += '}';
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray()
+{
+    separate();
+    m_out += '[';
+    m_needsComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray()
+{
+    m_out += ']';
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(char const* _name)
+{
+    separate();
+    m_out += '"';
+    m_out += _name;
+    m_out += "\":";
+    m_needsComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::null()
+{
+    separate();
+    m_out += "null";
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool _value)
+{
+    separate();
+    m_out += _value ? "true" : "false";
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(uint64_t _value)
+{
+    separate();
+    char digits[20];
+    size_t i = sizeof(digits);
+    do
+        digits[--i] = static_cast<char>('0' + _value % 10);
+    while (_value /= 10);
+    m_out.append(digits + i, sizeof(digits) - i);
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::writeString(char const* _data, size_t _size)
+{
+    separate();
+    m_out += '"';
+    for (char const c: vector_ref<char const>(_data, _size))
+        switch (c)
+        {
+        case '"': m_out += "\\\""; break;
+        case '\\': m_out += "\\\\"; break;
+        case '\b': m_out += "\\b"; break;
+        case '\f': m_out += "\\f"; break;
+        case '\n': m_out += "\\n"; break;
+        case '\r': m_out += "\\r"; break;
+        case '\t': m_out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                // Same form as Json::FastWriter.
+                char const upperHex[] = "0123456789ABCDEF";
+                m_out += "\\u00";
+                m_out += upperHex[static_cast<unsigned char>(c) >> 4];
+                m_out += upperHex[static_cast<unsigned char>(c) & 0xf];
+            }
+            else
+                m_out += c;
+        }
+    m_out += '"';
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(Json::Value const& _value)
+{
+    separate();
+    std::string const text = Json::FastWriter().write(_value);
+    m_out.append(text, 0, !text.empty() && text.back() == '\n' ? text.size() - 1 : text.size());
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::raw(string const& _json)
+{
+    separate();
+    m_out += _json;
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::hex(bytesConstRef _data)
+{
+    separate();
+    size_t const start = m_out.size();
+    m_out.resize(start + 4 + 2 * _data.size());
+    char* out = &m_out[start];
+    *out++ = '"';
+    *out++ = '0';
+    *out++ = 'x';
+    for (byte b: _data)
+    {
+        *out++ = c_hexDigits[b >> 4];
+        *out++ = c_hexDigits[b & 0xf];
+    }
+    *out = '"';
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::data(bytesConstRef _data)
+{
+    if (!_data.empty())
+        return hex(_data);
+    separate();
+    m_out += "\"\"";
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::quantity(uint64_t _value)
+{
+    separate();
+    char digits[16];
+    size_t i = sizeof(digits);
+    do
+        digits[--i] = c_hexDigits[_value & 0xf];
+    while (_value >>= 4);
+    m_out += "\"0x";
+    m_out.append(digits + i, sizeof(digits) - i);
+    m_out += '"';
+    m_needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::quantity(u256 const& _value)
+{
+    if (_value <= numeric_limits<uint64_t>::max())
+        return quantity(static_cast<uint64_t>(_value));
+
+    array<byte, 32> bigEndian;
+    toBigEndian(_value, bigEndian);
+    size_t first = 0;
+    while (bigEndian[first] == 0)
+        ++first;
+    separate();
+    m_out += "\"0x";
+    if (bigEndian[first] < 0x10)
+        m_out += c_hexDigits[bigEndian[first++]];
+    for (size_t i = first; i < bigEndian.size(); ++i)
+    {
+        m_out += c_hexDigits[bigEndian[i] >> 4];
+        m_out += c_hexDigits[bigEndian[i] & 0xf];
+    }
+    m_out += '"';
+    m_needsComma = true;
+    return *this;
+}
+
+void JsonWriter::separate()
+{
+    if (m_needsComma)
+        m_out += ',';
+}
@@ -0,0 +1,73 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Serialisation of JSON text straight into a buffer, for responses too large to build as a
+/// Json::Value first.
+#pragma once
+
+#include <libdevcore/Common.h>
+
+#include <json/json.h>
+
+#include <cstring>
+#include <string>
+
+namespace dev
+{
+namespace rpc
+{
+/**
+ * @brief Appends compact JSON text to a string.
+ *
+ * Commas between the elements of arrays and the members of objects are inserted automatically;
+ * the caller is responsible for balancing begin and end calls and for giving every object member
+ * a key. Values are written the way Json::FastWriter and dev::toJS() would write them, so that the
+ * text can replace that of the equivalent Json::Value.
+ */
+class JsonWriter
+{
+public:
+    /// Appends to @a o_out, which can be reused between responses to keep its capacity.
+    explicit JsonWriter(std::string& o_out): m_out(o_out) {}
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+
+    /// Starts a member of the current object. @a _name is written as is and must not need escaping.
+    JsonWriter& key(char const* _name);
+
+    JsonWriter& null();
+    JsonWriter& value(bool _value);
+    JsonWriter& value(uint64_t _value);
+    JsonWriter& value(unsigned _value) { return value(uint64_t{_value}); }
+    JsonWriter& value(std::string const& _value) { return writeString(_value.data(), _value.size()); }
+    JsonWriter& value(char const* _value) { return writeString(_value, std::strlen(_value)); }
+    /// Writes any Json::Value, through Json::FastWriter.
+    JsonWriter& value(Json::Value const& _value);
+    /// Writes @a _json, which must be the text of a complete JSON value, as is.
+    JsonWriter& raw(std::string const& _json);
+
+    /// Writes @a _data as a "0x"-prefixed hex string, as toJS() does for fixed-size hashes.
+    JsonWriter& hex(bytesConstRef _data);
+    /// Writes @a _data as a "0x"-prefixed hex string, or as an empty string if there is no data,
+    /// as toJS() does for byte arrays.
+    JsonWriter& data(bytesConstRef _data);
+    /// Writes @a _value as a "0x"-prefixed hex number without leading zeros.
+    JsonWriter& quantity(uint64_t _value);
+    JsonWriter& quantity(u256 const& _value);
+
+private:
+    /// Writes the comma that precedes a value, if it is not the first in its container.
+    void separate();
+    JsonWriter& writeString(char const* _data, size_t _size);
+
+    std::string& m_out;
+    bool m_needsComma = false;
+};
+
+}  // namespace rpc
+}  // namespace dev
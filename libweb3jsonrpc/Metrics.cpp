@@ -0,0 +1,150 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "Metrics.h"
+
+#include <libethashseal/Ethash.h>
+#include <libethereum/Client.h>
+
+#include <sstream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::rpc;
+
+namespace
+{
+double const c_quantiles[] = {0.5, 0.95, 0.99};
+
+Json::Value toJson(Histogram const& _histogram)
+{
+    Json::Value ret{Json::objectValue};
+    ret["count"] = Json::UInt64(_histogram.count());
+    ret["mean"] = _histogram.mean();
+    ret["p50"] = _histogram.quantile(0.5);
+    ret["p95"] = _histogram.quantile(0.95);
+    ret["p99"] = _histogram.quantile(0.99);
+    return ret;
+}
+
+vector<pair<string, uint64_t>> blockChainCache(BlockChain::Statistics const& _stats)
+{
+    return {{"blocks", _stats.memBlocks}, {"details", _stats.memDetails},
+        {"logBlooms", _stats.memLogBlooms}, {"receipts", _stats.memReceipts},
+        {"transactionAddresses", _stats.memTransactionAddresses},
+        {"blockHashes", _stats.memBlockHashes}};
+}
+
+void writeSummary(ostream& _out, string const& _name, string const& _labels, Histogram const& _histogram)
+{
+    string const separator = _labels.empty() ? "" : ",";
+    for (double q : c_quantiles)
+        _out << _name << "{" << _labels << separator << "quantile=\"" << q << "\"} "
+             << _histogram.quantile(q) << "\n";
+    string const labels = _labels.empty() ? "" : "{" + _labels + "}";
+    _out << _name << "_sum" << labels << " " << _histogram.sum() << "\n";
+    _out << _name << "_count" << labels << " " << _histogram.count() << "\n";
+}
+}  // namespace
+
+Json::Value dev::rpc::metricsJson(Client const& _client)
+{
+    ImportMetrics const& metrics = _client.importMetrics();
+    Json::Value import{Json::objectValue};
+    import["blocks"] = Json::UInt64(metrics.blocks());
+    import["transactions"] = Json::UInt64(metrics.transactions());
+    import["gasUsed"] = Json::UInt64(metrics.gasUsed());
+    Json::Value& stages = import["stageSeconds"] = Json::Value{Json::objectValue};
+    for (char const* stage : ImportMetrics::c_stages)
+        stages[stage] = toJson(*metrics.stage(stage));
+    import["gasPerSecond"] = toJson(metrics.gasPerSecond());
+    import["transactionsPerSecond"] = toJson(metrics.transactionsPerSecond());
+
+    Json::Value ret{Json::objectValue};
+    ret["import"] = import;
+
+    auto const blockQueue = _client.blockQueue().items();
+    ret["blockQueue"]["ready"] = blockQueue.first;
+    ret["blockQueue"]["unknown"] = blockQueue.second;
+
+    TransactionQueue::Status const transactionQueue = _client.transactionQueueStatus();
+    ret["transactionQueue"]["current"] = Json::UInt64(transactionQueue.current);
+    ret["transactionQueue"]["future"] = Json::UInt64(transactionQueue.future);
+    ret["transactionQueue"]["unverified"] = Json::UInt64(transactionQueue.unverified);
+    ret["transactionQueue"]["dropped"] = Json::UInt64(transactionQueue.dropped);
+
+    Json::Value& cache = ret["blockChainCacheBytes"] = Json::Value{Json::objectValue};
+    for (auto const& entry : blockChainCache(_client.blockChain().usage()))
+        cache[entry.first] = Json::UInt64(entry.second);
+
+    if (auto const ethash = dynamic_cast<Ethash const*>(_client.sealEngine()))
+    {
+        EpochContextStats const epochContexts = ethash->epochContextStats();
+        Json::Value& contexts = ret["ethashEpochContexts"] = Json::Value{Json::objectValue};
+        contexts["generations"] = epochContexts.generations;
+        contexts["blockingGenerations"] = epochContexts.blockingGenerations;
+        contexts["lastGenerationSeconds"] = epochContexts.lastGenerationSeconds;
+        contexts["totalGenerationSeconds"] = epochContexts.totalGenerationSeconds;
+        contexts["totalWaitSeconds"] = epochContexts.totalWaitSeconds;
+    }
+    return ret;
+}
+
+string dev::rpc::prometheusMetrics(Client const& _client)
+{
+    ImportMetrics const& metrics = _client.importMetrics();
+    ostringstream out;
+
+    out << "# TYPE aleth_import_blocks_total counter\n"
+        << "aleth_import_blocks_total " << metrics.blocks() << "\n"
+        << "# TYPE aleth_import_transactions_total counter\n"
+        << "aleth_import_transactions_total " << metrics.transactions() << "\n"
+        << "# TYPE aleth_import_gas_total counter\n"
+        << "aleth_import_gas_total " << metrics.gasUsed() << "\n";
+
+    out << "# TYPE aleth_import_stage_seconds summary\n";
+    for (char const* stage : ImportMetrics::c_stages)
+        writeSummary(out, "aleth_import_stage_seconds", "stage=\"" + string(stage) + "\"",
+            *metrics.stage(stage));
+    out << "# TYPE aleth_import_gas_per_second summary\n";
+    writeSummary(out, "aleth_import_gas_per_second", "", metrics.gasPerSecond());
+    out << "# TYPE aleth_import_transactions_per_second summary\n";
+    writeSummary(out, "aleth_import_transactions_per_second", "", metrics.transactionsPerSecond());
+
+    auto const blockQueue = _client.blockQueue().items();
+    out << "# TYPE aleth_block_queue_items gauge\n"
+        << "aleth_block_queue_items{state=\"ready\"} " << blockQueue.first << "\n"
+        << "aleth_block_queue_items{state=\"unknown\"} " << blockQueue.second << "\n";
+
+    TransactionQueue::Status const transactionQueue = _client.transactionQueueStatus();
+    out << "# TYPE aleth_transaction_queue_items gauge\n"
+        << "aleth_transaction_queue_items{state=\"current\"} " << transactionQueue.current << "\n"
+        << "aleth_transaction_queue_items{state=\"future\"} " << transactionQueue.future << "\n"
+        << "aleth_transaction_queue_items{state=\"unverified\"} " << transactionQueue.unverified
+        << "\n"
+        << "aleth_transaction_queue_items{state=\"dropped\"} " << transactionQueue.dropped << "\n";
+
+    out << "# TYPE aleth_blockchain_cache_bytes gauge\n";
+    for (auto const& entry : blockChainCache(_client.blockChain().usage()))
+        out << "aleth_blockchain_cache_bytes{cache=\"" << entry.first << "\"} " << entry.second
+            << "\n";
+
+    if (auto const ethash = dynamic_cast<Ethash const*>(_client.sealEngine()))
+    {
+        EpochContextStats const epochContexts = ethash->epochContextStats();
+        out << "# TYPE aleth_ethash_epoch_context_generations_total counter\n"
+            << "aleth_ethash_epoch_context_generations_total{blocking=\"false\"} "
+            << epochContexts.generations - epochContexts.blockingGenerations << "\n"
+            << "aleth_ethash_epoch_context_generations_total{blocking=\"true\"} "
+            << epochContexts.blockingGenerations << "\n"
+            << "# TYPE aleth_ethash_epoch_context_generation_seconds_total counter\n"
+            << "aleth_ethash_epoch_context_generation_seconds_total "
+            << epochContexts.totalGenerationSeconds << "\n"
+            << "# TYPE aleth_ethash_epoch_context_wait_seconds_total counter\n"
+            << "aleth_ethash_epoch_context_wait_seconds_total " << epochContexts.totalWaitSeconds
+            << "\n";
+    }
+    return out.str();
+}
@@ -0,0 +1,29 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Performance metrics of a running client: block import statistics, queue depths and the time
+/// spent generating Ethash epoch contexts.
+#pragma once
+
+#include <json/json.h>
+
+#include <string>
+
+namespace dev
+{
+namespace eth
+{
+class Client;
+}
+
+namespace rpc
+{
+/// @returns the metrics of @a _client as returned by debug_metrics.
+Json::Value metricsJson(eth::Client const& _client);
+
+/// @returns the metrics of @a _client in the Prometheus text exposition format.
+std::string prometheusMetrics(eth::Client const& _client);
+}  // namespace rpc
+}  // namespace dev
@@ -10,6 +10,8 @@
 #include <tuple>
 #include <vector>
 
+#include "DirectRequestHandler.h"
+
 #include <jsonrpccpp/common/exception.h>
 #include <jsonrpccpp/common/procedure.h>
 #include <jsonrpccpp/server/abstractserverconnector.h>
@@ -18,6 +20,7 @@
 
 template <class I> using AbstractMethodPointer = void(I::*)(Json::Value const& _parameter, Json::Value& _result);
 template <class I> using AbstractNotificationPointer = void(I::*)(Json::Value const& _parameter);
+template <class I> using AbstractDirectMethodPointer = bool(I::*)(Json::Value const& _parameter, dev::rpc::JsonWriter& o_result);
 
 template <class I>
 class ServerInterface
@@ -25,27 +28,35 @@ class ServerInterface
 public:
     using MethodPointer = AbstractMethodPointer<I>;
     using NotificationPointer = AbstractNotificationPointer<I>;
+    using DirectMethodPointer = AbstractDirectMethodPointer<I>;
 
     using MethodBinding = std::tuple<jsonrpc::Procedure, AbstractMethodPointer<I>>;
     using NotificationBinding = std::tuple<jsonrpc::Procedure, AbstractNotificationPointer<I>>;
     using Methods = std::vector<MethodBinding>;
     using Notifications = std::vector<NotificationBinding>;
+    using DirectMethodBinding = std::tuple<std::string, DirectMethodPointer>;
+    using DirectMethods = std::vector<DirectMethodBinding>;
     struct RPCModule { std::string name; std::string version; };
     using RPCModules = std::vector<RPCModule>;
 
     virtual ~ServerInterface() {}
     Methods const& methods() const { return m_methods; }
     Notifications const& notifications() const { return m_notifications; }
+    DirectMethods const& directMethods() const { return m_directMethods; }
     /// @returns which interfaces (eth, admin, db, ...) this class implements in which version.
     virtual RPCModules implementedModules() const = 0;
 
 protected:
     void bindAndAddMethod(jsonrpc::Procedure const& _proc, MethodPointer _pointer) { m_methods.emplace_back(_proc, _pointer); }
     void bindAndAddNotification(jsonrpc::Procedure const& _proc, NotificationPointer _pointer) { m_notifications.emplace_back(_proc, _pointer); }
+    /// Answer calls to the method @a _name, bound with bindAndAddMethod() too, by writing the result
+    /// straight into the response, see dev::rpc::DirectRequestHandler.
+    void bindDirectMethod(std::string const& _name, DirectMethodPointer _pointer) { m_directMethods.emplace_back(_name, _pointer); }
 
 private:
     Methods m_methods;
     Notifications m_notifications;
+    DirectMethods m_directMethods;
 };
 
 template <class... Is>
@@ -53,7 +64,8 @@ class ModularServer: public jsonrpc::IProcedureInvokationHandler
 {
 public:
     ModularServer()
-    : m_handler(jsonrpc::RequestHandlerFactory::createProtocolHandler(jsonrpc::JSONRPC_SERVER_V2, *this))
+    : m_handler(new dev::rpc::DirectRequestHandler(
+          jsonrpc::RequestHandlerFactory::createProtocolHandler(jsonrpc::JSONRPC_SERVER_V2, *this)))
     {
         m_handler->AddProcedure(jsonrpc::Procedure("rpc_modules", jsonrpc::PARAMS_BY_POSITION, jsonrpc::JSON_OBJECT, NULL));
         m_implementedModules = Json::objectValue;
@@ -105,7 +117,7 @@ public:
 
 protected:
     std::vector<std::unique_ptr<jsonrpc::AbstractServerConnector>> m_connectors;
-    std::unique_ptr<jsonrpc::IProtocolHandler> m_handler;
+    std::unique_ptr<dev::rpc::DirectRequestHandler> m_handler;
     /// Mapping for implemented modules, to be filled by subclasses during construction.
     Json::Value m_implementedModules;
 };
@@ -132,6 +144,16 @@ public:
             m_notifications[std::get<0>(notification).GetProcedureName()] = std::get<1>(notification);
             this->m_handler->AddProcedure(std::get<0>(notification));
         }
+
+        for (auto const& method: m_interface->directMethods())
+        {
+            I* target = m_interface.get();
+            auto const pointer = std::get<1>(method);
+            this->m_handler->addMethod(std::get<0>(method),
+                [target, pointer](Json::Value const& _params, dev::rpc::JsonWriter& o_result) {
+                    return (target->*pointer)(_params, o_result);
+                });
+        }
         // Store module with version.
         for (auto const& module: m_interface->implementedModules())
             this->m_implementedModules[module.name] = module.version;
@@ -0,0 +1,332 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include "Subscriptions.h"
+#include "JsonHelper.h"
+#include "JsonWriter.h"
+
+#include <libdevcore/Log.h>
+#include <libethcore/CommonJS.h>
+#include <libethereum/Client.h>
+
+#include <jsonrpccpp/common/errors.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::rpc;
+
+Subscriptions::Subscriber::Subscriber(
+    Send const& _send, Disconnect const& _disconnect, size_t _maxQueued)
+  : m_send(_send), m_disconnect(_disconnect), m_maxQueued(_maxQueued)
+{
+    m_writer = thread([this]() { run(); });
+}
+
+void Subscriptions::Subscriber::push(string _message)
+{
+    {
+        Guard l(x_queue);
+        if (m_stopped || m_overflowed)
+            return;
+        if (m_queue.size() < m_maxQueued)
+        {
+            m_queue.push_back(move(_message));
+            m_queued.notify_one();
+            return;
+        }
+        m_overflowed = true;
+        m_queue.clear();
+    }
+    // Notifications can't be dropped silently, so a client that doesn't keep up has to reconnect.
+    cwarn << "Disconnecting a JSON-RPC subscriber that is " << m_maxQueued
+          << " notifications behind";
+    m_disconnect();
+}
+
+void Subscriptions::Subscriber::stop()
+{
+    DEV_GUARDED(x_queue)
+        m_stopped = true;
+    m_queued.notify_one();
+    if (m_writer.joinable())
+        m_writer.join();
+}
+
+void Subscriptions::Subscriber::run()
+{
+    while (true)
+    {
+        string message;
+        {
+            unique_lock<Mutex> l(x_queue);
+            m_queued.wait(l, [this]() { return m_stopped || !m_queue.empty(); });
+            if (m_stopped)
+                return;
+            message = move(m_queue.front());
+            m_queue.pop_front();
+        }
+        if (!m_send(message))
+        {
+            // The transport notices the failed connection and closes it.
+            Guard l(x_queue);
+            m_stopped = true;
+            m_queue.clear();
+            return;
+        }
+    }
+}
+
+Subscriptions::Subscriptions(Client& _client, size_t _maxQueued)
+  : m_client(_client), m_maxQueued(_maxQueued)
+{
+    m_dispatcher = thread([this]() { dispatch(); });
+    m_onChainChanged = m_client.setOnChainChanged([this](h256s const& _dead, h256s const& _live) {
+        post([this, _dead, _live]() { notifyChain(_dead, _live); });
+    });
+    m_onPendingTransactions = m_client.setOnPendingTransactions([this](h256s const& _transactions) {
+        post([this, _transactions]() { notifyPending(_transactions); });
+    });
+}
+
+Subscriptions::~Subscriptions()
+{
+    m_onChainChanged.reset();
+    m_onPendingTransactions.reset();
+
+    DEV_GUARDED(x_events)
+        m_stopped = true;
+    m_eventsQueued.notify_one();
+    m_dispatcher.join();
+
+    map<void const*, shared_ptr<Subscriber>> subscribers;
+    DEV_GUARDED(x_subscriptions)
+        swap(subscribers, m_subscribers);
+    for (auto const& subscriber: subscribers)
+        subscriber.second->stop();
+}
+
+bool Subscriptions::handleRequest(
+    string const& _request, void const* _connection, Send const& _send, Disconnect const& _disconnect)
+{
+    // Other requests are only parsed once, by the JSON-RPC server.
+    if (_request.find("subscribe\"") == string::npos)
+        return false;
+
+    Json::Value request;
+    if (!Json::Reader().parse(_request, request, false) || !request.isObject() ||
+        !request["method"].isString())
+        return false;
+    string const method = request["method"].asString();
+    if (method != "eth_subscribe" && method != "eth_unsubscribe")
+        return false;
+
+    Json::Value response{Json::objectValue};
+    response["id"] = request["id"];
+    response["jsonrpc"] = "2.0";
+    Json::Value const& params = request["params"];
+
+    Guard l(x_subscriptions);
+    auto& subscriber = m_subscribers[_connection];
+    if (!subscriber)
+        subscriber = make_shared<Subscriber>(_send, _disconnect, m_maxQueued);
+
+    if (method == "eth_unsubscribe" && params.isArray() && params.size() == 1 && params[0].isString())
+    {
+        auto const subscription = m_subscriptions.find(params[0].asString());
+        bool const found =
+            subscription != m_subscriptions.end() && subscription->second.connection == _connection;
+        if (found)
+            m_subscriptions.erase(subscription);
+        response["result"] = found;
+    }
+    else if (method == "eth_subscribe" && params.isArray() && params.size() >= 1 &&
+             params[0].isString())
+    {
+        Subscription subscription{Kind::NewHeads, LogFilter{}, _connection};
+        string const kind = params[0].asString();
+        bool valid = params.size() == 1;
+        if (kind == "logs")
+        {
+            subscription.kind = Kind::Logs;
+            try
+            {
+                if (params.size() == 2)
+                    subscription.filter = toLogFilter(params[1]);
+                valid = params.size() <= 2;
+            }
+            catch (...)
+            {
+                valid = false;
+            }
+        }
+        else if (kind == "newPendingTransactions")
+            subscription.kind = Kind::NewPendingTransactions;
+        else if (kind != "newHeads")
+            valid = false;
+
+        if (valid)
+        {
+            string const id = toJS(u256(++m_lastId));
+            m_subscriptions.emplace(id, subscription);
+            response["result"] = id;
+        }
+    }
+    if (!response.isMember("result"))
+    {
+        response["error"]["code"] = jsonrpc::Errors::ERROR_RPC_INVALID_PARAMS;
+        response["error"]["message"] =
+            jsonrpc::Errors::GetErrorMessage(jsonrpc::Errors::ERROR_RPC_INVALID_PARAMS);
+    }
+
+    // Queued with the notifications, so that none is written before the subscription id.
+    subscriber->push(Json::FastWriter().write(response));
+    return true;
+}
+
+void Subscriptions::closeConnection(void const* _connection)
+{
+    shared_ptr<Subscriber> subscriber;
+    DEV_GUARDED(x_subscriptions)
+    {
+        for (auto i = m_subscriptions.begin(); i != m_subscriptions.end();)
+            if (i->second.connection == _connection)
+                i = m_subscriptions.erase(i);
+            else
+                ++i;
+        auto const found = m_subscribers.find(_connection);
+        if (found == m_subscribers.end())
+            return;
+        subscriber = found->second;
+        m_subscribers.erase(found);
+    }
+    subscriber->stop();
+}
+
+size_t Subscriptions::size() const
+{
+    Guard l(x_subscriptions);
+    return m_subscriptions.size();
+}
+
+void Subscriptions::post(function<void()> const& _event)
+{
+    DEV_GUARDED(x_events)
+        m_events.push_back(_event);
+    m_eventsQueued.notify_one();
+}
+
+void Subscriptions::dispatch()
+{
+    while (true)
+    {
+        function<void()> event;
+        {
+            unique_lock<Mutex> l(x_events);
+            m_eventsQueued.wait(l, [this]() { return m_stopped || !m_events.empty(); });
+            if (m_stopped)
+                return;
+            event = move(m_events.front());
+            m_events.pop_front();
+        }
+        try
+        {
+            event();
+        }
+        catch (exception const& _e)
+        {
+            cwarn << "Failed to notify JSON-RPC subscribers: " << _e.what();
+        }
+    }
+}
+
+void Subscriptions::notifyChain(h256s const& _deadBlocks, h256s const& _liveBlocks)
+{
+    // Reading the blocks and receipts is slow; it's done on a copy so that subscribing isn't
+    // blocked meanwhile.
+    map<string, Subscription> subscriptions;
+    DEV_GUARDED(x_subscriptions)
+        subscriptions = m_subscriptions;
+    if (subscriptions.empty())
+        return;
+
+    struct Notification
+    {
+        string id;
+        void const* connection;
+        string result;
+    };
+    vector<Notification> notifications;
+
+    BlockChain const& bc = m_client.blockChain();
+    auto const notifyLogs = [&](h256 const& _block, BlockPolarity _polarity) {
+        BlockHeader const header = bc.info(_block);
+        TransactionReceipts receipts;
+        TransactionHashes hashes;
+        for (auto const& subscription: subscriptions)
+        {
+            if (subscription.second.kind != Kind::Logs ||
+                !subscription.second.filter.matches(header.logBloom()))
+                continue;
+            if (receipts.empty())
+            {
+                receipts = bc.receipts(_block).receipts;
+                hashes = bc.transactionHashes(_block);
+            }
+            // Same entries as eth_getLogs gives for the block.
+            for (unsigned i = 0; i < receipts.size(); ++i)
+                for (LogEntry const& log: subscription.second.filter.matches(receipts[i]))
+                {
+                    string result;
+                    JsonWriter writer{result};
+                    writeJson(writer, LocalisedLogEntry{log, _block, BlockNumber(header.number()),
+                                          hashes[i], i, 0, _polarity});
+                    notifications.push_back(
+                        {subscription.first, subscription.second.connection, move(result)});
+                }
+        }
+    };
+
+    for (h256 const& block: _deadBlocks)
+        notifyLogs(block, BlockPolarity::Dead);
+    for (h256 const& block: _liveBlocks)
+    {
+        string const head = Json::FastWriter().write(toJson(bc.info(block), m_client.sealEngine()));
+        for (auto const& subscription: subscriptions)
+            if (subscription.second.kind == Kind::NewHeads)
+                notifications.push_back({subscription.first, subscription.second.connection,
+                    head.substr(0, head.size() - 1)});
+        notifyLogs(block, BlockPolarity::Live);
+    }
+
+    // Subscriptions cancelled in the meantime are not notified.
+    Guard l(x_subscriptions);
+    for (auto const& notification: notifications)
+        if (m_subscriptions.count(notification.id))
+            notify(notification.id, notification.connection, notification.result);
+}
+
+void Subscriptions::notifyPending(h256s const& _transactions)
+{
+    Guard l(x_subscriptions);
+    for (auto const& subscription: m_subscriptions)
+        if (subscription.second.kind == Kind::NewPendingTransactions)
+            for (h256 const& transaction: _transactions)
+                notify(subscription.first, subscription.second.connection,
+                    '"' + toJS(transaction) + '"');
+}
+
+void Subscriptions::notify(string const& _id, void const* _connection, string const& _result)
+{
+    auto const subscriber = m_subscribers.find(_connection);
+    if (subscriber == m_subscribers.end())
+        return;
+    string notification;
+    JsonWriter writer{notification};
+    writer.beginObject().key("jsonrpc").value("2.0").key("method").value("eth_subscription");
+    writer.key("params").beginObject().key("subscription").value(_id).key("result").raw(_result);
+    writer.endObject().endObject();
+    notification += '\n';
+    subscriber->second->push(move(notification));
+}
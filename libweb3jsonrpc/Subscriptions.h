@@ -0,0 +1,136 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// eth_subscribe notifications pushed to the clients of a connection-oriented transport.
+#pragma once
+
+#include <libdevcore/Guards.h>
+#include <libethcore/Common.h>
+#include <libethereum/LogFilter.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace dev
+{
+namespace eth
+{
+class Client;
+}
+
+namespace rpc
+{
+/**
+ * @brief Subscriptions of the connected clients to new heads, logs and pending transactions.
+ *
+ * A transport hands every request to handleRequest() first, which answers eth_subscribe and
+ * eth_unsubscribe. Changes reported by the client are turned into eth_subscription notifications
+ * on a thread of their own, so block import doesn't wait for them, and queued for each
+ * connection. Every connection has a writer thread that empties its queue; a connection that lets
+ * more than the maximum number of messages pile up is disconnected, and its subscriptions are
+ * dropped.
+ */
+class Subscriptions
+{
+public:
+    /// Writes a complete message to a connection. @returns false if the connection failed.
+    using Send = std::function<bool(std::string const&)>;
+    /// Disconnects a connection, after which the transport calls closeConnection().
+    using Disconnect = std::function<void()>;
+
+    static size_t const c_defaultMaxQueued = 10000;
+
+    explicit Subscriptions(eth::Client& _client, size_t _maxQueued = c_defaultMaxQueued);
+    ~Subscriptions();
+
+    /// Answers @a _request, received on @a _connection, if it is a call to eth_subscribe or
+    /// eth_unsubscribe. The response and all notifications are written with @a _send; they are
+    /// written in order, but not necessarily before this returns.
+    /// @returns false if the request is for another method and must be handled as usual.
+    bool handleRequest(std::string const& _request, void const* _connection, Send const& _send,
+        Disconnect const& _disconnect);
+
+    /// Drops the subscriptions of @a _connection and waits until nothing more is written to it.
+    void closeConnection(void const* _connection);
+
+    /// @returns the number of active subscriptions, of all connections.
+    size_t size() const;
+
+private:
+    enum class Kind
+    {
+        NewHeads,
+        Logs,
+        NewPendingTransactions
+    };
+
+    struct Subscription
+    {
+        Kind kind;
+        eth::LogFilter filter;
+        void const* connection;
+    };
+
+    /// Bounded queue of the messages to a connection, and the thread that writes them.
+    class Subscriber
+    {
+    public:
+        Subscriber(Send const& _send, Disconnect const& _disconnect, size_t _maxQueued);
+        ~Subscriber() { stop(); }
+
+        /// Queues @a _message. If the queue is full, disconnects the client instead.
+        void push(std::string _message);
+        /// Writes nothing more and waits for the writer thread.
+        void stop();
+
+    private:
+        void run();
+
+        Send m_send;
+        Disconnect m_disconnect;
+        size_t m_maxQueued;
+        Mutex x_queue;
+        std::condition_variable m_queued;
+        std::deque<std::string> m_queue;
+        bool m_stopped = false;
+        bool m_overflowed = false;
+        std::thread m_writer;
+    };
+
+    /// Queues @a _event for the dispatcher thread.
+    void post(std::function<void()> const& _event);
+    void dispatch();
+
+    void notifyChain(h256s const& _deadBlocks, h256s const& _liveBlocks);
+    void notifyPending(h256s const& _transactions);
+    /// Queues a notification for subscription @a _id; @a _result is the JSON text of its result.
+    /// Must be called with x_subscriptions locked.
+    void notify(std::string const& _id, void const* _connection, std::string const& _result);
+
+    eth::Client& m_client;
+    size_t const m_maxQueued;
+
+    mutable Mutex x_subscriptions;
+    std::map<std::string, Subscription> m_subscriptions;
+    std::map<void const*, std::shared_ptr<Subscriber>> m_subscribers;
+    uint64_t m_lastId = 0;
+
+    Mutex x_events;
+    std::condition_variable m_eventsQueued;
+    std::deque<std::function<void()>> m_events;
+    bool m_stopped = false;
+    std::thread m_dispatcher;
+
+    eth::Handler<h256s const&, h256s const&> m_onChainChanged;
+    eth::Handler<h256s const&> m_onPendingTransactions;
+};
+
+}  // namespace rpc
+}  // namespace dev
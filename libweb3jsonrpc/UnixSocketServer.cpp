@@ -113,6 +113,11 @@ void UnixDomainSocketServer::CloseConnection(int _socket)
 	close(_socket);
 }
 
+void UnixDomainSocketServer::ShutdownConnection(int _socket)
+{
+	shutdown(_socket, SHUT_RDWR);
+}
+
 
 size_t UnixDomainSocketServer::Write(int _connection, string const& _data)
 {
@@ -21,6 +21,7 @@ public:
 protected:
     void Listen() override;
     void CloseConnection(int _socket) override;
+    void ShutdownConnection(int _socket) override;
     size_t Write(int _connection, std::string const& _data) override;
     size_t Read(int _connection, void* _data, size_t _size) override;
 
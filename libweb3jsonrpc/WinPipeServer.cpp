@@ -22,6 +22,11 @@ void WindowsPipeServer::CloseConnection(HANDLE _socket)
     ::CloseHandle(_socket);
 }
 
+void WindowsPipeServer::ShutdownConnection(HANDLE _socket)
+{
+    ::DisconnectNamedPipe(_socket);
+}
+
 size_t WindowsPipeServer::Write(HANDLE _connection, std::string const& _data)
 {
     DWORD written = 0;
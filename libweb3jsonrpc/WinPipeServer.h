@@ -17,6 +17,7 @@ public:
 protected:
     void Listen() override;
     void CloseConnection(HANDLE _socket) override;
+    void ShutdownConnection(HANDLE _socket) override;
     size_t Write(HANDLE _connection, std::string const& _data) override;
     size_t Read(HANDLE _connection, void* _data, size_t _size) override;
 };
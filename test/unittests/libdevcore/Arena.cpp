@@ -0,0 +1,150 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Arena and ArenaAllocator unit tests.
+#include <libdevcore/Arena.h>
+#include <gtest/gtest.h>
+
+#include <map>
+#include <scoped_allocator>
+#include <unordered_map>
+
+using namespace std;
+using namespace dev;
+
+namespace
+{
+using Map = unordered_map<int, int, hash<int>, equal_to<int>, ArenaAllocator<pair<int const, int>>>;
+
+/// Has a map using the allocator it is constructed with, like Account.
+struct Holder
+{
+    using allocator_type = Map::allocator_type;
+
+    explicit Holder(allocator_type const& _alloc = allocator_type()): values(_alloc) {}
+    Holder(Holder const&) = default;
+    Holder(Holder const& _other, allocator_type const& _alloc): values(_other.values, _alloc) {}
+
+    Map values;
+};
+
+using Holders = map<int, Holder, less<int>, scoped_allocator_adaptor<ArenaAllocator<pair<int const, Holder>>>>;
+
+Holders::allocator_type holdersAllocator(Arena& _arena)
+{
+    return Holders::allocator_type{ArenaAllocator<Holders::value_type>{&_arena}};
+}
+}  // namespace
+
+TEST(Arena, allocationsAreAligned)
+{
+    Arena arena;
+    vector<void*> allocations{arena.allocate(1, 1), arena.allocate(8, 8)};
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(allocations.back()) % 8, 0);
+    allocations.push_back(arena.allocate(3, 1));
+    allocations.push_back(arena.allocate(16, alignof(max_align_t)));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(allocations.back()) % alignof(max_align_t), 0);
+    EXPECT_EQ(arena.live(), 4);
+    for (void* p : allocations)
+        arena.deallocate(p);
+}
+
+TEST(Arena, releaseOnlyWhenNothingIsLive)
+{
+    Arena arena;
+    void* a = arena.allocate(100, 8);
+    void* b = arena.allocate(100, 8);
+    arena.deallocate(a);
+    EXPECT_FALSE(arena.release());
+    arena.deallocate(b);
+    EXPECT_TRUE(arena.release());
+    EXPECT_EQ(arena.allocate(100, 8), a);
+    arena.deallocate(a);
+}
+
+TEST(Arena, releaseKeepsTheLargestBlock)
+{
+    Arena arena;
+    vector<void*> allocations;
+    for (size_t i = 0; i < 10 * Arena::c_firstBlockSize / 1024; ++i)
+        allocations.push_back(arena.allocate(1024, 8));
+    EXPECT_GT(arena.capacity(), 10 * Arena::c_firstBlockSize);
+    for (void* p : allocations)
+        arena.deallocate(p);
+    ASSERT_TRUE(arena.release());
+    EXPECT_GE(arena.capacity(), 8 * Arena::c_firstBlockSize);
+    EXPECT_LT(arena.capacity(), 10 * Arena::c_firstBlockSize);
+}
+
+TEST(Arena, releaseKeepsTheLargestBlockWhenTheLastIsCut)
+{
+    Arena arena;
+    void* large = arena.allocate(Arena::c_maxSize - Arena::c_firstBlockSize, 8);
+    // The next block is cut to what is left below c_maxSize.
+    void* small = arena.allocate(100, 8);
+    EXPECT_EQ(arena.capacity(), Arena::c_maxSize);
+    arena.deallocate(small);
+    arena.deallocate(large);
+    ASSERT_TRUE(arena.release());
+    EXPECT_EQ(arena.capacity(), Arena::c_maxSize - Arena::c_firstBlockSize);
+}
+
+TEST(Arena, largeAllocations)
+{
+    Arena arena;
+    void* small = arena.allocate(10, 8);
+    void* large = arena.allocate(10 * Arena::c_firstBlockSize, 8);
+    EXPECT_GE(arena.capacity(), 11 * Arena::c_firstBlockSize);
+    arena.deallocate(large);
+    arena.deallocate(small);
+    EXPECT_TRUE(arena.release());
+}
+
+TEST(Arena, heapBeyondMaxSize)
+{
+    Arena arena;
+    void* block = arena.allocate(Arena::c_maxSize, 8);
+    void* heap = arena.allocate(100, 8);
+    EXPECT_EQ(arena.capacity(), Arena::c_maxSize);
+    EXPECT_EQ(arena.live(), 1);
+    arena.deallocate(heap);
+    arena.deallocate(block);
+    EXPECT_TRUE(arena.release());
+}
+
+TEST(ArenaAllocator, nestedContainers)
+{
+    Arena arena;
+    {
+        Holders holders{holdersAllocator(arena)};
+        for (int i = 0; i < 100; ++i)
+            for (int j = 0; j < 10; ++j)
+                holders[i].values[j] = i * j;
+        EXPECT_EQ(holders[7].values.get_allocator().arena(), &arena);
+        EXPECT_EQ(holders[99].values.at(9), 99 * 9);
+        EXPECT_GT(arena.live(), 1000);
+
+        // Copies take their memory from the heap, unless given an allocator.
+        Holders const copy{holders};
+        EXPECT_EQ(copy.at(7).values.get_allocator().arena(), nullptr);
+        Holder const holder{holders[3]};
+        EXPECT_EQ(holder.values.get_allocator().arena(), nullptr);
+
+        Arena other;
+        {
+            Holders const inOther{holders, holdersAllocator(other)};
+            EXPECT_EQ(inOther.at(7).values.get_allocator().arena(), &other);
+            EXPECT_EQ(inOther.at(99).values.at(9), 99 * 9);
+        }
+        EXPECT_TRUE(other.release());
+
+        // Assignment keeps the allocator of the target.
+        holders = copy;
+        EXPECT_EQ(holders[7].values.get_allocator().arena(), &arena);
+        EXPECT_FALSE(arena.release());
+    }
+    EXPECT_EQ(arena.live(), 0);
+    EXPECT_TRUE(arena.release());
+}
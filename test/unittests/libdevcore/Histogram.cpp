@@ -0,0 +1,65 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include <libdevcore/Histogram.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <thread>
+
+using namespace std;
+using namespace dev;
+
+TEST(Histogram, empty)
+{
+    Histogram const histogram{1, 10};
+    EXPECT_EQ(histogram.count(), 0);
+    EXPECT_EQ(histogram.mean(), 0);
+    EXPECT_EQ(histogram.quantile(0.5), 0);
+}
+
+TEST(Histogram, quantilesWithinBucketPrecision)
+{
+    Histogram histogram{1, 20};
+    for (unsigned i = 1; i <= 1000; ++i)
+        histogram.record(i);
+
+    EXPECT_EQ(histogram.count(), 1000);
+    EXPECT_DOUBLE_EQ(histogram.sum(), 500500);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 500.5);
+    for (double q : {0.5, 0.95, 0.99})
+    {
+        double const exact = q * 1000;
+        EXPECT_GE(histogram.quantile(q), exact);
+        EXPECT_LE(histogram.quantile(q), exact * 1.19);
+    }
+}
+
+TEST(Histogram, outOfRangeValuesAreClamped)
+{
+    Histogram histogram{1, 4};
+    histogram.record(0);
+    histogram.record(-1);
+    EXPECT_DOUBLE_EQ(histogram.quantile(1), exp2(0.25));
+
+    histogram.record(1e9);
+    EXPECT_DOUBLE_EQ(histogram.quantile(1), 16);
+    EXPECT_EQ(histogram.count(), 3);
+}
+
+TEST(Histogram, concurrentRecording)
+{
+    Histogram histogram{1, 10};
+    vector<thread> threads;
+    for (unsigned t = 0; t < 4; ++t)
+        threads.emplace_back([&histogram] {
+            for (unsigned i = 0; i < 10000; ++i)
+                histogram.record(2);
+        });
+    for (auto& t : threads)
+        t.join();
+
+    EXPECT_EQ(histogram.count(), 40000);
+    EXPECT_DOUBLE_EQ(histogram.sum(), 80000);
+}
@@ -0,0 +1,66 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+#include <libdevcore/ObjectPool.h>
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace dev;
+
+namespace
+{
+struct Pooled
+{
+    static unsigned s_live;
+
+    Pooled() { ++s_live; }
+    ~Pooled() { --s_live; }
+
+    void recycle(size_t _maxBufferSize) { recycledWith = _maxBufferSize; }
+
+    size_t recycledWith = 0;
+};
+
+unsigned Pooled::s_live = 0;
+}  // namespace
+
+TEST(ObjectPool, reusesInStackOrder)
+{
+    ObjectPool<Pooled> pool{4, 1024};
+    Pooled* outer = pool.take();
+    Pooled* inner = pool.take();
+    EXPECT_NE(outer, inner);
+    EXPECT_EQ(Pooled::s_live, 2);
+
+    pool.recycle(inner);
+    pool.recycle(outer);
+    EXPECT_EQ(pool.size(), 2);
+    EXPECT_EQ(outer->recycledWith, 1024);
+
+    // Taken again at the same depths.
+    EXPECT_EQ(pool.take(), outer);
+    EXPECT_EQ(pool.take(), inner);
+    EXPECT_EQ(pool.size(), 0);
+    EXPECT_EQ(Pooled::s_live, 2);
+    pool.recycle(inner);
+    pool.recycle(outer);
+}
+
+TEST(ObjectPool, deletesBeyondMaxPooled)
+{
+    unsigned const liveBefore = Pooled::s_live;
+    {
+        ObjectPool<Pooled> pool{2, 1024};
+        vector<Pooled*> taken;
+        for (unsigned i = 0; i < 3; ++i)
+            taken.push_back(pool.take());
+        EXPECT_EQ(Pooled::s_live, liveBefore + 3);
+
+        for (Pooled* p : taken)
+            pool.recycle(p);
+        EXPECT_EQ(pool.size(), 2);
+        EXPECT_EQ(Pooled::s_live, liveBefore + 2);
+    }
+    EXPECT_EQ(Pooled::s_live, liveBefore);
+}
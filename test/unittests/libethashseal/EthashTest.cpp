@@ -3,6 +3,7 @@
 // Licensed under the GNU General Public License, Version 3.
 
 #include <libethashseal/Ethash.h>
+#include <libethashseal/EthashCPUMinerDetail.h>
 
 #include <gtest/gtest.h>
 
@@ -239,3 +240,104 @@ TEST(Ethash, boundary)
     EXPECT_EQ(Ethash::boundary(header),
         h256{"0800000000000000000000000000000000000000000000000000000000000000"});
 }
+
+TEST(Ethash, epochContextsPrecomputeNextEpoch)
+{
+    EthashEpochContexts contexts;
+
+    auto const first = contexts.context(1);
+    EXPECT_EQ(first->epoch_number, 0);
+    EXPECT_EQ(contexts.context(2), first);
+    EXPECT_EQ(contexts.stats().blockingGenerations, 1u);
+
+    // Approaching the boundary starts building the next epoch in the background.
+    contexts.context(ethash::epoch_length - 1);
+    auto const second = contexts.context(ethash::epoch_length);
+    EXPECT_EQ(second->epoch_number, 1);
+
+    EpochContextStats const stats = contexts.stats();
+    EXPECT_EQ(stats.generations, 2u);
+    EXPECT_EQ(stats.blockingGenerations, 1u);
+    EXPECT_GT(stats.totalGenerationSeconds, 0);
+}
+
+TEST(Ethash, epochContextsKeepPreviousEpoch)
+{
+    EthashEpochContexts contexts;
+
+    auto const first = contexts.context(ethash::epoch_length - 1);
+    auto const second = contexts.context(ethash::epoch_length);
+
+    // Verifying blocks from both sides of the boundary in turn builds nothing more.
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(contexts.context(ethash::epoch_length - 2), first);
+        EXPECT_EQ(contexts.context(ethash::epoch_length + 1), second);
+    }
+    EXPECT_EQ(contexts.stats().generations, 2u);
+
+    // An older epoch is kept as the previous one, and the current one stays.
+    auto const zeroAgain = contexts.context(1);
+    EXPECT_EQ(zeroAgain, first);
+    EXPECT_EQ(contexts.context(ethash::epoch_length + 2), second);
+    EXPECT_EQ(contexts.stats().generations, 2u);
+}
+
+TEST(EthashCPUMiner, startNoncesSplitTheNonceSpace)
+{
+    h256 const headerHash{"0x2a3b4c5d6e7f8091a2b3c4d5e6f708192a3b4c5d6e7f8091a2b3c4d5e6f70819"};
+    for (unsigned instances : {1u, 2u, 3u, 7u, 64u})
+    {
+        uint64_t const first = cpuminer::startNonce(headerHash, 0, instances);
+        uint64_t const range = std::numeric_limits<uint64_t>::max() / instances;
+        for (unsigned i = 0; i < instances; ++i)
+        {
+            // Each miner has a range of its own before the next one's start, counting from the
+            // first miner's start and wrapping around.
+            uint64_t const offset = cpuminer::startNonce(headerHash, i, instances) - first;
+            uint64_t const next =
+                i + 1 < instances ? cpuminer::startNonce(headerHash, i + 1, instances) - first : 0;
+            EXPECT_EQ(offset, i * range);
+            EXPECT_GE(next - offset - 1, range - 1);
+        }
+    }
+    EXPECT_EQ(cpuminer::startNonce(headerHash, 0, 4), cpuminer::startNonce(headerHash, 0, 4));
+    EXPECT_NE(cpuminer::startNonce(headerHash, 0, 4), cpuminer::startNonce(h256{1}, 0, 4));
+}
+
+TEST(EthashCPUMiner, parseCpuList)
+{
+    using Cpus = std::vector<unsigned>;
+    EXPECT_EQ(cpuminer::parseCpuList("0-3,8,10-11"), (Cpus{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(cpuminer::parseCpuList("0-3,8,10-11\n"), (Cpus{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(cpuminer::parseCpuList("5"), (Cpus{5}));
+    EXPECT_EQ(cpuminer::parseCpuList(""), Cpus{});
+    EXPECT_EQ(cpuminer::parseCpuList("\n"), Cpus{});
+    // Malformed entries are skipped, the others kept.
+    EXPECT_EQ(cpuminer::parseCpuList("x,1,2-,-3,4-y,6-5,7-7,8--9,99999999999,-1,0x2"), (Cpus{1, 7}));
+}
+
+TEST(EthashCPUMiner, cpusAcrossNodesTakesOneFromEachNodeInTurn)
+{
+    using Cpus = std::vector<unsigned>;
+    EXPECT_EQ(cpuminer::cpusAcrossNodes({{0, 1, 2, 3}, {4, 5, 6, 7}}), (Cpus{0, 4, 1, 5, 2, 6, 3, 7}));
+    EXPECT_EQ(cpuminer::cpusAcrossNodes({{0, 1, 2}, {8}, {16, 17}}), (Cpus{0, 8, 16, 1, 17, 2}));
+    EXPECT_EQ(cpuminer::cpusAcrossNodes({{3, 1, 2}}), (Cpus{3, 1, 2}));
+    EXPECT_EQ(cpuminer::cpusAcrossNodes({}), Cpus{});
+}
+
+TEST(EthashCPUMiner, hashBatchCountsThePartialBatch)
+{
+    std::vector<unsigned> batches;
+    cpuminer::HashBatch hashes{[&](unsigned _n) { batches.push_back(_n); }};
+    for (unsigned i = 0; i < 2 * cpuminer::c_hashBatch + 7; ++i)
+        hashes.count();
+    EXPECT_EQ(batches, (std::vector<unsigned>{cpuminer::c_hashBatch, cpuminer::c_hashBatch}));
+
+    hashes.flush();
+    EXPECT_EQ(batches, (std::vector<unsigned>{cpuminer::c_hashBatch, cpuminer::c_hashBatch, 7}));
+
+    // Nothing is left to hand over after a flush.
+    hashes.flush();
+    EXPECT_EQ(batches.size(), 3u);
+}
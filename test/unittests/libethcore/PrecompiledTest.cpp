@@ -7,6 +7,8 @@
 #include <boost/test/unit_test.hpp>
 #include <test/tools/libtesteth/TestHelper.h>
 #include <libethcore/Precompiled.h>
+#include <libdevcrypto/ModExp.h>
+#include <random>
 
 using namespace std;
 using namespace dev;
@@ -324,6 +326,67 @@ BOOST_AUTO_TEST_CASE(modexpCostHighRange)
     BOOST_REQUIRE_MESSAGE(res == ((1025 * 1025 / 16 + 480 * 1025 - 199680) * 8) / 20, "Got: " + toString(res));
 }
 
+namespace
+{
+bytes randomBytes(mt19937& _gen, size_t _size)
+{
+    bytes ret(_size);
+    for (auto& b : ret)
+        b = static_cast<byte>(_gen());
+    return ret;
+}
+}
+
+BOOST_AUTO_TEST_CASE(modexpMontgomeryMatchesGeneric)
+{
+    mt19937 gen(42);
+    for (size_t modSize : {1, 2, 8, 31, 32, 33, 64, 65, 127, 128, 200, 256, 300, 511, 512})
+        for (unsigned i = 0; i < 12; ++i)
+        {
+            bytes mod = randomBytes(gen, modSize);
+            mod.back() |= 1;
+            // Leading zeroes, a base longer than the modulus and empty exponents are all included.
+            if (i % 4 == 1)
+                mod[0] = 0;
+            bytes const base = randomBytes(gen, gen() % (modSize + 8));
+            bytes const exp = randomBytes(gen, i % 3 == 0 ? i / 3 : gen() % 64);
+
+            bytes fast(modSize);
+            bytes generic(modSize);
+            crypto::modexpGeneric(&base, &exp, &mod, &generic);
+            if (crypto::modexpMontgomery(&base, &exp, &mod, &fast))
+                BOOST_REQUIRE_MESSAGE(fast == generic,
+                    "mod " + toHex(mod) + " base " + toHex(base) + " exp " + toHex(exp));
+        }
+}
+
+BOOST_AUTO_TEST_CASE(modexpMontgomeryEdgeCases)
+{
+    bytes const exp = fromHex("010001");
+    bytes result(3);
+
+    bytes const evenMod = fromHex("0f0f0e");
+    BOOST_CHECK(!crypto::modexpMontgomery(&exp, &exp, &evenMod, &result));
+    bytes const zeroMod = fromHex("000000");
+    BOOST_CHECK(!crypto::modexpMontgomery(&exp, &exp, &zeroMod, &result));
+
+    bytes const oneMod = fromHex("000001");
+    BOOST_REQUIRE(crypto::modexpMontgomery(&exp, &exp, &oneMod, &result));
+    BOOST_CHECK_EQUAL(toHex(result), "000000");
+
+    bytes const mod = fromHex("0f0f0f");
+    bytes const longBase(33, 0xff);
+    BOOST_CHECK(!crypto::modexpMontgomery(&longBase, &exp, &mod, &result));
+    crypto::modexp(&longBase, &exp, &mod, &result);
+    bytes expected(3);
+    crypto::modexpGeneric(&longBase, &exp, &mod, &expected);
+    BOOST_CHECK_EQUAL(toHex(result), toHex(expected));
+
+    bytes const zero;
+    BOOST_REQUIRE(crypto::modexpMontgomery(&mod, &zero, &mod, &result));
+    BOOST_CHECK_EQUAL(toHex(result), "000001");
+}
+
 /// @defgroup PrecompiledTests Test cases for precompiled contracts.
 ///
 /// These test cases are used for testing and benchmarking precompiled contracts.
@@ -718,6 +781,45 @@ BOOST_AUTO_TEST_CASE(bench_modexp, *ut::label("bench"))
     benchmarkPrecompiled("modexp", tests, 10000);
 }
 
+BOOST_AUTO_TEST_CASE(bench_modexpMontgomery, *ut::label("bench"))
+{
+    if (!Options::get().all)
+    {
+        std::cout << "Skipping benchmark test because --all option is not specified.\n";
+        return;
+    }
+
+    // Full-size exponents as in RSA signing and ZK verifiers, and e = 65537 as in RSA verification.
+    mt19937 gen(42);
+    for (size_t modSize : {32, 64, 128, 256, 384, 512})
+        for (bool fullExp : {false, true})
+        {
+            bytes mod = randomBytes(gen, modSize);
+            mod.back() |= 1;
+            bytes const base = randomBytes(gen, modSize);
+            bytes const exp = fullExp ? randomBytes(gen, modSize) : fromHex("010001");
+            bytes result(modSize);
+            int const n = fullExp ? 10 : 1000;
+
+            Timer timer;
+            for (int i = 0; i < n; ++i)
+                crypto::modexpGeneric(&base, &exp, &mod, &result);
+            auto const generic = timer.duration() / n;
+
+            timer.restart();
+            for (int i = 0; i < n; ++i)
+                crypto::modexpMontgomery(&base, &exp, &mod, &result);
+            auto const montgomery = timer.duration() / n;
+
+            std::cout << ut::framework::current_test_case().p_name << "/" << modSize * 8 << "bit"
+                      << (fullExp ? "" : "/e65537") << ": generic "
+                      << std::chrono::duration_cast<std::chrono::nanoseconds>(generic).count()
+                      << " ns, montgomery "
+                      << std::chrono::duration_cast<std::chrono::nanoseconds>(montgomery).count()
+                      << " ns\n";
+        }
+}
+
 BOOST_AUTO_TEST_CASE(bench_bn256Add, *ut::label("bench"))
 {
     vector_ref<const PrecompiledTest> tests{bn256AddTests, sizeof(bn256AddTests) / sizeof(bn256AddTests[0])};
@@ -223,6 +223,33 @@ BOOST_AUTO_TEST_CASE(bByzantiumBlockReward)
     BOOST_REQUIRE_EQUAL(topBlock.state().balance(topBlock.beneficiary()), 3 * ether);
 }
 
+BOOST_AUTO_TEST_CASE(bIntermediateStateRoots)
+{
+    TestBlockChain testBlockchain;
+    OverlayDB const& genesisDB = testBlockchain.testGenesis().state().db();
+    BlockChain const& blockchain = testBlockchain.getInterface();
+
+    TestBlock testBlock;
+    testBlock.addTransaction(TestTransaction::defaultTransaction(1));
+    testBlock.addTransaction(TestTransaction::defaultTransaction(2));
+    testBlock.mine(testBlockchain);
+    testBlockchain.addBlock(testBlock);
+
+    Block block = blockchain.genesisBlock(genesisDB);
+    block.populateFromChain(blockchain, testBlock.blockHeader().hash());
+    // Byzantium receipts have a status code instead of the state root.
+    BOOST_REQUIRE(!block.stateRootBeforeTx(1));
+
+    State state(State::Null);
+    h256s const roots = intermediateStateRoots(state, block, blockchain);
+    BOOST_REQUIRE_EQUAL(roots.size(), 2);
+    BOOST_CHECK_EQUAL(roots[0], block.stateRootBeforeTx(0));
+
+    Transaction const& first = block.pending()[0];
+    state.setRoot(roots[1]);
+    BOOST_CHECK_EQUAL(state.getNonce(first.sender()), first.nonce() + 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_FIXTURE_TEST_SUITE(ConstantinopleBlockSuite, ConstantinopleTestFixture)
@@ -0,0 +1,198 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Transaction packing tests.
+#include <libethashseal/GenesisInfo.h>
+#include <libethcore/SealEngine.h>
+#include <libethereum/BlockBuilder.h>
+#include <libethereum/ChainParams.h>
+#include <test/tools/libtesteth/TestHelper.h>
+#include <test/tools/libtestutils/TestLastBlockHashes.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::test;
+
+namespace
+{
+Address const c_dest{"0x095e7baea6a6c7c4c2dfeb977efac326af552d87"};
+Secret const c_sender1{"0x3333333333333333333333333333333333333333333333333333333333333333"};
+Secret const c_sender2{"0x4444444444444444444444444444444444444444444444444444444444444444"};
+Secret const c_sender3{"0x5555555555555555555555555555555555555555555555555555555555555555"};
+
+SimulatedTransaction simulated(
+    Secret const& _sender, u256 const& _nonce, u256 const& _gasPrice, u256 const& _gas, u256 const& _gasUsed)
+{
+    SimulatedTransaction sim;
+    sim.transaction = Transaction(0, _gasPrice, _gas, c_dest, bytes(), _nonce, _sender);
+    sim.valid = true;
+    sim.gasUsed = _gasUsed;
+    sim.modified = {sim.transaction.sender()};
+    return sim;
+}
+
+/// A state with funded senders and a contract, and transactions of several senders in nonce
+/// order, none of them touching an account another sender's transaction touches.
+class SimulationFixture : public TestOutputHelperFixture
+{
+public:
+    SimulationFixture()
+    {
+        header.setNumber(1);
+        header.setGasLimit(10000000);
+        header.setAuthor(Address{"0x00000000000000000000000000000000000000aa"});
+        for (auto const& sender : {c_sender1, c_sender2, c_sender3})
+            state.addBalance(toAddress(sender), ether);
+        // sstore(0, 42)
+        state.createContract(c_store);
+        state.setCode(c_store, fromHex("602a600055"), 0);
+        state.commit(State::CommitBehaviour::RemoveEmptyAccounts);
+
+        transactions = {Transaction(1, 10 * szabo, 25000, recipient(1), {}, 0, c_sender1),
+            Transaction(1, 30 * szabo, 25000, recipient(2), {}, 1, c_sender1),
+            Transaction(1, 20 * szabo, 25000, recipient(3), {}, 0, c_sender2),
+            Transaction(0, 15 * szabo, 100000, c_store, {}, 0, c_sender3),
+            Transaction(1, 5 * szabo, 25000, recipient(4), {}, 1, c_sender3)};
+    }
+
+    static Address recipient(unsigned _i) { return Address{sha3(toString(_i))}; }
+
+    /// Executes @a _transactions one after the other on a copy of the state.
+    /// @returns the gas used by each, and the final state root.
+    pair<vector<u256>, h256> executeSerially(Transactions const& _transactions) const
+    {
+        State s(state);
+        u256 gasUsed;
+        vector<u256> gas;
+        for (auto const& t : _transactions)
+        {
+            EnvInfo const envInfo{header, lastBlockHashes, gasUsed, se->chainParams().chainID};
+            u256 const cumulative = s.execute(envInfo, *se, t).second.cumulativeGasUsed();
+            gas.push_back(cumulative - gasUsed);
+            gasUsed = cumulative;
+        }
+        return {gas, s.rootHash()};
+    }
+
+    Address const c_store{"0x1000000000000000000000000000000000000001"};
+    unique_ptr<SealEngineFace> se{
+        ChainParams(genesisInfo(Network::IstanbulTest)).createSealEngine()};
+    BlockHeader header;
+    TestLastBlockHashes lastBlockHashes{h256s(256, h256())};
+    State state{0};
+    Transactions transactions;
+};
+}
+
+BOOST_FIXTURE_TEST_SUITE(BlockBuilderSuite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(packByGasPriceKeepsNonceOrder)
+{
+    SimulatedTransactions sims{simulated(c_sender1, 0, 10 * szabo, 25000, 21000),
+        simulated(c_sender1, 1, 30 * szabo, 25000, 21000),
+        simulated(c_sender2, 0, 20 * szabo, 25000, 21000)};
+
+    Transactions const packed = packTransactions(sims, 1000000);
+    BOOST_REQUIRE_EQUAL(packed.size(), 3);
+    BOOST_CHECK(packed[0].sha3() == sims[2].transaction.sha3());
+    BOOST_CHECK(packed[1].sha3() == sims[0].transaction.sha3());
+    BOOST_CHECK(packed[2].sha3() == sims[1].transaction.sha3());
+}
+
+BOOST_AUTO_TEST_CASE(packUsesSimulatedGas)
+{
+    // Gas limits add up to more than is left, but the gas actually used does not.
+    SimulatedTransactions sims{simulated(c_sender1, 0, 20 * szabo, 60000, 21000),
+        simulated(c_sender2, 0, 10 * szabo, 60000, 21000)};
+
+    Transactions const packed = packTransactions(sims, 100000);
+    BOOST_REQUIRE_EQUAL(packed.size(), 2);
+    BOOST_CHECK(packed[0].sha3() == sims[0].transaction.sha3());
+    BOOST_CHECK(packed[1].sha3() == sims[1].transaction.sha3());
+}
+
+BOOST_AUTO_TEST_CASE(packSkipsTransactionsThatDoNotFit)
+{
+    SimulatedTransactions sims{simulated(c_sender1, 0, 30 * szabo, 90000, 80000),
+        simulated(c_sender1, 1, 30 * szabo, 25000, 21000),
+        simulated(c_sender2, 0, 20 * szabo, 25000, 21000)};
+    sims[0].valid = false;
+
+    Transactions const packed = packTransactions(sims, 50000);
+    BOOST_REQUIRE_EQUAL(packed.size(), 3);
+    // Invalid transactions and their dependents come last, in their original order.
+    BOOST_CHECK(packed[0].sha3() == sims[2].transaction.sha3());
+    BOOST_CHECK(packed[1].sha3() == sims[0].transaction.sha3());
+    BOOST_CHECK(packed[2].sha3() == sims[1].transaction.sha3());
+}
+
+BOOST_AUTO_TEST_CASE(packBudgetsConflictsAtGasLimit)
+{
+    SimulatedTransactions sims{simulated(c_sender2, 0, 20 * szabo, 50000, 21000),
+        simulated(c_sender2, 1, 10 * szabo, 25000, 21000),
+        simulated(c_sender1, 0, 30 * szabo, 25000, 21000),
+        simulated(c_sender3, 0, 5 * szabo, 19000, 19000)};
+    // The first transaction touches the account of the third one's sender, so its gas limit is
+    // budgeted in full and 90000 - 21000 - 50000 leaves room only for the cheapest one.
+    sims[0].modified.insert(sims[2].transaction.sender());
+
+    Transactions const packed = packTransactions(sims, 90000);
+    BOOST_REQUIRE_EQUAL(packed.size(), 4);
+    BOOST_CHECK(packed[0].sha3() == sims[2].transaction.sha3());
+    BOOST_CHECK(packed[1].sha3() == sims[0].transaction.sha3());
+    BOOST_CHECK(packed[2].sha3() == sims[3].transaction.sha3());
+    BOOST_CHECK(packed[3].sha3() == sims[1].transaction.sha3());
+}
+
+BOOST_FIXTURE_TEST_CASE(simulationMatchesSerialExecution, SimulationFixture)
+{
+    BlockBuilder const parallel{state, header, lastBlockHashes, *se, 4};
+    BlockBuilder const serial{state, header, lastBlockHashes, *se, 1};
+    SimulatedTransactions const sims = parallel.simulate(transactions);
+    SimulatedTransactions const serialSims = serial.simulate(transactions);
+    BOOST_REQUIRE_EQUAL(sims.size(), transactions.size());
+    for (size_t i = 0; i < sims.size(); ++i)
+    {
+        BOOST_CHECK(sims[i].valid);
+        BOOST_CHECK_EQUAL(sims[i].valid, serialSims[i].valid);
+        BOOST_CHECK_EQUAL(sims[i].gasUsed, serialSims[i].gasUsed);
+        BOOST_CHECK(sims[i].modified == serialSims[i].modified);
+    }
+
+    // Packed by gas price, the block uses the simulated gas of every transaction and ends in the
+    // state of the transactions run in their original order.
+    Transactions const packed = packTransactions(sims, header.gasLimit());
+    BOOST_REQUIRE_EQUAL(packed.size(), transactions.size());
+    auto const packedRun = executeSerially(packed);
+    for (size_t i = 0; i < packed.size(); ++i)
+    {
+        size_t const original = find_if(transactions.begin(), transactions.end(),
+                                    [&](Transaction const& _t) {
+                                        return _t.sha3() == packed[i].sha3();
+                                    }) -
+                                transactions.begin();
+        BOOST_CHECK_EQUAL(packedRun.first[i], sims[original].gasUsed);
+    }
+    BOOST_CHECK_EQUAL(packedRun.second, executeSerially(transactions).second);
+}
+
+BOOST_FIXTURE_TEST_CASE(simulationStopsAtDeadline, SimulationFixture)
+{
+    BlockBuilder const builder{state, header, lastBlockHashes, *se, 4};
+    SimulatedTransactions const sims =
+        builder.simulate(transactions, chrono::steady_clock::now() - chrono::seconds(1));
+    BOOST_REQUIRE_EQUAL(sims.size(), transactions.size());
+    for (auto const& sim : sims)
+        BOOST_CHECK(!sim.valid);
+
+    // Nothing simulated is packed, so the transactions keep their original order.
+    Transactions const packed = packTransactions(sims, header.gasLimit());
+    BOOST_REQUIRE_EQUAL(packed.size(), transactions.size());
+    for (size_t i = 0; i < packed.size(); ++i)
+        BOOST_CHECK(packed[i].sha3() == transactions[i].sha3());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
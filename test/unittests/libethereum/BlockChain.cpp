@@ -6,6 +6,8 @@
 /// Blockchain test functions.
 #include <libethereum/Block.h>
 #include <libethereum/BlockChain.h>
+#include <libethereum/ChainDataCompression.h>
+#include <libethereum/DatabasePaths.h>
 #include <libdevcore/DBFactory.h>
 #include <test/tools/libtesteth/TestHelper.h>
 #include <test/tools/libtesteth/BlockChainHelper.h>
@@ -192,6 +194,135 @@ BOOST_AUTO_TEST_CASE(insertWithoutParent)
 }
 
 
+BOOST_AUTO_TEST_CASE(lastBlockHashesFollowReorg)
+{
+    TestBlockChain bc(TestBlockChain::defaultGenesisBlock());
+    TestBlockChain fork(TestBlockChain::defaultGenesisBlock());
+    BlockChain const& chain = bc.getInterface();
+
+    auto const checkHashes = [&chain](h256 const& _head) {
+        h256s const hashes = chain.lastBlockHashes().precedingHashes(_head);
+        BOOST_REQUIRE_EQUAL(hashes.size(), 256u);
+        h256 expected = _head;
+        for (unsigned i = 0; i < hashes.size(); ++i)
+        {
+            BOOST_CHECK_EQUAL(hashes[i], expected);
+            BOOST_CHECK_EQUAL(chain.lastBlockHashes().precedingHash(_head, i), expected);
+            expected = expected ? chain.details(expected).parentHash : h256();
+        }
+    };
+
+    for (unsigned i = 0; i < 2; ++i)
+    {
+        TestBlock block;
+        block.mine(bc);
+        bc.addBlock(block);
+        checkHashes(chain.currentHash());
+    }
+    h256 const oldHead = chain.currentHash();
+
+    // A longer fork replaces both blocks.
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        TestBlock block;
+        if (i == 0)
+            block.addTransaction(TestTransaction::defaultTransaction(1));
+        block.mine(fork);
+        fork.addBlock(block);
+        bc.addBlock(block);
+    }
+    BOOST_REQUIRE_EQUAL(chain.number(), 3u);
+    BOOST_REQUIRE(chain.currentHash() == fork.getInterface().currentHash());
+    checkHashes(chain.currentHash());
+    checkHashes(oldHead);
+    checkHashes(chain.currentHash());
+}
+
+// Bodies and receipts are compressed in the database, so it is disk-backed to look at them.
+BOOST_AUTO_TEST_CASE(compressedChainData)
+{
+    auto const preDatabaseKind = databaseKind();
+    setDatabaseKind(DatabaseKind::LevelDB);
+    bool const preCompression = chainDataCompression();
+
+    TestBlockChain testBc(TestBlockChain::defaultGenesisBlock());
+    vector<TestBlock> blocks;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        TestBlock block;
+        block.addTransaction(TestTransaction::defaultTransaction(i + 1));
+        block.mine(testBc);
+        testBc.addBlock(block);
+        blocks.push_back(block);
+    }
+    BlockChain const& reference = testBc.getInterface();
+
+    TransientDirectory tempDirBlockchain;
+    ChainParams const& params = reference.chainParams();
+    OverlayDB const& stateDB = testBc.testGenesis().state().db();
+    auto const checkChain = [&](BlockChain const& _bc) {
+        BOOST_REQUIRE_EQUAL(_bc.number(), blocks.size());
+        for (unsigned n = 1; n <= blocks.size(); ++n)
+        {
+            h256 const hash = reference.numberHash(n);
+            BOOST_CHECK(_bc.block(hash) == blocks[n - 1].bytes());
+            BOOST_CHECK(_bc.headerData(hash) == reference.headerData(hash));
+            BOOST_CHECK(_bc.receipts(hash).rlp() == reference.receipts(hash).rlp());
+            BOOST_CHECK_EQUAL(_bc.blockBloom(n), reference.blockBloom(n));
+        }
+    };
+    // @returns how many of the stored bodies and receipts are compressed.
+    auto const countCompressed = [&]() {
+        DatabasePaths const paths(tempDirBlockchain.path(), reference.genesisHash());
+        auto const blocksDB = db::DBFactory::create(DatabaseKind::LevelDB, paths.blocksPath());
+        auto const extrasDB = db::DBFactory::create(DatabaseKind::LevelDB, paths.extrasPath());
+        unsigned ret = 0;
+        for (unsigned n = 1; n <= blocks.size(); ++n)
+        {
+            h256 const hash = reference.numberHash(n);
+            ret += isCompressedChainData(blocksDB->lookup(toSlice(hash)));
+            ret += isCompressedChainData(extrasDB->lookup(toSlice(hash, ExtraReceipts)));
+        }
+        return ret;
+    };
+
+    // Half of the chain is written in each form.
+    {
+        BlockChain bc(params, tempDirBlockchain.path(), WithExisting::Kill);
+        for (unsigned i = 0; i < blocks.size(); ++i)
+        {
+            setChainDataCompression(i >= blocks.size() / 2);
+            bc.import(blocks[i].bytes(), stateDB);
+        }
+        checkChain(bc);
+    }
+    BOOST_CHECK_EQUAL(countCompressed(), blocks.size());
+    {
+        // Read back from the database, not from the caches.
+        BlockChain bc(params, tempDirBlockchain.path(), WithExisting::Trust);
+        checkChain(bc);
+
+        setChainDataCompression(true);
+        bc.recompressChainData();
+    }
+    BOOST_CHECK_EQUAL(countCompressed(), 2 * blocks.size());
+    {
+        BlockChain bc(params, tempDirBlockchain.path(), WithExisting::Trust);
+        checkChain(bc);
+
+        setChainDataCompression(false);
+        bc.recompressChainData();
+    }
+    BOOST_CHECK_EQUAL(countCompressed(), 0);
+    {
+        BlockChain bc(params, tempDirBlockchain.path(), WithExisting::Trust);
+        checkChain(bc);
+    }
+
+    setChainDataCompression(preCompression);
+    setDatabaseKind(preDatabaseKind);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_FIXTURE_TEST_SUITE(BlockChainMainNetworkSuite, MainNetworkNoProofTestFixture)
@@ -375,8 +506,8 @@ BOOST_AUTO_TEST_CASE(updateStats)
     BOOST_CHECK_EQUAL(stat.memDetails, memDetailsExpected);
     totalExpected += memDetailsExpected;
 
-    unsigned const memLogBloomsExpected =
-        bcRef.blocksBlooms(0, 0).size + 64 + bcRef.blocksBlooms(1, 0).size + 64;
+    // Blooms of the genesis and the new block, kept until their section of the index is complete.
+    unsigned const memLogBloomsExpected = 2 * sizeof(LogBloom);
     BOOST_CHECK_EQUAL(stat.memLogBlooms, memLogBloomsExpected);
     totalExpected += memLogBloomsExpected;
 
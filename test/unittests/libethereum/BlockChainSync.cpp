@@ -0,0 +1,54 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Body request sizing and straggler tests.
+#include <libethereum/BlockChainSync.h>
+
+#include <gtest/gtest.h>
+
+using namespace dev;
+using namespace dev::eth;
+
+TEST(BlockChainSync, bodyRequestSizeWithoutHistory)
+{
+    EXPECT_EQ(bodyRequestSize(0), 128u);
+}
+
+TEST(BlockChainSync, bodyRequestSizeFollowsThroughput)
+{
+    // Two seconds worth of bodies.
+    EXPECT_EQ(bodyRequestSize(50), 100u);
+    EXPECT_EQ(bodyRequestSize(300), 600u);
+}
+
+TEST(BlockChainSync, bodyRequestSizeLimits)
+{
+    EXPECT_EQ(bodyRequestSize(0.5), 16u);
+    EXPECT_EQ(bodyRequestSize(8), 16u);
+    EXPECT_EQ(bodyRequestSize(512), 1024u);
+    EXPECT_EQ(bodyRequestSize(100000), 1024u);
+}
+
+TEST(BlockChainSync, stragglerOnlyOnceOverdue)
+{
+    // 100 bodies at 50/s are expected in 2 s, and overdue at twice that.
+    EXPECT_FALSE(isStraggler(3.9, 100, 50, 500));
+    EXPECT_TRUE(isStraggler(4.0, 100, 50, 500));
+    // Never before three seconds, however small the request.
+    EXPECT_FALSE(isStraggler(2.9, 10, 50, 500));
+    EXPECT_TRUE(isStraggler(3.0, 10, 50, 500));
+    // Without a measured throughput, the owner is given twice the target response time.
+    EXPECT_FALSE(isStraggler(3.9, 100, 0, 500));
+    EXPECT_TRUE(isStraggler(4.0, 100, 0, 500));
+}
+
+TEST(BlockChainSync, stragglerOnlyForFasterPeer)
+{
+    EXPECT_TRUE(isStraggler(60, 100, 50, 51));
+    EXPECT_FALSE(isStraggler(60, 100, 50, 50));
+    EXPECT_FALSE(isStraggler(60, 100, 50, 10));
+    // A peer that hasn't delivered anything yet is not known to be faster.
+    EXPECT_FALSE(isStraggler(60, 100, 0, 0));
+}
@@ -0,0 +1,149 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Bit-sliced log bloom index unit tests.
+#include <libdevcore/MemoryDB.h>
+#include <libdevcore/SHA3.h>
+#include <libethereum/BlockChain.h>
+#include <libethereum/BloomBitsIndex.h>
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+unsigned const c_sectionSize = BloomBitsIndex::c_sectionSize;
+
+LogBloom keyBloom(unsigned _key)
+{
+    return LogBloom{}.shiftBloom<3>(sha3(h256(_key)));
+}
+
+/// Blooms of a chain where key 0 is in every block, key 1 in every third one and the others in few.
+vector<LogBloom> chain(unsigned _size)
+{
+    vector<LogBloom> ret;
+    for (unsigned n = 0; n < _size; ++n)
+    {
+        LogBloom bloom = keyBloom(0);
+        if (n % 3 == 0)
+            bloom |= keyBloom(1);
+        if (n % 97 == 5)
+            bloom |= keyBloom(2 + n % 4);
+        ret.push_back(bloom);
+    }
+    return ret;
+}
+
+vector<unsigned> scan(
+    vector<LogBloom> const& _chain, LogBlooms const& _blooms, unsigned _earliest, unsigned _latest)
+{
+    vector<unsigned> ret;
+    for (unsigned n = _earliest; n <= _latest && n < _chain.size(); ++n)
+        for (LogBloom const& bloom : _blooms)
+            if (_chain[n].contains(bloom))
+            {
+                ret.push_back(n);
+                break;
+            }
+    return ret;
+}
+
+class BloomBitsIndexTest : public testing::Test
+{
+protected:
+    void open(unsigned _head)
+    {
+        index.open(db, _head, [this](unsigned _number) { return blooms.at(_number); });
+    }
+
+    void append(unsigned _from)
+    {
+        auto batch = db.createWriteBatch();
+        for (unsigned n = _from; n < blooms.size(); ++n)
+            index.append(n, blooms[n], *batch);
+        db.commit(move(batch));
+    }
+
+    void expectMatchesScan()
+    {
+        ASSERT_EQ(index.size(), blooms.size());
+        vector<LogBlooms> const queries{{keyBloom(0)}, {keyBloom(1)}, {keyBloom(2)},
+            {keyBloom(3), keyBloom(4)}, {keyBloom(1) | keyBloom(5)}, {keyBloom(6)}, {LogBloom{}}};
+        vector<pair<unsigned, unsigned>> const ranges{{0, 100000}, {1, 2},
+            {c_sectionSize - 10, c_sectionSize + 10}, {c_sectionSize, 2 * c_sectionSize - 1},
+            {5, 3 * c_sectionSize + 7}, {2 * c_sectionSize + 3, 2 * c_sectionSize + 3}};
+        for (auto const& query : queries)
+            for (auto const& range : ranges)
+                EXPECT_EQ(index.matching(query, range.first, range.second),
+                    scan(blooms, query, range.first, range.second))
+                    << "range " << range.first << " - " << range.second;
+    }
+
+    db::MemoryDB db;
+    BloomBitsIndex index{ExtraBloomBits};
+    vector<LogBloom> blooms = chain(3 * c_sectionSize + 100);
+};
+}  // namespace
+
+TEST_F(BloomBitsIndexTest, matchesScan)
+{
+    open(0);
+    append(1);
+    expectMatchesScan();
+}
+
+TEST_F(BloomBitsIndexTest, reopen)
+{
+    open(0);
+    append(1);
+    index.close();
+    EXPECT_TRUE(index.matching({keyBloom(0)}, 0, 100).empty());
+
+    open(blooms.size() - 1);
+    expectMatchesScan();
+
+    // The head went back to a complete section, which is indexed again from the blooms.
+    blooms.resize(2 * c_sectionSize - 1);
+    open(blooms.size() - 1);
+    expectMatchesScan();
+}
+
+TEST_F(BloomBitsIndexTest, indexesMissingSections)
+{
+    open(blooms.size() - 1);
+    expectMatchesScan();
+}
+
+TEST_F(BloomBitsIndexTest, rewind)
+{
+    open(0);
+    append(1);
+
+    index.rewind(c_sectionSize + 50, [this](unsigned _number) { return blooms.at(_number); });
+    vector<LogBloom> const replaced = chain(blooms.size());
+    blooms.resize(c_sectionSize + 50);
+    expectMatchesScan();
+
+    for (unsigned n = c_sectionSize + 50; n < replaced.size(); ++n)
+        blooms.push_back(replaced[n] | keyBloom(7));
+    append(c_sectionSize + 50);
+    expectMatchesScan();
+    EXPECT_EQ(index.matching({keyBloom(7)}, 0, 100000).front(), c_sectionSize + 50);
+}
+
+TEST_F(BloomBitsIndexTest, gapsHaveEmptyBlooms)
+{
+    open(0);
+    auto batch = db.createWriteBatch();
+    index.append(2 * c_sectionSize + 10, keyBloom(1), *batch);
+    db.commit(move(batch));
+    blooms.assign(2 * c_sectionSize + 11, LogBloom{});
+    blooms[0] = chain(1)[0];
+    blooms.back() = keyBloom(1);
+    expectMatchesScan();
+}
@@ -0,0 +1,57 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Stored block body and receipts compression unit tests.
+#include <libdevcore/RLP.h>
+#include <libethereum/ChainDataCompression.h>
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+bytes receiptsLike()
+{
+    RLPStream s(100);
+    for (unsigned i = 0; i < 100; ++i)
+        s.appendList(4) << 1 << u256(21000 * (i + 1)) << bytes(256, 0) << bytes(64, byte(i % 3));
+    return s.out();
+}
+}  // namespace
+
+TEST(ChainDataCompression, roundTrip)
+{
+    bytes const rlp = receiptsLike();
+    string stored = compressChainData(&rlp);
+    EXPECT_TRUE(isCompressedChainData(stored));
+    EXPECT_LT(stored.size(), rlp.size() / 4);
+
+    uncompressChainData(stored);
+    EXPECT_EQ(stored, asString(rlp));
+}
+
+TEST(ChainDataCompression, uncompressedValuesAreLeftAsTheyAre)
+{
+    bytes const rlp = receiptsLike();
+    string stored = asString(rlp);
+    EXPECT_FALSE(isCompressedChainData(stored));
+    uncompressChainData(stored);
+    EXPECT_EQ(stored, asString(rlp));
+
+    string empty;
+    EXPECT_FALSE(isCompressedChainData(empty));
+    uncompressChainData(empty);
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST(ChainDataCompression, corruptValueThrows)
+{
+    bytes const rlp = receiptsLike();
+    string stored = compressChainData(&rlp);
+    stored.resize(stored.size() / 2);
+    EXPECT_THROW(uncompressChainData(stored), FailedToUncompressChainData);
+}
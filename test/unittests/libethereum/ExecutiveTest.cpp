@@ -8,6 +8,7 @@
 #include <libethereum/Executive.h>
 #include <libethereum/ExtVM.h>
 #include <libethereum/State.h>
+#include <libevm/VMProfiler.h>
 #include <test/tools/libtestutils/TestLastBlockHashes.h>
 #include <gtest/gtest.h>
 
@@ -140,3 +141,56 @@ TEST_F(ExecutiveTest, createdContractHasParentVersion)
     EXPECT_TRUE(state.addressHasCode(executive.newAddress()));
     EXPECT_EQ(state.version(executive.newAddress()), version);
 }
+
+TEST_F(ExecutiveTest, profilerRecordsOperations)
+{
+    // mstore(0, 0x60)
+    bytes const profiledCode = fromHex("606060005200");
+    state.createContract(receiveAddress);
+    state.setCode(receiveAddress, bytes{profiledCode}, 0);
+    state.commit(State::CommitBehaviour::RemoveEmptyAccounts);
+
+    VMProfiler::profile(true);
+    VMProfiler::setEnabled(true);
+    Executive executive(state, envInfo(), ethash);
+    EXPECT_FALSE(executive.call(receiveAddress, txSender, txValue, gasPrice, txData, gas));
+    EXPECT_TRUE(executive.go());
+    VMProfiler::setEnabled(false);
+
+    VMProfile const profile = VMProfiler::profile(true);
+    EXPECT_EQ(profile.executions, 1);
+    EXPECT_EQ(profile.opcodes[uint8_t(Instruction::PUSH1)].count, 2);
+    EXPECT_EQ(profile.opcodes[uint8_t(Instruction::PUSH1)].gas, 6);
+    EXPECT_EQ(profile.opcodes[uint8_t(Instruction::MSTORE)].count, 1);
+    // Including the expansion of the memory to one word.
+    EXPECT_EQ(profile.opcodes[uint8_t(Instruction::MSTORE)].gas, 6);
+    EXPECT_EQ(profile.opcodes[uint8_t(Instruction::STOP)].count, 1);
+
+    ASSERT_EQ(profile.contracts.size(), 1);
+    OperationProfile const& contract = profile.contracts.at(sha3(profiledCode));
+    EXPECT_EQ(contract.count, 4);
+    EXPECT_EQ(contract.gas, 12);
+    ASSERT_EQ(profile.depths.size(), 1);
+    EXPECT_EQ(profile.depths[0].count, 4);
+}
+
+TEST_F(ExecutiveTest, profilerCountsFailingOperationOnce)
+{
+    // returndatacopy(0, 0, 1) with no return data fails after it has been reported.
+    bytes const profiledCode = fromHex("6001600060003e");
+    state.createContract(receiveAddress);
+    state.setCode(receiveAddress, bytes{profiledCode}, 0);
+    state.commit(State::CommitBehaviour::RemoveEmptyAccounts);
+
+    VMProfiler::profile(true);
+    VMProfiler::setEnabled(true);
+    Executive executive(state, envInfo(), ethash);
+    EXPECT_FALSE(executive.call(receiveAddress, txSender, txValue, gasPrice, txData, gas));
+    executive.go();
+    VMProfiler::setEnabled(false);
+
+    VMProfile const profile = VMProfiler::profile(true);
+    EXPECT_EQ(profile.opcodes[uint8_t(Instruction::PUSH1)].count, 3);
+    EXPECT_EQ(profile.opcodes[uint8_t(Instruction::RETURNDATACOPY)].count, 1);
+    EXPECT_EQ(profile.contracts.at(sha3(profiledCode)).count, 4);
+}
@@ -0,0 +1,100 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Log filter index unit tests.
+#include <gtest/gtest.h>
+#include <libethereum/LogFilterIndex.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+namespace
+{
+map<h256, LogFilter> filters()
+{
+    map<h256, LogFilter> ret;
+    auto const add = [&](LogFilter const& _filter) { ret[_filter.sha3()] = _filter; };
+    add(LogFilter{});
+    add(LogFilter{}.address(Address{1}));
+    add(LogFilter{}.address(Address{1}).address(Address{2}).topic(0, h256{10}));
+    add(LogFilter{}.topic(0, h256{10}));
+    add(LogFilter{}.topic(1, h256{11}).topic(1, h256{12}));
+    add(LogFilter{}.topic(1, h256{11}).topic(2, h256{13}));
+    add(LogFilter{}.address(Address{3}).topic(3, h256{14}));
+    return ret;
+}
+
+LogEntries logs()
+{
+    LogEntries ret;
+    for (unsigned address = 0; address < 4; ++address)
+        for (h256s const& topics : {h256s{}, h256s{h256{10}}, h256s{h256{10}, h256{11}},
+                 h256s{h256{1}, h256{12}, h256{13}}, h256s{h256{11}, h256{11}, h256{13}, h256{14}}})
+            ret.push_back(LogEntry{Address{address}, topics, bytes{}});
+    return ret;
+}
+
+set<h256> candidateMatches(
+    LogFilterIndex const& _index, map<h256, LogFilter> const& _filters, LogEntry const& _log)
+{
+    set<h256> candidates;
+    set<h256> ret;
+    _index.forEachCandidate(_log, [&](h256 const& _id) {
+        EXPECT_TRUE(candidates.insert(_id).second) << "candidate given twice";
+        if (_filters.at(_id).matches(_log))
+            ret.insert(_id);
+    });
+    return ret;
+}
+}  // namespace
+
+TEST(LogFilterIndex, findsEveryMatchingFilter)
+{
+    map<h256, LogFilter> const all = filters();
+    LogFilterIndex index;
+    for (auto const& filter : all)
+        index.insert(filter.first, filter.second);
+
+    for (LogEntry const& log : logs())
+    {
+        set<h256> expected;
+        for (auto const& filter : all)
+            if (filter.second.matches(log))
+                expected.insert(filter.first);
+        EXPECT_EQ(candidateMatches(index, all, log), expected);
+    }
+}
+
+TEST(LogFilterIndex, erase)
+{
+    map<h256, LogFilter> const all = filters();
+    LogFilterIndex index;
+    EXPECT_TRUE(index.empty());
+    for (auto const& filter : all)
+        index.insert(filter.first, filter.second);
+    for (auto const& filter : all)
+        index.erase(filter.first, filter.second);
+    EXPECT_TRUE(index.empty());
+
+    for (LogEntry const& log : logs())
+        index.forEachCandidate(log, [](h256 const&) { ADD_FAILURE(); });
+}
+
+TEST(LogFilterIndex, mayMatch)
+{
+    LogFilterIndex index;
+    LogFilter const filter = LogFilter{}.address(Address{1});
+    index.insert(filter.sha3(), filter);
+
+    LogBloom bloom;
+    EXPECT_FALSE(index.mayMatch(bloom));
+    EXPECT_FALSE(index.mayMatch(LogEntry{Address{2}, {h256{1}}, bytes{}}.bloom()));
+    EXPECT_TRUE(index.mayMatch(LogEntry{Address{1}, {}, bytes{}}.bloom()));
+
+    LogFilter const everything;
+    index.insert(everything.sha3(), everything);
+    EXPECT_TRUE(index.mayMatch(bloom));
+}
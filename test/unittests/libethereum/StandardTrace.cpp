@@ -0,0 +1,152 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// Standard trace unit tests.
+#include <libethashseal/Ethash.h>
+#include <libethashseal/GenesisInfo.h>
+#include <libethereum/ChainParams.h>
+#include <libethereum/Executive.h>
+#include <libethereum/StandardTrace.h>
+#include <libethereum/State.h>
+#include <test/tools/libtestutils/TestLastBlockHashes.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::test;
+
+namespace
+{
+class StandardTraceTest : public testing::Test
+{
+protected:
+    StandardTraceTest()
+    {
+        ethash.setChainParams(ChainParams{genesisInfo(eth::Network::IstanbulTransitionTest)});
+        state.createContract(contract);
+        state.setCode(contract, bytes{code}, 0);
+        state.commit(State::CommitBehaviour::RemoveEmptyAccounts);
+    }
+
+    /// Runs the contract on a copy of the state, so that every run starts from empty storage.
+    void run(StandardTrace& _trace)
+    {
+        State s(state);
+        EnvInfo const envInfo{blockHeader, lastBlockHashes, 0, ethash.chainParams().chainID};
+        Executive executive(s, envInfo, ethash);
+        ASSERT_FALSE(executive.call(contract, sender, 0, 0, bytesConstRef{}, 1000000));
+        // LegacyVM reports a step before charging its memory expansion, so one is made up here
+        // to have it in the output.
+        OnOpFunc const traceOp = _trace.onOp();
+        auto const onOp = [&](uint64_t _steps, uint64_t _pc, Instruction _inst,
+                              bigint _newMemSize, bigint _gasCost, bigint _gas, VMFace const* _vm,
+                              ExtVMFace const* _ext) {
+            traceOp(_steps, _pc, _inst, _inst == Instruction::MSTORE ? 1 : _newMemSize, _gasCost,
+                _gas, _vm, _ext);
+        };
+        ASSERT_TRUE(executive.go(onOp));
+    }
+
+    /// Checks that a trace written to a stream is what Json::FastWriter makes of the same trace
+    /// built as JSON values.
+    void expectSameOutput(StandardTrace::DebugOptions _options)
+    {
+        Json::Value built{Json::arrayValue};
+        StandardTrace toValue{built};
+        toValue.setShowMnemonics();
+        toValue.setOptions(_options);
+        run(toValue);
+
+        ostringstream written;
+        StandardTrace toStream{written};
+        toStream.setShowMnemonics();
+        toStream.setOptions(_options);
+        run(toStream);
+
+        vector<string> lines;
+        istringstream in(written.str());
+        for (string line; getline(in, line);)
+            lines.push_back(line);
+        ASSERT_EQ(lines.size(), built.size());
+
+        Json::FastWriter writer;
+        for (unsigned i = 0; i < lines.size(); ++i)
+        {
+            Json::Value const& step = built[i];
+            string const expected = writer.write(step);
+            // Storage keys are written in the order of the state, FastWriter sorts them, so
+            // steps with several keys are compared once parsed and written again.
+            Json::Value parsed;
+            ASSERT_TRUE(Json::Reader().parse(lines[i], parsed)) << lines[i];
+            EXPECT_EQ(writer.write(parsed), expected);
+            if (step["storage"].size() < 2)
+            {
+                EXPECT_EQ(lines[i] + "\n", expected);
+            }
+        }
+    }
+
+    Ethash ethash;
+    BlockHeader blockHeader;
+    TestLastBlockHashes lastBlockHashes{{}};
+    State state{0};
+
+    Address contract{"0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b"};
+    Address sender{"0xaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"};
+    // mstore(0, 0x60)
+    // sstore(0, 1)
+    // sstore(1, 2)
+    // sstore(2, 3)
+    // mload(0)
+    bytes code = fromHex("606060005260016000556002600155600360025560005100");
+};
+}  // namespace
+
+TEST_F(StandardTraceTest, writesWhatFastWriterWrites)
+{
+    expectSameOutput({});
+}
+
+TEST_F(StandardTraceTest, writesWhatFastWriterWritesWithFullStorage)
+{
+    StandardTrace::DebugOptions options;
+    options.fullStorage = true;
+    expectSameOutput(options);
+}
+
+TEST_F(StandardTraceTest, writesWhatFastWriterWritesWithoutStackMemoryAndStorage)
+{
+    StandardTrace::DebugOptions options;
+    options.disableStack = true;
+    options.disableMemory = true;
+    options.disableStorage = true;
+    expectSameOutput(options);
+}
+
+TEST_F(StandardTraceTest, traceHasAllFields)
+{
+    Json::Value built{Json::arrayValue};
+    StandardTrace st{built};
+    st.setShowMnemonics();
+    run(st);
+
+    Json::Value const& trace = built;
+    ASSERT_EQ(trace.size(), 15u);
+    Json::Value const& mstore = trace[2];
+    EXPECT_EQ(mstore["opName"].asString(), "MSTORE");
+    EXPECT_EQ(mstore["memexpand"].asString(), "1");
+    EXPECT_EQ(mstore["stack"].size(), 2u);
+    EXPECT_EQ(trace[3]["memory"].size(), 1u);
+    EXPECT_EQ(trace[3]["memSize"].asUInt(), 32u);
+    // Storage is shown when a context starts and after each SSTORE.
+    EXPECT_TRUE(trace[0]["storage"].isObject());
+    EXPECT_EQ(trace[0]["storage"].size(), 0u);
+    EXPECT_FALSE(trace[1].isMember("storage"));
+    EXPECT_EQ(trace[12]["storage"].size(), 3u);
+    EXPECT_EQ(trace[14]["opName"].asString(), "STOP");
+}
@@ -0,0 +1,221 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+
+/// @file
+/// State trie download tests.
+#include <libdevcore/MemoryDB.h>
+#include <libdevcore/TrieDB.h>
+#include <libethereum/StateDownloader.h>
+#include <libethereum/StateImporter.h>
+#include <test/tools/libtesteth/TestHelper.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::test;
+
+namespace
+{
+p2p::NodeID const c_peer{1};
+
+OverlayDB newDB()
+{
+    return OverlayDB(unique_ptr<db::DatabaseFace>(new db::MemoryDB));
+}
+
+/// Fill @a _db with accounts having storage and code. @returns the state root.
+h256 createState(OverlayDB& _db, unsigned _accounts)
+{
+    auto importer = createStateImporter(_db);
+    for (unsigned i = 0; i < _accounts; ++i)
+    {
+        map<h256, bytes> storage;
+        for (unsigned j = 0; j < i % 5; ++j)
+            storage[sha3(h256(j))] = rlp(i * 100 + j);
+        bytes const code = h256(i).asBytes();
+        h256 const codeHash = i % 3 ? importer->importCode(&code) : EmptySHA3;
+        importer->importAccount(sha3(h256(i)), i, i * 1000, storage, codeHash);
+    }
+    importer->commitStateDatabase();
+    return importer->stateRoot();
+}
+
+/// Answer the downloader's requests from @a _source, leaving out every @a _skip-th node.
+void serve(StateDownloader& _downloader, OverlayDB const& _source, unsigned _skip = 0)
+{
+    for (unsigned round = 0; !_downloader.isComplete(); ++round)
+    {
+        BOOST_REQUIRE_LT(round, 1000u);
+        h256s const hashes = _downloader.requestNodes(c_peer, 16);
+        BOOST_REQUIRE(!hashes.empty());
+
+        RLPStream s;
+        s.appendList(hashes.size() - (_skip ? hashes.size() / _skip : 0));
+        for (size_t i = 0; i < hashes.size(); ++i)
+            if (!_skip || i % _skip != _skip - 1)
+                s << _source.lookup(hashes[i]);
+        _downloader.onNodeData(c_peer, RLP(s.out()));
+    }
+}
+
+void checkState(OverlayDB& _db, OverlayDB& _source, h256 const& _root, unsigned _accounts)
+{
+    SpecificTrieDB<GenericTrieDB<OverlayDB>, h256> source(&_source, _root);
+    SpecificTrieDB<GenericTrieDB<OverlayDB>, h256> downloaded(&_db, _root);
+    for (unsigned i = 0; i < _accounts; ++i)
+    {
+        h256 const key = sha3(h256(i));
+        string const account = downloaded.at(key);
+        BOOST_REQUIRE_EQUAL(account, source.at(key));
+
+        RLP const accountRlp(account);
+        SpecificTrieDB<GenericTrieDB<OverlayDB>, h256> storage(&_db, accountRlp[2].toHash<h256>());
+        for (unsigned j = 0; j < i % 5; ++j)
+            BOOST_CHECK(storage.contains(sha3(h256(j))));
+        h256 const codeHash = accountRlp[3].toHash<h256>();
+        if (codeHash != EmptySHA3)
+            BOOST_CHECK_EQUAL(_db.lookup(codeHash), _source.lookup(codeHash));
+    }
+}
+}
+
+BOOST_FIXTURE_TEST_SUITE(StateDownloaderSuite, TestOutputHelperFixture)
+
+BOOST_AUTO_TEST_CASE(downloadState)
+{
+    OverlayDB source = newDB();
+    h256 const root = createState(source, 50);
+
+    OverlayDB db = newDB();
+    StateDownloader downloader(db);
+    downloader.setRoot(root);
+    BOOST_CHECK(!downloader.isComplete());
+    serve(downloader, source);
+
+    BOOST_CHECK(db.exists(root));
+    checkState(db, source, root, 50);
+}
+
+BOOST_AUTO_TEST_CASE(undeliveredNodesAreRequestedAgain)
+{
+    OverlayDB source = newDB();
+    h256 const root = createState(source, 50);
+
+    OverlayDB db = newDB();
+    StateDownloader downloader(db);
+    downloader.setRoot(root);
+    serve(downloader, source, 3);
+
+    checkState(db, source, root, 50);
+}
+
+BOOST_AUTO_TEST_CASE(releasedPeerRequestsAreRequeued)
+{
+    OverlayDB source = newDB();
+    h256 const root = createState(source, 10);
+
+    OverlayDB db = newDB();
+    StateDownloader downloader(db);
+    downloader.setRoot(root);
+    h256s const lost = downloader.requestNodes(c_peer, 16);
+    BOOST_REQUIRE_EQUAL(lost.size(), 1u);
+    BOOST_CHECK(downloader.requestNodes(p2p::NodeID{2}, 16).empty());
+
+    downloader.releasePeer(c_peer);
+    BOOST_CHECK(downloader.requestNodes(p2p::NodeID{2}, 16) == lost);
+}
+
+BOOST_AUTO_TEST_CASE(newRootReusesStoredNodes)
+{
+    OverlayDB source = newDB();
+    h256 const root = createState(source, 50);
+
+    OverlayDB db = newDB();
+    StateDownloader downloader(db);
+    downloader.setRoot(root);
+    serve(downloader, source);
+    uint64_t const downloaded = downloader.downloadedNodes();
+
+    // Changing one account leaves all other subtrees in place.
+    h256 const newRoot = createState(source, 51);
+    downloader.setRoot(newRoot);
+    serve(downloader, source);
+
+    checkState(db, source, newRoot, 51);
+    BOOST_CHECK_LT(downloader.downloadedNodes() - downloaded, downloaded / 2);
+}
+
+BOOST_AUTO_TEST_CASE(newRootKeepsReceivedNodes)
+{
+    OverlayDB source = newDB();
+    h256 const root = createState(source, 50);
+
+    OverlayDB db = newDB();
+    StateDownloader downloader(db);
+    downloader.setRoot(root);
+    // The upper nodes are received but not yet written, as their subtrees are incomplete.
+    h256Hash delivered;
+    for (unsigned round = 0; round < 3; ++round)
+    {
+        h256s const hashes = downloader.requestNodes(c_peer, 16);
+        RLPStream s(hashes.size());
+        for (auto const& hash : hashes)
+        {
+            s << source.lookup(hash);
+            delivered.insert(hash);
+        }
+        downloader.onNodeData(c_peer, RLP(s.out()));
+    }
+    BOOST_REQUIRE(!db.exists(root));
+
+    h256 const newRoot = createState(source, 51);
+    downloader.setRoot(newRoot);
+    while (!downloader.isComplete())
+    {
+        h256s const hashes = downloader.requestNodes(c_peer, 16);
+        BOOST_REQUIRE(!hashes.empty());
+        RLPStream s(hashes.size());
+        for (auto const& hash : hashes)
+        {
+            BOOST_REQUIRE(!delivered.count(hash));
+            s << source.lookup(hash);
+        }
+        downloader.onNodeData(c_peer, RLP(s.out()));
+    }
+
+    checkState(db, source, newRoot, 51);
+}
+
+BOOST_AUTO_TEST_CASE(downloadIsDepthFirst)
+{
+    OverlayDB source = newDB();
+    h256 const root = createState(source, 50);
+
+    OverlayDB db = newDB();
+    StateDownloader downloader(db);
+    downloader.setRoot(root);
+    bytes previous;
+    while (!downloader.isComplete())
+    {
+        h256s const hashes = downloader.requestNodes(c_peer, 1);
+        BOOST_REQUIRE_EQUAL(hashes.size(), 1u);
+        // A node still waiting for its subtree has its children requested first.
+        if (!previous.empty())
+        {
+            bytes const hash = hashes.front().asBytes();
+            BOOST_CHECK(search(previous.begin(), previous.end(), hash.begin(), hash.end()) !=
+                        previous.end());
+        }
+
+        string const data = source.lookup(hashes.front());
+        RLPStream s(1);
+        s << data;
+        downloader.onNodeData(c_peer, RLP(s.out()));
+        previous = db.exists(hashes.front()) ? bytes() : asBytes(data);
+    }
+
+    checkState(db, source, root, 50);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,7 @@
 #include <libethereum/LastBlockHashesFace.h>
 #include <libevm/EVMC.h>
 #include <libevm/LegacyVM.h>
+#include <libevm/VMFactory.h>
 #include <test/tools/jsontests/vm.h>
 #include <test/tools/libtesteth/BlockChainHelper.h>
 #include <test/tools/libtesteth/TestOutputHelper.h>
@@ -1053,6 +1054,348 @@ public:
     LegacyVMCallFixture() : CallFixture{new LegacyVM} {};
 };
 
+class GasMeteringFixture : public TestOutputHelperFixture
+{
+public:
+    explicit GasMeteringFixture(VMFace* _vm) : vm{_vm} {}
+
+    owning_bytes_ref exec(bytes const& _code, u256& io_gas)
+    {
+        ExtVM extVm(state, envInfo, *se, address, address, address, value, gasPrice, {},
+            ref(_code), sha3(_code), version, depth, isCreate, staticCall);
+        return vm->exec(io_gas, extVm, OnOpFunc{});
+    }
+
+    void testLoopRunsOnExactGas()
+    {
+        u256 gas = loopGas;
+        exec(loop, gas);
+        BOOST_REQUIRE_EQUAL(gas, 0);
+
+        gas = loopGas + 5;
+        exec(loop, gas);
+        BOOST_REQUIRE_EQUAL(gas, 5);
+    }
+
+    void testLoopRunsOutOfGasOneShort()
+    {
+        u256 gas = loopGas - 1;
+        BOOST_REQUIRE_THROW(exec(loop, gas), OutOfGas);
+    }
+
+    void testGasExcludesInstructionsAfterIt()
+    {
+        u256 gas = 1000;
+        owning_bytes_ref ret = exec(gasLeft, gas);
+        BOOST_REQUIRE_EQUAL(fromBigEndian<u256>(ret), 1000 - 11);
+        BOOST_REQUIRE_EQUAL(gas, 1000 - 26);
+
+        gas = 26;
+        exec(gasLeft, gas);
+        BOOST_REQUIRE_EQUAL(gas, 0);
+        gas = 25;
+        BOOST_REQUIRE_THROW(exec(gasLeft, gas), OutOfGas);
+    }
+
+    void testRevertKeepsGasLeft()
+    {
+        // revert(0, 0) after two pushes never used
+        bytes const code = fromHex("6001600260006000fd");
+        u256 gas = 100;
+        BOOST_REQUIRE_THROW(exec(code, gas), RevertInstruction);
+        BOOST_REQUIRE_EQUAL(gas, 100 - 12);
+    }
+
+    void testStackUnderflowInsideBlock()
+    {
+        // add(1, <nothing>)
+        bytes const code = fromHex("600101");
+        u256 gas = 1000;
+        BOOST_REQUIRE_THROW(exec(code, gas), StackUnderflow);
+    }
+
+    void testUndefinedInstructionInsideBlock()
+    {
+        // push1 1, an undefined instruction, push1 2, stop
+        bytes const code = fromHex("60010c600200");
+        u256 gas = 1000;
+        BOOST_REQUIRE_THROW(exec(code, gas), BadInstruction);
+
+        // With gas for the first push only, the interpreter may fail on entering the block, with
+        // another exception. The frame loses all its gas either way.
+        gas = 3;
+        BOOST_REQUIRE_THROW(exec(code, gas), VMException);
+    }
+
+    void testJumpiFallsThroughIntoJumpdest()
+    {
+        // jumpi(5, c), with the JUMPDEST at 5 right after it, then mstore(0, gas()) and
+        // return(0, 32). Costs 16 up to the JUMPI, 1 for the JUMPDEST, 2 for GAS and 15 after it,
+        // whether the jump is taken or not.
+        for (char const* condition : {"00", "01"})
+        {
+            bytes const code =
+                fromHex(string("60") + condition + "6005575b5a60005260206000f3");
+            u256 gas = 1000;
+            owning_bytes_ref ret = exec(code, gas);
+            BOOST_REQUIRE_EQUAL(fromBigEndian<u256>(ret), 1000 - 19);
+            BOOST_REQUIRE_EQUAL(gas, 1000 - 34);
+
+            gas = 34;
+            exec(code, gas);
+            BOOST_REQUIRE_EQUAL(gas, 0);
+            gas = 33;
+            BOOST_REQUIRE_THROW(exec(code, gas), OutOfGas);
+        }
+    }
+
+    void testTruncatedPushAtEnd()
+    {
+        // push1 1, then a PUSH2 with only one byte of data before the end of the code, running
+        // into the STOP after it. Costs 6.
+        bytes const code = fromHex("60016100");
+        u256 gas = 6;
+        exec(code, gas);
+        BOOST_REQUIRE_EQUAL(gas, 0);
+
+        gas = 5;
+        BOOST_REQUIRE_THROW(exec(code, gas), OutOfGas);
+    }
+
+    void testSelfdestructToNewAccount()
+    {
+        state.addBalance(address, 1 * ether);
+        // selfdestruct(0x1000000000000000000000000000000000000001)
+        // Costs 3 for the push, 5000 for SELFDESTRUCT and 25000 for creating the beneficiary.
+        bytes const code = fromHex("731000000000000000000000000000000000000001ff");
+        u256 const cost = 3 + 5000 + 25000;
+
+        u256 gas = cost - 1;
+        BOOST_REQUIRE_THROW(exec(code, gas), OutOfGas);
+
+        gas = cost;
+        exec(code, gas);
+        BOOST_REQUIRE_EQUAL(gas, 0);
+    }
+
+    void testSstoreAtStipendBoundary()
+    {
+        // sstore(0, 0), which leaves an empty slot unchanged for 800, then push1 0, pop and stop
+        // for 5 more. It needs more than the call stipend of 2300 left when it runs.
+        bytes const code = fromHex("600060005560005000");
+
+        u256 gas = 6 + 2300;
+        BOOST_REQUIRE_THROW(exec(code, gas), OutOfGas);
+
+        gas = 6 + 2301;
+        exec(code, gas);
+        BOOST_REQUIRE_EQUAL(gas, 2301 - 800 - 5);
+    }
+
+    BlockHeader blockHeader{initBlockHeader()};
+    LastBlockHashes lastBlockHashes;
+    Address address{KeyPair::create().address()};
+    State state{0};
+    std::unique_ptr<SealEngineFace> se{
+        ChainParams(genesisInfo(Network::IstanbulTest)).createSealEngine()};
+    EnvInfo envInfo{blockHeader, lastBlockHashes, 0, se->chainParams().chainID};
+
+    u256 value = 0;
+    u256 gasPrice = 1;
+    u256 version = IstanbulSchedule.accountVersion;
+    int depth = 0;
+    bool isCreate = false;
+    bool staticCall = false;
+
+    // for (i = 3; i != 0; --i) {}
+    // Costs 3 for the first push, 26 for each of the 3 iterations and nothing to stop.
+    bytes loop = fromHex("60035b600190038060025700");
+    u256 loopGas = 3 + 3 * 26;
+
+    // let g := gas() after an add, then mstore(0, g) and return(0, 32)
+    // Costs 9 before GAS, 2 for GAS and 15 after it, with one word of memory.
+    bytes gasLeft = fromHex("60016002015a60005260206000f3");
+
+    std::unique_ptr<VMFace> vm;
+};
+
+class LegacyVMGasMeteringFixture : public GasMeteringFixture
+{
+public:
+    LegacyVMGasMeteringFixture() : GasMeteringFixture{new LegacyVM} {}
+};
+
+class AlethInterpreterGasMeteringFixture : public GasMeteringFixture
+{
+public:
+    AlethInterpreterGasMeteringFixture()
+      : GasMeteringFixture{new EVMC{evmc_create_aleth_interpreter(), {}}}
+    {}
+};
+
+class EdgeCaseFixture : public GasMeteringFixture
+{
+public:
+    using GasMeteringFixture::GasMeteringFixture;
+
+    /// @returns the hex of the word on top of the stack after @a _code.
+    std::string topWord(std::string const& _code)
+    {
+        // mstore(0, top) and return(0, 32)
+        bytes const code = fromHex(_code + "60005260206000f3");
+        u256 gas = 1000000;
+        return toHex(exec(code, gas));
+    }
+
+    void testSignedDivisionOverflow()
+    {
+        // -2^255 / -1 overflows to -2^255, and the remainder is 0.
+        BOOST_CHECK_EQUAL(topWord(push32(minusOne) + push32(minInt) + "05"), minInt);
+        BOOST_CHECK_EQUAL(topWord(push32(minusOne) + push32(minInt) + "07"), zero);
+    }
+
+    void testSignextendAtBit255()
+    {
+        // Extending byte 30 sets or clears the top byte, up to bit 255.
+        std::string const low = std::string(60, '0');
+        BOOST_CHECK_EQUAL(topWord(push32("0180" + low) + "601e0b"), "ff80" + low);
+        BOOST_CHECK_EQUAL(topWord(push32("ff70" + low) + "601e0b"), "0070" + low);
+        // Byte 31 and beyond leave the value as it is.
+        BOOST_CHECK_EQUAL(topWord(push32(minInt) + "601f0b"), minInt);
+        BOOST_CHECK_EQUAL(topWord(push32(minInt) + push32(minusOne) + "0b"), minInt);
+        BOOST_CHECK_EQUAL(topWord("6080" + push32(minusOne) + "0b"), word("80"));
+    }
+
+    void testSarAtBit255()
+    {
+        // -2^255 >> 254 is -2.
+        BOOST_CHECK_EQUAL(topWord(push32(minInt) + "60fe1d"), std::string(63, 'f') + "e");
+        BOOST_CHECK_EQUAL(topWord(push32(minInt) + "60ff1d"), minusOne);
+        BOOST_CHECK_EQUAL(topWord(push32(minInt) + "6101001d"), minusOne);
+        BOOST_CHECK_EQUAL(topWord(push32(minusOne) + push32(minusOne) + "1d"), minusOne);
+        std::string const maxInt = "7f" + std::string(62, 'f');
+        BOOST_CHECK_EQUAL(topWord(push32(maxInt) + "60fe1d"), word("01"));
+        BOOST_CHECK_EQUAL(topWord(push32(maxInt) + "60ff1d"), zero);
+        BOOST_CHECK_EQUAL(topWord(push32(maxInt) + "6101001d"), zero);
+    }
+
+    void testExpGasWithZeroExponent()
+    {
+        // exp(2, e) and stop: 3 for each push, 10 for EXP and 50 per byte of e.
+        auto const gasUsed = [this](std::string const& _exponent) {
+            bytes const code = fromHex(_exponent + "60020a00");
+            u256 gas = 1000;
+            exec(code, gas);
+            return 1000 - gas;
+        };
+        BOOST_CHECK_EQUAL(gasUsed("6000"), 3 + 3 + 10);
+        BOOST_CHECK_EQUAL(gasUsed("6001"), 3 + 3 + 10 + 50);
+        BOOST_CHECK_EQUAL(gasUsed("610100"), 3 + 3 + 10 + 2 * 50);
+        BOOST_CHECK_EQUAL(topWord("600060020a"), word("01"));
+        BOOST_CHECK_EQUAL(topWord("600060000a"), word("01"));
+    }
+
+    void testMemoryByteOrder()
+    {
+        std::string const x = "0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20";
+        // mstore(0, x) writes the most significant byte first.
+        BOOST_CHECK_EQUAL(topWord(push32(x) + "600052600051"), x);
+        // mload(1) reads it back shifted by a byte.
+        BOOST_CHECK_EQUAL(topWord(push32(x) + "600052600151"), x.substr(2) + "00");
+        // mstore8(31, 0xabcd) writes the low byte at the end of the word.
+        BOOST_CHECK_EQUAL(topWord("61abcd601f53600051"), word("cd"));
+    }
+
+    static std::string push32(std::string const& _word) { return "7f" + _word; }
+    /// @returns @a _low padded to a word.
+    static std::string word(std::string const& _low)
+    {
+        return std::string(64 - _low.size(), '0') + _low;
+    }
+
+    std::string const zero = std::string(64, '0');
+    std::string const minusOne = std::string(64, 'f');
+    std::string const minInt = "8" + std::string(63, '0');
+};
+
+class LegacyVMEdgeCaseFixture : public EdgeCaseFixture
+{
+public:
+    LegacyVMEdgeCaseFixture() : EdgeCaseFixture{new LegacyVM} {}
+};
+
+class AlethInterpreterEdgeCaseFixture : public EdgeCaseFixture
+{
+public:
+    AlethInterpreterEdgeCaseFixture()
+      : EdgeCaseFixture{new EVMC{evmc_create_aleth_interpreter(), {}}}
+    {}
+};
+
+class ReusedVMFixture : public TestOutputHelperFixture
+{
+public:
+    ReusedVMFixture() { state.addBalance(address, 1 * ether); }
+
+    /// Runs code on @a _vm that leaves its stack, memory and return data buffer in use.
+    void runReverting(VMFace& _vm)
+    {
+        ExtVM extVm(state, envInfo, *se, address, address, address, value, gasPrice, {},
+            ref(reverting), sha3(reverting), version, depth, isCreate, staticCall);
+        u256 revertingGas = gas;
+        BOOST_REQUIRE_THROW(_vm.exec(revertingGas, extVm, OnOpFunc{}), RevertInstruction);
+    }
+
+    /// Checks that @a _vm runs code as a new VM would, whatever it ran before.
+    void checkStartsClean(VMFace& _vm)
+    {
+        ExtVM extVm(state, envInfo, *se, address, address, address, value, gasPrice, {},
+            ref(clean), sha3(clean), version, depth, isCreate, staticCall);
+        u256 cleanGas = gas;
+        owning_bytes_ref ret = _vm.exec(cleanGas, extVm, OnOpFunc{});
+        BOOST_REQUIRE_EQUAL(fromBigEndian<int>(ret), 1);
+        // The memory left by the earlier run doesn't make the expansion to one word free.
+        BOOST_REQUIRE_EQUAL(gas - cleanGas, 25);
+
+        ExtVM popExtVm(state, envInfo, *se, address, address, address, value, gasPrice, {},
+            ref(pop), sha3(pop), version, depth, isCreate, staticCall);
+        u256 popGas = gas;
+        BOOST_REQUIRE_THROW(_vm.exec(popGas, popExtVm, OnOpFunc{}), StackUnderflow);
+    }
+
+    BlockHeader blockHeader{initBlockHeader()};
+    LastBlockHashes lastBlockHashes;
+    Address address{KeyPair::create().address()};
+    State state{0};
+    std::unique_ptr<SealEngineFace> se{
+        ChainParams(genesisInfo(Network::IstanbulTest)).createSealEngine()};
+    EnvInfo envInfo{blockHeader, lastBlockHashes, 0, se->chainParams().chainID};
+
+    u256 value = 0;
+    u256 gasPrice = 1;
+    u256 version = IstanbulSchedule.accountVersion;
+    int depth = 0;
+    bool isCreate = false;
+    bool staticCall = false;
+    u256 gas = 1000000;
+
+    // Leaves two words on the stack, the result of a call to the identity precompile returning
+    // one word, and 1 KB of memory behind, and reverts with some of it:
+    // let r := call(gas(), 0x4, 0, 0, 32, 0, 0)
+    // mstore(0x3e0, 1)
+    // revert(0x3e0, 32)
+    bytes reverting = fromHex("600160026000600060206000600060045af160016103e05260206103e0fd");
+
+    // let r := add(returndatasize(), chainid())
+    // mstore(0, r)
+    // return(0, 32)
+    // Costs 25 with one word of memory, and returns 1 if there is no return data.
+    bytes clean = fromHex("3d46018060005260206000f350");
+
+    // pop
+    bytes pop = fromHex("50");
+};
+
 }  // namespace
 
 BOOST_FIXTURE_TEST_SUITE(LegacyVMSuite, TestOutputHelperFixture)
@@ -1275,6 +1618,124 @@ BOOST_AUTO_TEST_CASE(LegacyVMTestDelegateCallSelfCorrectCost)
 
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_FIXTURE_TEST_SUITE(LegacyVMGasMeteringSuite, LegacyVMGasMeteringFixture)
+
+BOOST_AUTO_TEST_CASE(LegacyVMLoopRunsOnExactGas)
+{
+    testLoopRunsOnExactGas();
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMLoopRunsOutOfGasOneShort)
+{
+    testLoopRunsOutOfGasOneShort();
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMGasExcludesInstructionsAfterIt)
+{
+    testGasExcludesInstructionsAfterIt();
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMRevertKeepsGasLeft)
+{
+    testRevertKeepsGasLeft();
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMStackUnderflowInsideBlock)
+{
+    testStackUnderflowInsideBlock();
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMUndefinedInstructionInsideBlock)
+{
+    testUndefinedInstructionInsideBlock();
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMJumpiFallsThroughIntoJumpdest)
+{
+    testJumpiFallsThroughIntoJumpdest();
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMTruncatedPushAtEnd)
+{
+    testTruncatedPushAtEnd();
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMSelfdestructToNewAccount)
+{
+    testSelfdestructToNewAccount();
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMSstoreAtStipendBoundary)
+{
+    testSstoreAtStipendBoundary();
+}
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(LegacyVMEdgeCaseSuite, LegacyVMEdgeCaseFixture)
+
+BOOST_AUTO_TEST_CASE(LegacyVMSignedDivisionOverflow)
+{
+    testSignedDivisionOverflow();
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMSignextendAtBit255)
+{
+    testSignextendAtBit255();
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMSarAtBit255)
+{
+    testSarAtBit255();
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMExpGasWithZeroExponent)
+{
+    testExpGasWithZeroExponent();
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMMemoryByteOrder)
+{
+    testMemoryByteOrder();
+}
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(LegacyVMReuseSuite, ReusedVMFixture)
+
+BOOST_AUTO_TEST_CASE(LegacyVMReusedVMStartsClean)
+{
+    LegacyVM vm;
+    runReverting(vm);
+    checkStartsClean(vm);
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMPoolReusesVMs)
+{
+    VMFace* first = nullptr;
+    {
+        VMPtr vm = VMFactory::create(VMKind::Legacy);
+        first = vm.get();
+        // A nested frame gets a VM of its own.
+        VMPtr nested = VMFactory::create(VMKind::Legacy);
+        BOOST_CHECK(nested.get() != first);
+    }
+    VMPtr vm = VMFactory::create(VMKind::Legacy);
+    BOOST_CHECK_EQUAL(vm.get(), first);
+}
+
+BOOST_AUTO_TEST_CASE(LegacyVMPooledVMStartsClean)
+{
+    VMFace* used = nullptr;
+    {
+        VMPtr vm = VMFactory::create(VMKind::Legacy);
+        runReverting(*vm);
+        used = vm.get();
+    }
+    VMPtr vm = VMFactory::create(VMKind::Legacy);
+    BOOST_REQUIRE_EQUAL(vm.get(), used);
+    checkStartsClean(*vm);
+}
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_FIXTURE_TEST_SUITE(AlethInterpreterSuite, TestOutputHelperFixture)
@@ -1406,4 +1867,95 @@ BOOST_AUTO_TEST_CASE(AlethInterpreterSelfBalanceisInvalidBeforeIstanbul)
 }
 BOOST_AUTO_TEST_SUITE_END()
 
+BOOST_FIXTURE_TEST_SUITE(AlethInterpreterGasMeteringSuite, AlethInterpreterGasMeteringFixture)
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterLoopRunsOnExactGas)
+{
+    testLoopRunsOnExactGas();
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterLoopRunsOutOfGasOneShort)
+{
+    testLoopRunsOutOfGasOneShort();
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterGasExcludesInstructionsAfterIt)
+{
+    testGasExcludesInstructionsAfterIt();
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterRevertKeepsGasLeft)
+{
+    testRevertKeepsGasLeft();
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterStackUnderflowInsideBlock)
+{
+    testStackUnderflowInsideBlock();
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterUndefinedInstructionInsideBlock)
+{
+    testUndefinedInstructionInsideBlock();
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterJumpiFallsThroughIntoJumpdest)
+{
+    testJumpiFallsThroughIntoJumpdest();
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterTruncatedPushAtEnd)
+{
+    testTruncatedPushAtEnd();
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterSelfdestructToNewAccount)
+{
+    testSelfdestructToNewAccount();
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterSstoreAtStipendBoundary)
+{
+    testSstoreAtStipendBoundary();
+}
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(AlethInterpreterEdgeCaseSuite, AlethInterpreterEdgeCaseFixture)
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterSignedDivisionOverflow)
+{
+    testSignedDivisionOverflow();
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterSignextendAtBit255)
+{
+    testSignextendAtBit255();
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterSarAtBit255)
+{
+    testSarAtBit255();
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterExpGasWithZeroExponent)
+{
+    testExpGasWithZeroExponent();
+}
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterMemoryByteOrder)
+{
+    testMemoryByteOrder();
+}
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(AlethInterpreterReuseSuite, ReusedVMFixture)
+
+BOOST_AUTO_TEST_CASE(AlethInterpreterReusedVMStartsClean)
+{
+    EVMC vm{evmc_create_aleth_interpreter(), {}};
+    runReverting(vm);
+    checkStartsClean(vm);
+}
+BOOST_AUTO_TEST_SUITE_END()
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,6 +5,7 @@
 #include <libdevcore/RLP.h>
 #include <libdevcore/SHA3.h>
 #include <libdevcrypto/CryptoPP.h>
+#include <libp2p/RLPXFrameCoder.h>
 #include <libp2p/RLPxHandshake.h>
 #include <cryptopp/aes.h>
 #include <cryptopp/hmac.h>
@@ -492,3 +493,30 @@ TEST_F(rlpx, ecies_interop_test_primitives)
     ASSERT_TRUE(s_secp256k1->decryptECIES(kenc.secret(), plainTest3));
     ASSERT_EQ(plainTest3, expectedPlain3);
 }
+
+TEST_F(rlpx, writeSingleFramePacketFromParts)
+{
+    KeyPair const local = KeyPair::create();
+    KeyPair const remote = KeyPair::create();
+    h256 const localNonce = h256::random();
+    h256 const remoteNonce = h256::random();
+    bytes const auth(307, 0xaa);
+    bytes const ack(210, 0xbb);
+    RLPXFrameCoder coder(true, remote.pub(), remoteNonce, local, localNonce, &ack, &auth);
+    RLPXFrameCoder partsCoder(true, remote.pub(), remoteNonce, local, localNonce, &ack, &auth);
+
+    // Reused buffer with stale content, larger than needed.
+    bytes frame(1000, 0xff);
+    for (size_t dataSize : {1, 14, 15, 16, 100})
+    {
+        RLPStream s;
+        s.append(unsigned(0x10)).appendList(1) << bytes(dataSize, 0x42);
+        bytes const packet = s.out();
+
+        bytes expected;
+        coder.writeSingleFramePacket(&packet, expected);
+        bytesConstRef const packetRef(&packet);
+        partsCoder.writeSingleFramePacket(packetRef.cropped(0, 1), packetRef.cropped(1), frame);
+        EXPECT_EQ(frame, expected);
+    }
+}
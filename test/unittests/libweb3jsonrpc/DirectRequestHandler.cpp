@@ -0,0 +1,144 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+#include <libweb3jsonrpc/DirectRequestHandler.h>
+#include <libweb3jsonrpc/JsonWriter.h>
+
+#include <jsonrpccpp/common/exception.h>
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::rpc;
+
+namespace
+{
+/// Stands in for the libjson-rpc-cpp handler, recording the requests it gets.
+class FallbackHandler: public jsonrpc::IProtocolHandler
+{
+public:
+    explicit FallbackHandler(vector<string>& o_requests): m_requests(o_requests) {}
+
+    void AddProcedure(jsonrpc::Procedure const&) override {}
+    void HandleRequest(string const& _request, string& o_response) override
+    {
+        m_requests.push_back(_request);
+        o_response = "fallback";
+    }
+
+private:
+    vector<string>& m_requests;
+};
+
+class DirectRequestHandlerTest: public testing::Test
+{
+public:
+    DirectRequestHandlerTest()
+    {
+        handler.addMethod("test_direct", [this](Json::Value const& _params, JsonWriter& o_result) {
+            ++directCalls;
+            if (_params.empty())
+                return false;
+            if (_params[0u] == "throwJsonRpc")
+                throw jsonrpc::JsonRpcException(jsonrpc::Errors::ERROR_RPC_INVALID_PARAMS);
+            if (_params[0u] == "throw")
+                throw runtime_error("failed");
+            o_result.value(_params[0u]);
+            return true;
+        });
+    }
+
+    string handle(string const& _request)
+    {
+        string response;
+        handler.HandleRequest(_request, response);
+        return response;
+    }
+
+    /// @returns the request to test_direct with @a _id and @a _params.
+    static string request(Json::Value const& _id, Json::Value const& _params)
+    {
+        Json::Value ret;
+        ret["jsonrpc"] = "2.0";
+        ret["id"] = _id;
+        ret["method"] = "test_direct";
+        ret["params"] = _params;
+        return Json::FastWriter().write(ret);
+    }
+
+    /// @returns the response of libjson-rpc-cpp to the call with @a _id returning @a _result.
+    static string response(Json::Value const& _id, Json::Value const& _result)
+    {
+        Json::Value ret;
+        ret["jsonrpc"] = "2.0";
+        ret["id"] = _id;
+        ret["result"] = _result;
+        return Json::FastWriter().write(ret);
+    }
+
+    static Json::Value params(string const& _param)
+    {
+        Json::Value ret(Json::arrayValue);
+        ret.append(_param);
+        return ret;
+    }
+
+    vector<string> fallbackRequests;
+    DirectRequestHandler handler{new FallbackHandler{fallbackRequests}};
+    unsigned directCalls = 0;
+};
+}  // namespace
+
+TEST_F(DirectRequestHandlerTest, unboundMethodGoesToWrappedHandler)
+{
+    string const other =
+        R"({"jsonrpc":"2.0","id":1,"method":"test_other","params":["test_direct"]})";
+    EXPECT_EQ(handle(other), "fallback");
+    ASSERT_EQ(fallbackRequests.size(), 1);
+    EXPECT_EQ(fallbackRequests[0], other);
+    EXPECT_EQ(directCalls, 0);
+}
+
+TEST_F(DirectRequestHandlerTest, declinedCallGoesToWrappedHandler)
+{
+    string const declined = request(1, Json::Value(Json::arrayValue));
+    EXPECT_EQ(handle(declined), "fallback");
+    ASSERT_EQ(fallbackRequests.size(), 1);
+    EXPECT_EQ(fallbackRequests[0], declined);
+    EXPECT_EQ(directCalls, 1);
+}
+
+TEST_F(DirectRequestHandlerTest, invalidRequestGoesToWrappedHandler)
+{
+    // No id: a notification.
+    EXPECT_EQ(handle(R"({"jsonrpc":"2.0","method":"test_direct","params":["a"]})"), "fallback");
+    EXPECT_EQ(handle(R"({"jsonrpc":"2.0","id":[],"method":"test_direct","params":["a"]})"),
+        "fallback");
+    EXPECT_EQ(handle(R"({"id":1,"method":"test_direct","params":["a"]})"), "fallback");
+    EXPECT_EQ(fallbackRequests.size(), 3);
+    EXPECT_EQ(directCalls, 0);
+}
+
+TEST_F(DirectRequestHandlerTest, echoesId)
+{
+    EXPECT_EQ(handle(request(7, params("a"))), response(7, "a"));
+    EXPECT_EQ(handle(request("seven", params("a"))), response("seven", "a"));
+    EXPECT_EQ(handle(request(Json::nullValue, params("a"))), response(Json::nullValue, "a"));
+    EXPECT_TRUE(fallbackRequests.empty());
+    EXPECT_EQ(directCalls, 3);
+}
+
+TEST_F(DirectRequestHandlerTest, errorIsAnsweredWithoutCallingAgain)
+{
+    for (auto const& param : {"throwJsonRpc", "throw"})
+    {
+        Json::Value parsed;
+        ASSERT_TRUE(Json::Reader().parse(handle(request("id", params(param))), parsed));
+        EXPECT_EQ(parsed["jsonrpc"], "2.0");
+        EXPECT_EQ(parsed["id"], "id");
+        EXPECT_FALSE(parsed.isMember("result"));
+        EXPECT_EQ(parsed["error"]["code"], jsonrpc::Errors::ERROR_RPC_INVALID_PARAMS);
+    }
+    EXPECT_TRUE(fallbackRequests.empty());
+    EXPECT_EQ(directCalls, 2);
+}
@@ -0,0 +1,131 @@
+// Aleth: Ethereum C++ client, tools and libraries.
+// Copyright 2019 Aleth Authors.
+// Licensed under the GNU General Public License, Version 3.
+#include <libethereum/BlockDetails.h>
+#include <libethereum/Transaction.h>
+#include <libethereum/TransactionReceipt.h>
+#include <libweb3jsonrpc/JsonHelper.h>
+#include <libweb3jsonrpc/JsonWriter.h>
+
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+using namespace dev::rpc;
+
+namespace
+{
+/// @returns @a _text reformatted by jsoncpp, to compare it with the text of a Json::Value.
+string reformatted(string const& _text)
+{
+    Json::Value parsed;
+    EXPECT_TRUE(Json::Reader().parse(_text, parsed, false)) << _text;
+    return Json::FastWriter().write(parsed);
+}
+
+template <class... Args>
+string written(Args const&... _args)
+{
+    string out;
+    JsonWriter writer{out};
+    writeJson(writer, _args...);
+    return reformatted(out);
+}
+
+LogEntries logEntries()
+{
+    return {LogEntry{Address{0x11}, {h256{1}, h256{2}}, fromHex("0102")},
+        LogEntry{Address{0x12}, {}, bytes{}}};
+}
+
+Transaction transaction(u256 const& _nonce)
+{
+    Transaction t{1000, 20, 21000, Address{0x22}, fromHex("abcdef"), _nonce, Secret{sha3("key")}};
+    t.sender();
+    return t;
+}
+
+BlockHeader header()
+{
+    BlockHeader header;
+    header.setNumber(12);
+    header.setTimestamp(1500000000);
+    header.setGasLimit(8000000);
+    header.setGasUsed(42000);
+    header.setAuthor(Address{0x33});
+    header.setParentHash(h256{4});
+    header.setRoots(h256{5}, h256{6}, h256{7}, h256{8});
+    header.setExtraData(asBytes("aleth"));
+    header.setDifficulty(u256{1} << 100);
+    return header;
+}
+}  // namespace
+
+TEST(JsonWriter, values)
+{
+    bytes const data{0, 10};
+    string out;
+    JsonWriter writer{out};
+    writer.beginObject();
+    writer.key("list").beginArray().value(true).null().value(uint64_t{18446744073709551615u}).endArray();
+    writer.key("text").value("\"quoted\"\\\n\x01");
+    writer.key("empty").beginObject().endObject();
+    writer.key("quantities").beginArray();
+    writer.quantity(0).quantity(255).quantity(u256{1} << 64).quantity(~u256{});
+    writer.endArray();
+    writer.key("data").beginArray().data({}).hex({}).data(&data).endArray();
+    writer.endObject();
+
+    EXPECT_EQ(out,
+        "{\"list\":[true,null,18446744073709551615],\"text\":\"\\\"quoted\\\"\\\\\\n\\u0001\","
+        "\"empty\":{},\"quantities\":[\"0x0\",\"0xff\",\"0x10000000000000000\",\"0x" +
+            string(64, 'f') + "\"],\"data\":[\"\",\"0x\",\"0x000a\"]}");
+}
+
+TEST(JsonWriter, block)
+{
+    BlockHeader const bi = header();
+    BlockDetails const details{12, u256{1} << 110, h256{4}, {}, 1234};
+    UncleHashes const uncles{h256{9}};
+    Transactions const transactions{transaction(0), transaction(1)};
+
+    EXPECT_EQ(written(bi, details, uncles, transactions),
+        Json::FastWriter().write(toJson(bi, details, uncles, transactions)));
+    TransactionHashes const hashes{transactions[0].sha3(), transactions[1].sha3()};
+    EXPECT_EQ(written(bi, details, uncles, hashes),
+        Json::FastWriter().write(toJson(bi, details, uncles, hashes)));
+}
+
+TEST(JsonWriter, transaction)
+{
+    LocalisedTransaction const t{transaction(3), h256{10}, 2, 12};
+    EXPECT_EQ(written(t), Json::FastWriter().write(toJson(t)));
+
+    Transaction creation{0, 20, 50000, fromHex("6000"), 4, Secret{sha3("key")}};
+    LocalisedTransaction const c{creation, h256{10}, 3, 12};
+    EXPECT_EQ(written(c), Json::FastWriter().write(toJson(c)));
+}
+
+TEST(JsonWriter, receipt)
+{
+    for (TransactionReceipt const& receipt :
+        {TransactionReceipt{1, 42000, logEntries()}, TransactionReceipt{h256{3}, 21000, {}}})
+    {
+        LocalisedTransactionReceipt const r{
+            receipt, h256{1}, h256{2}, 12, Address{0x44}, Address{0x55}, 7, 21000};
+        EXPECT_EQ(written(r), Json::FastWriter().write(toJson(r)));
+    }
+}
+
+TEST(JsonWriter, logs)
+{
+    LogEntries const entries = logEntries();
+    LocalisedLogEntries const logs{
+        LocalisedLogEntry{entries[0], h256{1}, 12, h256{2}, 3, 4, BlockPolarity::Live},
+        LocalisedLogEntry{entries[1], h256{1}, 12, h256{2}, 3, 5, BlockPolarity::Dead},
+        LocalisedLogEntry{entries[1]},
+        LocalisedLogEntry{entries[0], h256{6}},
+    };
+    EXPECT_EQ(written(logs), Json::FastWriter().write(toJson(logs)));
+}
@@ -5,6 +5,7 @@
 #pragma GCC diagnostic ignored "-Wdeprecated"
 
 #include "WebThreeStubClient.h"
+#include <jsonrpccpp/common/errors.h>
 #include <jsonrpccpp/server/abstractserverconnector.h>
 #include <libdevcore/CommonIO.h>
 #include <libethcore/CommonJS.h>
@@ -16,11 +17,13 @@
 #include <libweb3jsonrpc/Eth.h>
 #include <libweb3jsonrpc/ModularServer.h>
 #include <libweb3jsonrpc/Net.h>
+#include <libweb3jsonrpc/Subscriptions.h>
 #include <libweb3jsonrpc/Test.h>
 #include <libweb3jsonrpc/Web3.h>
 #include <libwebthree/WebThree.h>
 #include <test/tools/libtesteth/TestHelper.h>
 #include <test/tools/libtesteth/TestOutputHelper.h>
+#include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -700,6 +703,100 @@ BOOST_AUTO_TEST_CASE(debugTraceTransaction)
     BOOST_REQUIRE_GT(result["structLogs"].size(), 0u);
 }
 
+BOOST_AUTO_TEST_CASE(debugStandardTraceBlockToFile)
+{
+    // mine to get some balance at coinbase
+    dev::eth::mine(*(web3->ethereum()), 1);
+
+    // a transaction requiring execution and a plain transfer in the same block
+    string initCode =
+        "608060405260076000553415601357600080fd5b60358060206000396000"
+        "f3006080604052600080fd00a165627a7a7230582006db0551577963b544"
+        "3e9501b4b10880e186cff876cd360e9ad6e4181731fcdd0029";
+
+    Json::Value create;
+    create["code"] = initCode;
+    create["from"] = toJS(coinbase.address());
+    string const createHash = rpcClient->eth_sendTransaction(create);
+    BOOST_REQUIRE(!createHash.empty());
+
+    Json::Value transfer;
+    transfer["from"] = toJS(coinbase.address());
+    transfer["value"] = toJS(10);
+    transfer["to"] = toJS(Address::random());
+    transfer["gas"] = toJS(EVMSchedule().txGas);
+    transfer["gasPrice"] = toJS(10 * dev::eth::szabo);
+    string const transferHash = rpcClient->eth_sendTransaction(transfer);
+    BOOST_REQUIRE(!transferHash.empty());
+
+    dev::eth::mine(*(web3->ethereum()), 1);
+
+    // The transactions are in the order of their nonces.
+    vector<Json::Value> const receipts{rpcClient->eth_getTransactionReceipt(createHash),
+        rpcClient->eth_getTransactionReceipt(transferHash)};
+    string const blockHash = receipts[0]["blockHash"].asString();
+    BOOST_REQUIRE_EQUAL(receipts[1]["blockHash"].asString(), blockHash);
+    BOOST_REQUIRE_EQUAL(receipts[1]["transactionIndex"].asUInt(), 1u);
+
+    // @returns the lines of the trace in @a _file, checking that each one is a JSON object.
+    auto const traceLines = [](string const& _file) {
+        vector<Json::Value> ret;
+        istringstream in(contentsString(_file));
+        for (string line; getline(in, line);)
+        {
+            Json::Value step;
+            BOOST_REQUIRE(Json::Reader().parse(line, step));
+            BOOST_REQUIRE(step.isObject());
+            ret.push_back(step);
+        }
+        return ret;
+    };
+    // @returns whether @a _file is named after the block and the transaction @a _index.
+    auto const namedAfter = [&](string const& _file, unsigned _index) {
+        string const prefix = "block_" + blockHash.substr(2, 8) + "-" + toString(_index) + "-" +
+                              receipts[_index]["transactionHash"].asString().substr(2, 8) + "-";
+        return boost::filesystem::path(_file).filename().string().compare(
+                   0, prefix.size(), prefix) == 0;
+    };
+
+    Json::Value const files =
+        rpcClient->debug_standardTraceBlockToFile(blockHash, Json::Value(Json::objectValue));
+    BOOST_REQUIRE_EQUAL(files.size(), 2u);
+    for (unsigned i = 0; i < files.size(); ++i)
+    {
+        string const file = files[i].asString();
+        BOOST_CHECK(namedAfter(file, i));
+
+        vector<Json::Value> const lines = traceLines(file);
+        BOOST_REQUIRE(!lines.empty());
+        for (size_t k = 0; k + 1 < lines.size(); ++k)
+            BOOST_CHECK(lines[k].isMember("op"));
+        // The last line holds the gas used and the output of the transaction.
+        BOOST_CHECK_EQUAL(lines.back()["gasUsed"].asString(), receipts[i]["gasUsed"].asString());
+        BOOST_CHECK(lines.back().isMember("output"));
+        // Only the contract creation runs code.
+        BOOST_CHECK_EQUAL(lines.size() > 1, i == 0);
+        boost::filesystem::remove(file);
+    }
+
+    Json::Value options(Json::objectValue);
+    options["txHash"] = transferHash;
+    Json::Value const filtered = rpcClient->debug_standardTraceBlockToFile(blockHash, options);
+    BOOST_REQUIRE_EQUAL(filtered.size(), 1u);
+    string const file = filtered[0].asString();
+    BOOST_CHECK(namedAfter(file, 1));
+    vector<Json::Value> const lines = traceLines(file);
+    BOOST_REQUIRE_EQUAL(lines.size(), 1u);
+    BOOST_CHECK_EQUAL(lines[0]["gasUsed"].asString(), toJS(EVMSchedule().txGas));
+    BOOST_CHECK_EQUAL(lines[0]["output"].asString(), "0x");
+    boost::filesystem::remove(file);
+
+    // A transaction of another block.
+    options["txHash"] = toJS(h256(1));
+    BOOST_CHECK_THROW(
+        rpcClient->debug_standardTraceBlockToFile(blockHash, options), jsonrpc::JsonRpcException);
+}
+
 BOOST_AUTO_TEST_CASE(adminEthVmTrace)
 {
     // mine to get some balance at coinbase
@@ -879,4 +976,90 @@ BOOST_AUTO_TEST_CASE(call_from_parameter)
         responseString, "0x000000000000000000000000112233445566778899aabbccddeeff0011223344");
 }
 
+BOOST_AUTO_TEST_CASE(eth_subscribe_newHeads)
+{
+    rpc::Subscriptions subscriptions{*web3->ethereum()};
+    int const connection = 0;
+    Mutex x_messages;
+    vector<string> messages;
+    auto const send = [&](string const& _message) {
+        DEV_GUARDED(x_messages)
+            messages.push_back(_message);
+        return true;
+    };
+    auto const waitForMessages = [&](size_t _count) {
+        for (int i = 0; i < 1000; ++i)
+        {
+            DEV_GUARDED(x_messages)
+                if (messages.size() >= _count)
+                    return;
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+    };
+
+    BOOST_CHECK(!subscriptions.handleRequest(
+        R"({"jsonrpc":"2.0","id":1,"method":"eth_blockNumber","params":[]})", &connection, send, {}));
+    BOOST_CHECK(subscriptions.handleRequest(
+        R"({"jsonrpc":"2.0","id":1,"method":"eth_subscribe","params":["newHeads"]})", &connection,
+        send, {}));
+    BOOST_CHECK(subscriptions.handleRequest(
+        R"({"jsonrpc":"2.0","id":2,"method":"eth_subscribe","params":["newBlocks"]})", &connection,
+        send, {}));
+    BOOST_CHECK_EQUAL(subscriptions.size(), 1);
+
+    dev::eth::mine(*(web3->ethereum()), 1);
+    waitForMessages(3);
+    vector<string> received;
+    DEV_GUARDED(x_messages)
+        received = messages;
+
+    BOOST_REQUIRE_GE(received.size(), 3);
+    Json::Value subscribed;
+    BOOST_REQUIRE(Json::Reader().parse(received[0], subscribed));
+    BOOST_CHECK_EQUAL(subscribed["id"].asInt(), 1);
+    string const id = subscribed["result"].asString();
+    Json::Value rejected;
+    BOOST_REQUIRE(Json::Reader().parse(received[1], rejected));
+    BOOST_CHECK_EQUAL(rejected["error"]["code"].asInt(), jsonrpc::Errors::ERROR_RPC_INVALID_PARAMS);
+    Json::Value notification;
+    BOOST_REQUIRE(Json::Reader().parse(received[2], notification));
+    BOOST_CHECK_EQUAL(notification["method"].asString(), "eth_subscription");
+    BOOST_CHECK_EQUAL(notification["params"]["subscription"].asString(), id);
+    Json::Value const head = notification["params"]["result"];
+    BOOST_CHECK_EQUAL(head["number"].asString(), "0x1");
+    BOOST_CHECK_EQUAL(head["hash"].asString(), toJS(web3->ethereum()->hashFromNumber(1)));
+
+    string const unsubscribe =
+        R"({"jsonrpc":"2.0","id":3,"method":"eth_unsubscribe","params":[")" + id + R"("]})";
+    BOOST_CHECK(subscriptions.handleRequest(unsubscribe, &connection, send, {}));
+    BOOST_CHECK_EQUAL(subscriptions.size(), 0);
+    subscriptions.closeConnection(&connection);
+}
+
+BOOST_AUTO_TEST_CASE(eth_subscribe_disconnectsSlowSubscriber)
+{
+    rpc::Subscriptions subscriptions{*web3->ethereum(), 1};
+    int const connection = 0;
+    atomic<bool> writable{false};
+    atomic<bool> disconnected{false};
+    auto const send = [&](string const&) {
+        while (!writable)
+            this_thread::sleep_for(chrono::milliseconds(1));
+        return true;
+    };
+
+    BOOST_CHECK(subscriptions.handleRequest(
+        R"({"jsonrpc":"2.0","id":1,"method":"eth_subscribe","params":["newHeads"]})", &connection,
+        send, [&]() { disconnected = true; }));
+    for (int i = 0; i < 3 && !disconnected; ++i)
+        dev::eth::mine(*(web3->ethereum()), 1);
+    for (int i = 0; i < 1000 && !disconnected; ++i)
+        this_thread::sleep_for(chrono::milliseconds(10));
+    BOOST_CHECK(disconnected);
+
+    writable = true;
+    subscriptions.closeConnection(&connection);
+    BOOST_CHECK_EQUAL(subscriptions.size(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()